@@ -0,0 +1,20 @@
+// Maps the interpolated dye density onto the background colour.
+
+Texture2D<float> DyeTexture : register(t0, space2);
+SamplerState DyeSampler : register(s0, space2);
+
+cbuffer DisplayUniforms : register(b0, space3)
+{
+    float4 Background;
+    float4 Tint;
+    float Exposure;
+    float3 Padding;
+};
+
+float4 main(float2 uv : TEXCOORD0) : SV_Target0
+{
+    // Simulation row 0 is the floor of the domain; texture row 0 is the top of the screen.
+    const float density = DyeTexture.Sample(DyeSampler, float2(uv.x, 1.0 - uv.y));
+    const float coverage = 1.0 - exp(-density * Exposure);
+    return float4(lerp(Background.rgb, Tint.rgb, coverage), 1.0);
+}
@@ -0,0 +1,15 @@
+// Single oversized triangle covering the viewport; no vertex buffer needed.
+
+struct Output
+{
+    float2 UV : TEXCOORD0;
+    float4 Position : SV_Position;
+};
+
+Output main(uint vertexID : SV_VertexID)
+{
+    Output output;
+    output.UV = float2((vertexID << 1) & 2, vertexID & 2);
+    output.Position = float4(output.UV * float2(2.0, -2.0) + float2(-1.0, 1.0), 0.0, 1.0);
+    return output;
+}
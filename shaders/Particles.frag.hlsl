@@ -0,0 +1,6 @@
+// Tracer colour as computed per point; the pipeline blends it additively over the dye.
+
+float4 main(float4 color : TEXCOORD0) : SV_Target0
+{
+    return color;
+}
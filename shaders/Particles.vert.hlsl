@@ -0,0 +1,38 @@
+// One point per tracer, read straight from the particle system's structure-of-arrays layout: four sections
+// of Capacity words holding x, y, age and RGBA8 colour.
+
+StructuredBuffer<uint> Particles : register(t0, space0);
+
+cbuffer ParticleUniforms : register(b0, space1)
+{
+    float2 GridSize;
+    float Lifetime;
+    uint Capacity;
+    float Intensity;
+    float3 Padding;
+};
+
+struct Output
+{
+    float4 Color : TEXCOORD0;
+    float4 Position : SV_Position;
+};
+
+Output main(uint vertexID : SV_VertexID)
+{
+    const float x = asfloat(Particles[vertexID]);
+    const float y = asfloat(Particles[Capacity + vertexID]);
+    const float age = asfloat(Particles[2 * Capacity + vertexID]);
+    const uint packed = Particles[3 * Capacity + vertexID];
+
+    const float3 color = float3(packed & 0xFF, (packed >> 8) & 0xFF, (packed >> 16) & 0xFF) / 255.0;
+    const float fade = saturate(age * 4.0) * saturate((Lifetime - age) / (0.25 * Lifetime));
+
+    // Cell centres land on the display texture's texel centres; simulation row 0 is the bottom of the screen.
+    const float2 uv = (float2(x, y) + 0.5) / GridSize;
+
+    Output output;
+    output.Color = float4(color, fade * Intensity);
+    output.Position = float4(uv * 2.0 - 1.0, 0.0, 1.0);
+    return output;
+}
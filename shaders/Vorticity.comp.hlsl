@@ -0,0 +1,71 @@
+// Fused curl + vorticity confinement over velocity storage buffers. Each group computes curl for its 16x16
+// tile plus a one-cell ring into groupshared memory and applies the confinement force straight from it, so
+// curl never goes to memory. Matches FluidSolver::ConfineVorticity: wall cells pass through, and each band of
+// BandStrength owns an equal slice of the columns.
+
+#define TILE_SIZE 16
+#define SHARED_SIZE (TILE_SIZE + 2)
+
+StructuredBuffer<float> VelocityXIn : register(t0, space0);
+StructuredBuffer<float> VelocityYIn : register(t1, space0);
+StructuredBuffer<float> BandStrength : register(t2, space0);
+RWStructuredBuffer<float> VelocityXOut : register(u0, space1);
+RWStructuredBuffer<float> VelocityYOut : register(u1, space1);
+
+cbuffer VorticityUniforms : register(b0, space2)
+{
+    uint Width;
+    uint Height;
+    uint BandCount;
+    float TimeStep;
+};
+
+groupshared float Curl[SHARED_SIZE][SHARED_SIZE];
+
+float CurlAt(int x, int y)
+{
+    if (x <= 0 || y <= 0 || x >= int(Width) - 1 || y >= int(Height) - 1)
+    {
+        return 0.0;
+    }
+
+    const uint i = uint(y) * Width + uint(x);
+    return 0.5 * ((VelocityYIn[i + 1] - VelocityYIn[i - 1]) - (VelocityXIn[i + Width] - VelocityXIn[i - Width]));
+}
+
+[numthreads(TILE_SIZE, TILE_SIZE, 1)]
+void main(uint3 group : SV_GroupID, uint3 local : SV_GroupThreadID, uint3 id : SV_DispatchThreadID)
+{
+    const int2 origin = int2(group.xy) * TILE_SIZE - 1;
+    for (uint i = local.y * TILE_SIZE + local.x; i < SHARED_SIZE * SHARED_SIZE; i += TILE_SIZE * TILE_SIZE)
+    {
+        const uint2 cell = uint2(i % SHARED_SIZE, i / SHARED_SIZE);
+        Curl[cell.y][cell.x] = CurlAt(origin.x + int(cell.x), origin.y + int(cell.y));
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (id.x >= Width || id.y >= Height)
+    {
+        return;
+    }
+
+    const uint index = id.y * Width + id.x;
+    float vx = VelocityXIn[index];
+    float vy = VelocityYIn[index];
+
+    if (id.x > 0 && id.y > 0 && id.x < Width - 1 && id.y < Height - 1)
+    {
+        const uint2 s = local.xy + 1;
+        const float gx = 0.5 * (abs(Curl[s.y][s.x + 1]) - abs(Curl[s.y][s.x - 1]));
+        const float gy = 0.5 * (abs(Curl[s.y + 1][s.x]) - abs(Curl[s.y - 1][s.x]));
+        const float length = sqrt(gx * gx + gy * gy) + 1.0e-5;
+        const float strength = BandStrength[id.x * BandCount / Width];
+        const float scale = TimeStep * strength * Curl[s.y][s.x] / length;
+
+        vx += scale * gy;
+        vy -= scale * gx;
+    }
+
+    VelocityXOut[index] = vx;
+    VelocityYOut[index] = vy;
+}
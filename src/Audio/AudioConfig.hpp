@@ -9,6 +9,8 @@ struct Config
 {
     static constexpr uint32_t kSampleRate = 48000;
     static constexpr uint32_t kFFTSize = 2048;
+    static constexpr uint32_t kFFTBinCount = (kFFTSize / 2) + 1;
+    static constexpr uint32_t kBandCount = 32;
     static constexpr size_t kRingBufferSize = 1 << 14;
 };
 } // namespace Audio
@@ -3,30 +3,145 @@
 #define MINIAUDIO_IMPLEMENTATION
 #include <miniaudio.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <memory>
 #include <span>
 #include <stdexcept>
 
 #include "../Core/Logger.hpp"
+#include "../Core/Metrics.hpp"
+#include "../Core/Trace.hpp"
 #include "AudioConfig.hpp"
 #include "AudioRingBuffer.hpp"
 
 namespace Audio
 {
+namespace
+{
+constexpr double kNanosecondsPerSecond = 1.0e9;
+constexpr int64_t kMinGapToleranceNs = 5'000'000;      // Scheduling noise a callback may arrive late by
+constexpr int64_t kRebaseIntervalNs = 10'000'000'000;  // Keeps device/host clock drift from adding up to a gap
+constexpr int64_t kSilencePauseNs = 100'000'000;       // Loopback sends nothing while the output is silent
+
+int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void RaiseMax(std::atomic<int64_t>& max, int64_t value)
+{
+    int64_t current = max.load(std::memory_order::relaxed);
+    while (value > current && !max.compare_exchange_weak(current, value, std::memory_order::relaxed))
+    {
+    }
+}
+} // namespace
+
+struct AudioCallbackState
+{
+    AudioRingBuffer& RingBuffer;
+
+    Core::Counter& Callbacks;
+    Core::Counter& Frames;
+    Core::Counter& Gaps;
+    Core::Counter& Interruptions;
+    Core::Histogram& CallbackSeconds;
+    Core::Histogram& JitterSeconds;
+    std::atomic<int64_t> MaxCallbackNs = 0;
+    std::atomic<int64_t> MaxJitterNs = 0;
+
+    // Callback thread only. Wall time since Origin should be covered by the audio delivered since then; when it
+    // runs ahead by more than a couple of periods, audio went missing. WASAPI loopback delivers no callbacks at all
+    // while nothing plays, so a pause far longer than a period starts the accounting afresh instead: a device stall
+    // that long is indistinguishable from silence, and counting every pause between tracks would bury real gaps.
+    int64_t LastStart = -1;
+    int64_t Origin = 0;
+    uint64_t FramesSinceOrigin = 0;
+
+    void Record(int64_t start, int64_t end, uint32_t frameCount, uint32_t sampleRate)
+    {
+        const double nanosecondsPerFrame = kNanosecondsPerSecond / static_cast<double>(sampleRate);
+        const auto period = static_cast<int64_t>(frameCount * nanosecondsPerFrame);
+
+        Callbacks.Add();
+        Frames.Add(frameCount);
+        CallbackSeconds.Observe(static_cast<double>(end - start) / kNanosecondsPerSecond);
+        RaiseMax(MaxCallbackNs, end - start);
+
+        if (LastStart < 0)
+        {
+            Origin = start;
+            FramesSinceOrigin = 0;
+            LastStart = start;
+            return;
+        }
+
+        if (start - LastStart > std::max(kSilencePauseNs, 4 * period))
+        {
+            Origin = start;
+            FramesSinceOrigin = 0;
+            LastStart = start;
+            return;
+        }
+
+        const int64_t jitter = std::abs(start - LastStart - period);
+        JitterSeconds.Observe(static_cast<double>(jitter) / kNanosecondsPerSecond);
+        RaiseMax(MaxJitterNs, jitter);
+        LastStart = start;
+
+        FramesSinceOrigin += frameCount;
+        const auto behind =
+            start - Origin - static_cast<int64_t>(static_cast<double>(FramesSinceOrigin) * nanosecondsPerFrame);
+        const int64_t tolerance = std::max(2 * period, kMinGapToleranceNs);
+        if (behind > tolerance)
+        {
+            Gaps.Add();
+        }
+        if (std::abs(behind) > tolerance || start - Origin > kRebaseIntervalNs)
+        {
+            Origin = start;
+            FramesSinceOrigin = 0;
+        }
+    }
+};
+
 namespace
 {
 void DataCallback(ma_device* pDevice, [[maybe_unused]] void* pOutput, const void* pInput, ma_uint32 frameCount)
 {
+    Core::Trace::NameThread("Audio"); // miniaudio owns the thread; naming it again costs one relaxed store
+    TRACE_SCOPE("DataCallback", "audio");
     if (!pDevice || !pDevice->pUserData || !pInput)
     {
         return;
     }
 
-    auto* ringBuffer = static_cast<AudioRingBuffer*>(pDevice->pUserData);
+    const int64_t start = NowNs();
+    auto* state = static_cast<AudioCallbackState*>(pDevice->pUserData);
     const auto* inputFloats = static_cast<const float*>(pInput);
 
-    ringBuffer->Write(std::span<const float>(inputFloats, frameCount));
+    state->RingBuffer.Write(std::span<const float>(inputFloats, frameCount));
+    state->Record(start, NowNs(), frameCount, pDevice->sampleRate);
+}
+
+void NotificationCallback(const ma_device_notification* pNotification)
+{
+    if (!pNotification || !pNotification->pDevice || !pNotification->pDevice->pUserData)
+    {
+        return;
+    }
+
+    if (pNotification->type == ma_device_notification_type_rerouted ||
+        pNotification->type == ma_device_notification_type_interruption_began)
+    {
+        static_cast<AudioCallbackState*>(pNotification->pDevice->pUserData)->Interruptions.Add();
+    }
 }
 } // namespace
 
@@ -39,14 +154,29 @@ void AudioDriver::MaDeviceDestroyer::operator()(ma_device* device) const
     }
 }
 
-AudioDriver::AudioDriver(AudioRingBuffer& ringBuffer) : m_device(nullptr), m_ringBuffer(ringBuffer)
+AudioDriver::AudioDriver(AudioRingBuffer& ringBuffer, Core::MetricsRegistry& metrics)
+    : m_callbackState(new AudioCallbackState{ // NOLINT(cppcoreguidelines-owning-memory): immovable, no make_unique
+          .RingBuffer = ringBuffer,
+          .Callbacks = metrics.AddCounter("af_audio_callbacks_total", "Capture callbacks run"),
+          .Frames = metrics.AddCounter("af_audio_frames_total", "Audio frames captured"),
+          .Gaps = metrics.AddCounter("af_audio_gaps_total", "Capture gaps: wall time not covered by delivered audio"),
+          .Interruptions = metrics.AddCounter("af_audio_interruptions_total",
+                                              "Device reroutes and interruptions reported by the backend"),
+          .CallbackSeconds = metrics.AddHistogram("af_audio_callback_seconds",
+                                                  "Wall time spent inside the capture callback",
+                                                  {0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.001, 0.005}),
+          .JitterSeconds = metrics.AddHistogram("af_audio_callback_jitter_seconds",
+                                                "Deviation of each callback interval from the audio it delivered",
+                                                {0.0005, 0.001, 0.002, 0.005, 0.01, 0.02, 0.05})}),
+      m_device(nullptr)
 {
     ma_device_config config = ma_device_config_init(ma_device_type_loopback);
     config.capture.format = ma_format_f32;
     config.capture.channels = 1;
     config.sampleRate = Config::kSampleRate;
     config.dataCallback = DataCallback;
-    config.pUserData = &m_ringBuffer;
+    config.notificationCallback = NotificationCallback;
+    config.pUserData = m_callbackState.get();
 
     LOG_INFO("AudioDriver: Initializing Loopback device...");
 
@@ -77,4 +207,18 @@ AudioDriver::AudioDriver(AudioRingBuffer& ringBuffer) : m_device(nullptr), m_rin
 }
 
 AudioDriver::~AudioDriver() = default;
+
+AudioCallbackStats AudioDriver::GetCallbackStats() const
+{
+    const AudioCallbackState& state = *m_callbackState;
+    return AudioCallbackStats{
+        .Callbacks = state.Callbacks.Get(),
+        .Frames = state.Frames.Get(),
+        .Gaps = state.Gaps.Get(),
+        .Interruptions = state.Interruptions.Get(),
+        .MaxCallbackSeconds =
+            static_cast<double>(state.MaxCallbackNs.load(std::memory_order::relaxed)) / kNanosecondsPerSecond,
+        .MaxJitterSeconds =
+            static_cast<double>(state.MaxJitterNs.load(std::memory_order::relaxed)) / kNanosecondsPerSecond};
+}
 } // namespace Audio
@@ -1,17 +1,37 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 struct ma_device; // NOLINT(readability-identifier-naming)
 
+namespace Core
+{
+class MetricsRegistry;
+} // namespace Core
+
 namespace Audio
 {
 class AudioRingBuffer;
+struct AudioCallbackState;
+
+// Totals since the device started, measured by the capture callback itself.
+struct AudioCallbackStats
+{
+    uint64_t Callbacks = 0;
+    uint64_t Frames = 0;
+    uint64_t Gaps = 0;          // Wall time ran ahead of the audio delivered: xruns, or stalls too short to be silence
+    uint64_t Interruptions = 0; // Reroutes and interruptions reported by the backend
+    double MaxCallbackSeconds = 0.0;
+    double MaxJitterSeconds = 0.0; // Largest deviation of a callback interval from the audio it delivered
+};
 
+// Captures the system output through a loopback device into the ring buffer. The callback also times itself
+// and registers the results with the metrics registry; it stays lock- and allocation-free.
 class AudioDriver
 {
 public:
-    explicit AudioDriver(AudioRingBuffer& ringBuffer);
+    AudioDriver(AudioRingBuffer& ringBuffer, Core::MetricsRegistry& metrics);
     ~AudioDriver();
 
     AudioDriver(const AudioDriver&) = delete;
@@ -19,6 +39,8 @@ class AudioDriver
     AudioDriver(AudioDriver&&) = delete;
     AudioDriver& operator=(AudioDriver&&) = delete;
 
+    [[nodiscard]] AudioCallbackStats GetCallbackStats() const;
+
 private:
     struct MaDeviceDestroyer
     {
@@ -27,7 +49,7 @@ class AudioDriver
 
     using MaDevicePtr = std::unique_ptr<ma_device, MaDeviceDestroyer>;
 
+    std::unique_ptr<AudioCallbackState> m_callbackState; // Outlives the device, whose callbacks use it
     MaDevicePtr m_device;
-    AudioRingBuffer& m_ringBuffer;
 };
 } // namespace Audio
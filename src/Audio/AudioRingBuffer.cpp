@@ -33,7 +33,7 @@ void AudioRingBuffer::Write(std::span<const float> data)
     m_writeIndex.store(head, std::memory_order::release);
 }
 
-void AudioRingBuffer::ReadLatest(std::span<float> outData) const
+size_t AudioRingBuffer::ReadLatest(std::span<float> outData) const
 {
     const size_t head = m_writeIndex.load(std::memory_order::acquire);
     size_t readPos = head - outData.size();
@@ -42,5 +42,6 @@ void AudioRingBuffer::ReadLatest(std::span<float> outData) const
     {
         sample = m_buffer[readPos++ & m_mask];
     }
+    return head;
 }
 } // namespace Audio
@@ -19,7 +19,8 @@ class AudioRingBuffer
     AudioRingBuffer& operator=(AudioRingBuffer&&) = delete;
 
     void Write(std::span<const float> data);
-    void ReadLatest(std::span<float> outData) const;
+    // Copies the most recent samples and returns how many had been written in total at that point.
+    size_t ReadLatest(std::span<float> outData) const;
 
 private:
     std::vector<float> m_buffer;
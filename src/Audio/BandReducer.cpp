@@ -0,0 +1,187 @@
+#include "BandReducer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "../Core/Logger.hpp"
+#include "../Core/Simd.hpp"
+#include "AudioConfig.hpp"
+
+namespace Audio
+{
+namespace
+{
+constexpr float kMelBreakFrequency = 700.0F;
+constexpr float kMelScale = 2595.0F;
+constexpr size_t kEdgeCount = Config::kBandCount + 2;
+
+float HzToScale(float hz, BandScale scale)
+{
+    if (scale == BandScale::Mel)
+    {
+        return kMelScale * std::log10(1.0F + (hz / kMelBreakFrequency));
+    }
+    return std::log2(hz);
+}
+
+float ScaleToHz(float value, BandScale scale)
+{
+    if (scale == BandScale::Mel)
+    {
+        return kMelBreakFrequency * (std::pow(10.0F, value / kMelScale) - 1.0F);
+    }
+    return std::exp2(value);
+}
+
+float SmoothingCoefficient(float dt, float timeConstant)
+{
+    if (timeConstant <= 0.0F)
+    {
+        return 1.0F;
+    }
+    return 1.0F - std::exp(-dt / timeConstant);
+}
+} // namespace
+
+BandReducer::BandReducer(const BandReducerSettings& settings, uint32_t sampleRate, uint32_t fftSize)
+    : m_settings(settings), m_binCount((fftSize / 2) + 1)
+{
+    const float nyquist = static_cast<float>(sampleRate) * 0.5F;
+
+    if (settings.MinFrequency <= 0.0F || settings.MaxFrequency <= settings.MinFrequency ||
+        settings.MaxFrequency > nyquist)
+    {
+        throw std::invalid_argument("BandReducer: Invalid frequency range");
+    }
+
+    BuildFilterbank(sampleRate, fftSize);
+
+    LOG_INFO("BandReducer: {} {} bands over {:.0f}-{:.0f} Hz ({} weights)",
+             Config::kBandCount,
+             settings.Scale == BandScale::Mel ? "mel" : "log",
+             settings.MinFrequency,
+             settings.MaxFrequency,
+             m_weights.size());
+}
+
+void BandReducer::BuildFilterbank(uint32_t sampleRate, uint32_t fftSize)
+{
+    const float binWidth = static_cast<float>(sampleRate) / static_cast<float>(fftSize);
+    const float scaleMin = HzToScale(m_settings.MinFrequency, m_settings.Scale);
+    const float scaleMax = HzToScale(m_settings.MaxFrequency, m_settings.Scale);
+
+    std::array<float, kEdgeCount> edges{};
+    for (size_t i = 0; i < kEdgeCount; ++i)
+    {
+        const float t = static_cast<float>(i) / static_cast<float>(kEdgeCount - 1);
+        edges[i] = ScaleToHz(scaleMin + (t * (scaleMax - scaleMin)), m_settings.Scale) / binWidth;
+    }
+
+    std::vector<float> dense(m_binCount);
+
+    for (size_t band = 0; band < Config::kBandCount; ++band)
+    {
+        const float lower = edges[band];
+        const float center = edges[band + 1];
+        const float upper = edges[band + 2];
+
+        std::ranges::fill(dense, 0.0F);
+        float weightSum = 0.0F;
+
+        for (uint32_t bin = 0; bin < m_binCount; ++bin)
+        {
+            const auto position = static_cast<float>(bin);
+            float weight = 0.0F;
+
+            if (position > lower && position <= center)
+            {
+                weight = (position - lower) / (center - lower);
+            }
+            else if (position > center && position < upper)
+            {
+                weight = (upper - position) / (upper - center);
+            }
+
+            dense[bin] = weight;
+            weightSum += weight;
+        }
+
+        // Low bands can be narrower than one bin; fall back to the nearest bin so no band is silent.
+        if (weightSum <= 0.0F)
+        {
+            const auto nearest = std::min(static_cast<uint32_t>(std::lround(center)), m_binCount - 1);
+            dense[nearest] = 1.0F;
+            weightSum = 1.0F;
+        }
+
+        const auto first = static_cast<uint32_t>(std::distance(
+            dense.begin(), std::ranges::find_if(dense, [](float w) { return w > 0.0F; })));
+        const auto last = static_cast<uint32_t>(std::distance(
+            std::ranges::find_if(dense.rbegin(), dense.rend(), [](float w) { return w > 0.0F; }), dense.rend()));
+
+        // Pad each row to a whole number of SIMD lanes. Rows near Nyquist are shifted down instead of
+        // reading past the end of the spectrum; the extra leading weights are zero.
+        const uint32_t lanes = Core::Simd::kFloatLanes;
+        const uint32_t count = ((last - first) + lanes - 1) / lanes * lanes;
+        const uint32_t start = std::min(first, m_binCount - count);
+
+        m_rows[band] = BandRow{.FirstBin = start,
+                               .WeightOffset = static_cast<uint32_t>(m_weights.size()),
+                               .WeightCount = count};
+
+        for (uint32_t bin = start; bin < start + count; ++bin)
+        {
+            m_weights.push_back(dense[bin] / weightSum);
+        }
+    }
+}
+
+void BandReducer::Process(std::span<const float> magnitudes, float dt)
+{
+    if (magnitudes.size() < m_binCount)
+    {
+        LOG_ERROR("BandReducer: Expected {} bins, got {}", m_binCount, magnitudes.size());
+        return;
+    }
+
+    for (size_t band = 0; band < Config::kBandCount; ++band)
+    {
+        const BandRow& row = m_rows[band];
+        m_rawBands[band] =
+            Core::Simd::DotProduct(&m_weights[row.WeightOffset], &magnitudes[row.FirstBin], row.WeightCount);
+    }
+
+    const float attack = SmoothingCoefficient(dt, m_settings.AttackSeconds);
+    const float release = SmoothingCoefficient(dt, m_settings.ReleaseSeconds);
+
+    for (size_t band = 0; band < Config::kBandCount; ++band)
+    {
+        const float target = m_rawBands[band];
+        const float coefficient = target > m_bands[band] ? attack : release;
+        m_bands[band] += coefficient * (target - m_bands[band]);
+    }
+}
+
+void BandReducer::Reset()
+{
+    m_rawBands.fill(0.0F);
+    m_bands.fill(0.0F);
+}
+
+const BandArray& BandReducer::GetBands() const
+{
+    return m_bands;
+}
+
+const BandArray& BandReducer::GetRawBands() const
+{
+    return m_rawBands;
+}
+} // namespace Audio
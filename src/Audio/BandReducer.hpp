@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "AudioConfig.hpp"
+
+namespace Audio
+{
+using BandArray = std::array<float, Config::kBandCount>;
+
+enum class BandScale : std::uint8_t
+{
+    Logarithmic,
+    Mel
+};
+
+struct BandReducerSettings
+{
+    BandScale Scale = BandScale::Mel;
+    float MinFrequency = 30.0F;
+    float MaxFrequency = 16000.0F;
+    float AttackSeconds = 0.010F;
+    float ReleaseSeconds = 0.250F;
+};
+
+// Collapses FFT magnitudes into Config::kBandCount triangular bands. The filterbank is stored as one
+// dense, zero-padded weight row per band starting at its first non-zero bin, so each band is a
+// single SIMD dot product over a contiguous slice of the spectrum.
+class BandReducer
+{
+public:
+    BandReducer(const BandReducerSettings& settings, uint32_t sampleRate, uint32_t fftSize);
+    ~BandReducer() = default;
+
+    BandReducer(const BandReducer&) = delete;
+    BandReducer& operator=(const BandReducer&) = delete;
+    BandReducer(BandReducer&&) noexcept = default;
+    BandReducer& operator=(BandReducer&&) noexcept = default;
+
+    void Process(std::span<const float> magnitudes, float dt);
+    void Reset();
+
+    [[nodiscard]] const BandArray& GetBands() const;
+    [[nodiscard]] const BandArray& GetRawBands() const;
+
+private:
+    struct BandRow
+    {
+        uint32_t FirstBin = 0;
+        uint32_t WeightOffset = 0;
+        uint32_t WeightCount = 0;
+    };
+
+    void BuildFilterbank(uint32_t sampleRate, uint32_t fftSize);
+
+    BandReducerSettings m_settings;
+    uint32_t m_binCount = 0;
+
+    std::array<BandRow, Config::kBandCount> m_rows{};
+    std::vector<float> m_weights;
+
+    BandArray m_rawBands{};
+    BandArray m_bands{};
+};
+} // namespace Audio
@@ -0,0 +1,71 @@
+#include "SpectrumAnalyzer.hpp"
+
+#include <pocketfft_hdronly.h>
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numbers>
+#include <numeric>
+#include <span>
+
+#include "../Core/Trace.hpp"
+#include "AudioConfig.hpp"
+#include "AudioRingBuffer.hpp"
+
+namespace Audio
+{
+SpectrumAnalyzer::SpectrumAnalyzer(const AudioRingBuffer& ringBuffer)
+    : m_ringBuffer(ringBuffer),
+      m_window(Config::kFFTSize),
+      m_samples(Config::kFFTSize),
+      m_spectrum(Config::kFFTBinCount),
+      m_magnitudes(Config::kFFTBinCount)
+{
+    // Hann window; magnitudes are scaled so a full-scale sine reads ~1.0 regardless of window gain.
+    for (size_t i = 0; i < m_window.size(); ++i)
+    {
+        const double phase = 2.0 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(Config::kFFTSize);
+        m_window[i] = static_cast<float>(0.5 * (1.0 - std::cos(phase)));
+    }
+
+    const float windowSum = std::accumulate(m_window.begin(), m_window.end(), 0.0F);
+    m_magnitudeScale = 2.0F / windowSum;
+}
+
+void SpectrumAnalyzer::Process()
+{
+    TRACE_SCOPE("Analyze", "audio");
+    const size_t written = m_ringBuffer.ReadLatest(m_samples);
+    if (m_hasRead && written - m_lastWritten > Config::kRingBufferSize)
+    {
+        ++m_overruns;
+    }
+    m_lastWritten = written;
+    m_hasRead = true;
+
+    for (size_t i = 0; i < m_samples.size(); ++i)
+    {
+        m_samples[i] *= m_window[i];
+    }
+
+    pocketfft::r2c<float>({Config::kFFTSize},
+                          {sizeof(float)},
+                          {sizeof(std::complex<float>)},
+                          0,
+                          pocketfft::FORWARD,
+                          m_samples.data(),
+                          m_spectrum.data(),
+                          1.0F);
+
+    for (size_t i = 0; i < m_spectrum.size(); ++i)
+    {
+        m_magnitudes[i] = std::abs(m_spectrum[i]) * m_magnitudeScale;
+    }
+}
+
+std::span<const float> SpectrumAnalyzer::GetMagnitudes() const
+{
+    return m_magnitudes;
+}
+} // namespace Audio
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Audio
+{
+class AudioRingBuffer;
+
+class SpectrumAnalyzer
+{
+public:
+    explicit SpectrumAnalyzer(const AudioRingBuffer& ringBuffer);
+    ~SpectrumAnalyzer() = default;
+
+    SpectrumAnalyzer(const SpectrumAnalyzer&) = delete;
+    SpectrumAnalyzer& operator=(const SpectrumAnalyzer&) = delete;
+    SpectrumAnalyzer(SpectrumAnalyzer&&) = delete;
+    SpectrumAnalyzer& operator=(SpectrumAnalyzer&&) = delete;
+
+    void Process();
+
+    [[nodiscard]] std::span<const float> GetMagnitudes() const;
+
+    // Times the capture ring wrapped between two Process() calls, losing audio that was never analyzed.
+    [[nodiscard]] uint64_t GetOverrunCount() const { return m_overruns; }
+
+private:
+    const AudioRingBuffer& m_ringBuffer;
+
+    std::vector<float> m_window;
+    std::vector<float> m_samples;
+    std::vector<std::complex<float>> m_spectrum;
+    std::vector<float> m_magnitudes;
+    float m_magnitudeScale = 1.0F;
+
+    size_t m_lastWritten = 0;
+    bool m_hasRead = false;
+    uint64_t m_overruns = 0;
+};
+} // namespace Audio
@@ -0,0 +1,82 @@
+#include "AllocationCounter.hpp"
+
+#include <cstdint>
+
+#ifdef AF_COUNT_ALLOCATIONS
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+thread_local uint64_t t_allocationCount = 0;
+} // namespace
+
+// The array and nothrow forms forward to these by default, so replacing the plain and aligned forms is enough.
+void* operator new(std::size_t bytes)
+{
+    ++t_allocationCount;
+
+    if (void* ptr = std::malloc(bytes == 0 ? 1 : bytes)) // NOLINT(cppcoreguidelines-no-malloc)
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+void operator delete(void* ptr, std::size_t /*bytes*/) noexcept
+{
+    std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+void* operator new(std::size_t bytes, std::align_val_t alignment)
+{
+    ++t_allocationCount;
+
+    const auto align = static_cast<std::size_t>(alignment);
+    const std::size_t rounded = ((bytes == 0 ? 1 : bytes) + align - 1) & ~(align - 1);
+
+#ifdef _MSC_VER
+    void* ptr = _aligned_malloc(rounded, align);
+#else
+    void* ptr = std::aligned_alloc(align, rounded);
+#endif
+
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr, std::align_val_t /*alignment*/) noexcept
+{
+#ifdef _MSC_VER
+    _aligned_free(ptr);
+#else
+    std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+#endif
+}
+
+void operator delete(void* ptr, std::size_t /*bytes*/, std::align_val_t alignment) noexcept
+{
+    operator delete(ptr, alignment);
+}
+#endif
+
+namespace Core::AllocationCounter
+{
+uint64_t GetThreadCount()
+{
+#ifdef AF_COUNT_ALLOCATIONS
+    return t_allocationCount;
+#else
+    return 0;
+#endif
+}
+} // namespace Core::AllocationCounter
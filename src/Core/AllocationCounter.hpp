@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Core::AllocationCounter
+{
+// Debug builds define AF_COUNT_ALLOCATIONS and replace global operator new to count heap allocations per
+// thread, so the frame loop can check that it has stopped touching the heap once warmed up.
+#ifdef AF_COUNT_ALLOCATIONS
+inline constexpr bool kEnabled = true;
+#else
+inline constexpr bool kEnabled = false;
+#endif
+
+// Allocations made by the calling thread since it started; always 0 when counting is compiled out.
+[[nodiscard]] uint64_t GetThreadCount();
+} // namespace Core::AllocationCounter
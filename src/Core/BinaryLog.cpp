@@ -0,0 +1,266 @@
+#include "BinaryLog.hpp"
+
+#include <spdlog/common.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/fmt/fmt.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Logger.hpp"
+#include "Trace.hpp"
+
+namespace Core
+{
+namespace
+{
+constexpr size_t kRingBytes = 64 * 1024; // Per producing thread; power of two
+constexpr size_t kRecordAlignment = 8;
+constexpr auto kDrainInterval = std::chrono::milliseconds(10);
+constexpr std::string_view kLoggerName = "APP";
+
+struct RecordHeader
+{
+    uint32_t RecordBytes; // Header + payload, padded; 0 marks the unused tail of the ring before a wrap
+    uint32_t PayloadBytes;
+    const LogSite* Site;
+    BinaryLog::DecodeFunction Decode;
+    int64_t Time; // spdlog::log_clock ticks
+};
+
+constexpr size_t RecordSize(size_t payloadBytes)
+{
+    return (sizeof(RecordHeader) + payloadBytes + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+// Single producer (the owning thread), single consumer (the drain thread).
+class ThreadRing
+{
+public:
+    ThreadRing() : m_data(std::make_unique_for_overwrite<std::byte[]>(kRingBytes)) {} // NOLINT
+
+    std::byte* Reserve(size_t payloadBytes)
+    {
+        const size_t recordBytes = RecordSize(payloadBytes);
+        const uint64_t head = m_head.load(std::memory_order::relaxed);
+        const uint64_t tail = m_tail.load(std::memory_order::acquire);
+
+        const size_t offset = head & (kRingBytes - 1);
+        const size_t contiguous = kRingBytes - offset;
+        const size_t skip = recordBytes > contiguous ? contiguous : 0;
+
+        if (recordBytes > kRingBytes || (head - tail) + skip + recordBytes > kRingBytes)
+        {
+            m_dropped.fetch_add(1, std::memory_order::relaxed);
+            return nullptr;
+        }
+
+        if (skip > 0)
+        {
+            constexpr uint32_t kWrapMarker = 0;
+            std::memcpy(m_data.get() + offset, &kWrapMarker, sizeof(kWrapMarker));
+        }
+
+        m_pendingHead = head + skip;
+        return m_data.get() + ((m_pendingHead & (kRingBytes - 1)) + sizeof(RecordHeader));
+    }
+
+    void Commit(const LogSite& site, BinaryLog::DecodeFunction decode, size_t payloadBytes)
+    {
+        const size_t recordBytes = RecordSize(payloadBytes);
+        const RecordHeader header{.RecordBytes = static_cast<uint32_t>(recordBytes),
+                                  .PayloadBytes = static_cast<uint32_t>(payloadBytes),
+                                  .Site = &site,
+                                  .Decode = decode,
+                                  .Time = spdlog::log_clock::now().time_since_epoch().count()};
+
+        std::memcpy(m_data.get() + (m_pendingHead & (kRingBytes - 1)), &header, sizeof(header));
+        m_head.store(m_pendingHead + recordBytes, std::memory_order::release);
+    }
+
+    template <typename Fn>
+    void Drain(const Fn& consume)
+    {
+        uint64_t tail = m_tail.load(std::memory_order::relaxed);
+        const uint64_t head = m_head.load(std::memory_order::acquire);
+
+        while (tail < head)
+        {
+            const size_t offset = tail & (kRingBytes - 1);
+            const std::byte* record = m_data.get() + offset;
+
+            uint32_t recordBytes = 0;
+            std::memcpy(&recordBytes, record, sizeof(recordBytes));
+            if (recordBytes == 0)
+            {
+                tail += kRingBytes - offset;
+                continue;
+            }
+
+            RecordHeader header{};
+            std::memcpy(&header, record, sizeof(header));
+            consume(header, record + sizeof(RecordHeader));
+            tail += recordBytes;
+        }
+
+        m_tail.store(tail, std::memory_order::release);
+    }
+
+    [[nodiscard]] uint64_t GetDropped() const { return m_dropped.load(std::memory_order::relaxed); }
+
+private:
+    std::unique_ptr<std::byte[]> m_data; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    alignas(64) std::atomic<uint64_t> m_head = 0;
+    alignas(64) std::atomic<uint64_t> m_tail = 0;
+    uint64_t m_pendingHead = 0;
+    std::atomic<uint64_t> m_dropped = 0;
+};
+
+struct BinaryLogState
+{
+    std::mutex RingsMutex; // Taken when a thread logs for the first time and by the drain pass
+    std::vector<std::unique_ptr<ThreadRing>> Rings;
+
+    spdlog::sink_ptr Sink;
+    std::atomic<int> MinLevel = spdlog::level::off;
+    std::jthread DrainThread;
+};
+
+BinaryLogState& GetState()
+{
+    static BinaryLogState state;
+    return state;
+}
+
+thread_local ThreadRing* t_ring = nullptr;
+
+void DrainAll(BinaryLogState& state)
+{
+    TRACE_SCOPE("Drain", "log");
+    fmt::memory_buffer text;
+    const std::scoped_lock lock(state.RingsMutex);
+
+    for (const auto& ring : state.Rings)
+    {
+        ring->Drain([&](const RecordHeader& header, const std::byte* payload) {
+            text.clear();
+            try
+            {
+                header.Decode(header.Site->Format, payload, text);
+            }
+            catch (const std::exception& e)
+            {
+                text.clear();
+                fmt::format_to(fmt::appender(text), "<bad hot log '{}': {}>", header.Site->Format, e.what());
+            }
+
+            const spdlog::details::log_msg message(
+                spdlog::log_clock::time_point(spdlog::log_clock::duration(header.Time)),
+                spdlog::source_loc{},
+                kLoggerName,
+                header.Site->Level,
+                std::string_view(text.data(), text.size()));
+            state.Sink->log(message);
+        });
+    }
+}
+} // namespace
+
+void BinaryLog::Start(spdlog::sink_ptr sink, spdlog::level::level_enum level)
+{
+    BinaryLogState& state = GetState();
+    state.Sink = std::move(sink);
+
+    state.DrainThread = std::jthread([&state](const std::stop_token& stopToken) {
+        Trace::NameThread("BinaryLog");
+        std::mutex sleepMutex;
+        std::condition_variable_any wake;
+
+        while (!stopToken.stop_requested())
+        {
+            DrainAll(state);
+
+            std::unique_lock lock(sleepMutex);
+            wake.wait_for(lock, stopToken, kDrainInterval, [] { return false; });
+        }
+        DrainAll(state);
+    });
+
+    state.MinLevel.store(level, std::memory_order::release);
+}
+
+void BinaryLog::Stop()
+{
+    BinaryLogState& state = GetState();
+    if (!state.DrainThread.joinable())
+    {
+        return;
+    }
+
+    state.MinLevel.store(spdlog::level::off, std::memory_order::release);
+    state.DrainThread.request_stop();
+    state.DrainThread.join();
+
+    if (const uint64_t dropped = GetDroppedCount(); dropped > 0)
+    {
+        LOG_WARN("BinaryLog: Dropped {} records on full buffers", dropped);
+    }
+
+    state.Sink->flush();
+    state.Sink.reset();
+}
+
+void BinaryLog::SetLevel(spdlog::level::level_enum level)
+{
+    BinaryLogState& state = GetState();
+    if (state.DrainThread.joinable())
+    {
+        state.MinLevel.store(level, std::memory_order::release);
+    }
+}
+
+bool BinaryLog::ShouldLog(spdlog::level::level_enum level)
+{
+    return level >= GetState().MinLevel.load(std::memory_order::relaxed);
+}
+
+uint64_t BinaryLog::GetDroppedCount()
+{
+    BinaryLogState& state = GetState();
+    const std::scoped_lock lock(state.RingsMutex);
+
+    uint64_t dropped = 0;
+    for (const auto& ring : state.Rings)
+    {
+        dropped += ring->GetDropped();
+    }
+    return dropped;
+}
+
+std::byte* BinaryLog::Reserve(size_t payloadBytes)
+{
+    if (!t_ring)
+    {
+        BinaryLogState& state = GetState();
+        const std::scoped_lock lock(state.RingsMutex);
+        t_ring = state.Rings.emplace_back(std::make_unique<ThreadRing>()).get();
+    }
+    return t_ring->Reserve(payloadBytes);
+}
+
+void BinaryLog::Commit(const LogSite& site, DecodeFunction decode, size_t payloadBytes)
+{
+    t_ring->Commit(site, decode, payloadBytes);
+}
+} // namespace Core
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <spdlog/common.h>
+#include <spdlog/fmt/fmt.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace Core
+{
+// One per LOG_HOT_* call site, in static storage; its address is the format-string ID in the record.
+struct LogSite
+{
+    spdlog::level::level_enum Level;
+    std::string_view Format;
+};
+
+// Structured log path for per-frame diagnostics. A call copies the site pointer, a timestamp and the raw
+// argument bytes into a lock-free single-producer ring owned by the calling thread; no formatting, locking
+// or heap allocation happens on that thread after its first record. A background thread drains every ring,
+// formats the records and hands them to the rotating file sink. When a ring is full the record is dropped
+// and counted rather than blocking the producer.
+class BinaryLog
+{
+public:
+    using DecodeFunction = void (*)(std::string_view format, const std::byte* payload, fmt::memory_buffer& out);
+
+    static void Start(spdlog::sink_ptr sink, spdlog::level::level_enum level);
+    static void Stop();
+    // Changes the lowest level recorded; ignored unless started.
+    static void SetLevel(spdlog::level::level_enum level);
+
+    [[nodiscard]] static bool ShouldLog(spdlog::level::level_enum level);
+    [[nodiscard]] static uint64_t GetDroppedCount();
+
+    template <typename... Args>
+    static void Write(const LogSite& site, const Args&... args)
+    {
+        static_assert(((std::is_arithmetic_v<Args> || std::is_enum_v<Args>) && ...),
+                      "Hot-path log arguments must be arithmetic or enum values");
+
+        if (!ShouldLog(site.Level))
+        {
+            return;
+        }
+
+        constexpr size_t kPayloadBytes = (sizeof(Stored<Args>) + ... + 0);
+        std::byte* record = Reserve(kPayloadBytes);
+        if (!record)
+        {
+            return;
+        }
+
+        std::byte* payload = record;
+        (Store(payload, static_cast<Stored<Args>>(args)), ...);
+        Commit(site, &Decode<Stored<Args>...>, kPayloadBytes);
+    }
+
+private:
+    template <typename T>
+    struct StoredType
+    {
+        using Type = T;
+    };
+
+    template <typename T>
+        requires std::is_enum_v<T>
+    struct StoredType<T>
+    {
+        using Type = std::underlying_type_t<T>;
+    };
+
+    template <typename T>
+    using Stored = typename StoredType<T>::Type;
+
+    // Returns space for the payload of the calling thread's next record, or nullptr if its ring is full.
+    [[nodiscard]] static std::byte* Reserve(size_t payloadBytes);
+    static void Commit(const LogSite& site, DecodeFunction decode, size_t payloadBytes);
+
+    template <typename T>
+    static void Store(std::byte*& cursor, const T& value)
+    {
+        std::memcpy(cursor, &value, sizeof(T));
+        cursor += sizeof(T); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    template <typename... Ts>
+    static void Decode(std::string_view format, const std::byte* payload, fmt::memory_buffer& out)
+    {
+        std::tuple<Ts...> values;
+        std::apply(
+            [&payload](Ts&... value) {
+                ((std::memcpy(&value, payload, sizeof(Ts)), payload += sizeof(Ts)), ...); // NOLINT
+            },
+            values);
+        std::apply(
+            [&](const Ts&... value) {
+                fmt::vformat_to(fmt::appender(out), format, fmt::make_format_args(value...));
+            },
+            values);
+    }
+};
+} // namespace Core
@@ -21,8 +21,39 @@ struct Config
 
     // Physics Settings
     static constexpr double kPhysicsTimeStep = 1.0 / 60.0;
+    uint32_t SimulationWidth = 128;
+    uint32_t SimulationHeight = 128;
+    bool DegradeQualityUnderLoad = true; // Fewer pressure iterations instead of dropping simulation time
+    bool AsyncSimulation = false;        // Step the simulation on its own thread; render interpolates snapshots
+    uint32_t WorkerThreads = 0;          // Job system workers besides the main thread; 0 for one per spare core
+    uint32_t MaxParticles = 1U << 18;    // Dye tracers; 0 disables them
+    bool PeriodicDomain = false;         // Wrap every edge and project spectrally instead of closed walls
+    bool ConjugateGradient = false;      // Closed domains: PCG pressure solve to a tolerance instead of Jacobi
+    std::string ObstaclePath;            // Non-empty: image whose opaque pixels become solid obstacles
+    bool HalfPrecisionDye = true;        // fp16 dye snapshots and display texture; the solver itself stays fp32
+
+    // Replay Settings
+    std::string RecordPath; // Non-empty: write every step's input to this file
+    std::string ReplayPath; // Non-empty: run headless from this recording as fast as possible
+
+    // Capture Settings
+    std::string CapturePath;   // Non-empty: save every frame; a .y4m path is one stream, anything else a PNG prefix
+    uint32_t CaptureWidth = 0; // 0 for the window size
+    uint32_t CaptureHeight = 0;
+
+    // Checkpoint Settings
+    std::string CheckpointPath;        // Non-empty: restore from this file at startup and save to it periodically
+    double CheckpointInterval = 300.0; // Simulated seconds between checkpoints
+    bool CompressCheckpoints = true;   // LZ4 per field block
+
+    // Monitoring Settings
+    std::string MetricsSocketPath; // Non-empty: serve Prometheus metrics on this Unix domain socket
+    uint16_t MetricsPort = 0;      // Non-zero: serve Prometheus metrics on 127.0.0.1 at this port
 
     // Debug Settings
     bool EnableGPUDebug = false;
+    std::string TracePath;      // Non-empty: record a Chrome trace, written on F9 and at exit
+    bool BenchmarkJobs = false; // Run the job system scaling benchmark instead of the app
+    bool SelfCheck = false;     // Run the headless behaviour checks instead of the app
 };
 } // namespace Core
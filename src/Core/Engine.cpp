@@ -2,16 +2,61 @@
 
 #include <SDL3/SDL.h>
 
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <span>
 #include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include "../Audio/AudioConfig.hpp"
+#include "../Audio/AudioDriver.hpp"
+#include "../Audio/AudioRingBuffer.hpp"
+#include "../Audio/BandReducer.hpp"
+#include "../Audio/SpectrumAnalyzer.hpp"
+#include "../Graphics/FrameCapture.hpp"
+#include "../Graphics/FrameWriter.hpp"
+#include "../Graphics/GPUBuffer.hpp"
 #include "../Graphics/GPUContext.hpp"
 #include "../Graphics/Renderer.hpp"
+#include "../Graphics/ShaderLibrary.hpp"
+#include "../Graphics/TextureRegistry.hpp"
+#include "../Graphics/UploadStream.hpp"
+#include "../Simulation/AudioForcing.hpp"
+#include "../Simulation/Checkpoint.hpp"
+#include "../Simulation/FieldPrecision.hpp"
+#include "../Simulation/FluidSolver.hpp"
+#include "../Simulation/ParticleSystem.hpp"
+#include "../Simulation/SimulationSnapshot.hpp"
+#include "AllocationCounter.hpp"
 #include "Clock.hpp"
 #include "Config.hpp"
+#include "FixedStepScheduler.hpp"
+#include "FrameArena.hpp"
+#include "JobSystem.hpp"
 #include "Logger.hpp"
+#include "Metrics.hpp"
+#include "MetricsServer.hpp"
+#include "Replay.hpp"
+#include "SnapshotBuffer.hpp"
+#include "StartupGraph.hpp"
+#include "StepInput.hpp"
+#include "Trace.hpp"
 #include "Window.hpp"
 
 namespace Core
@@ -19,15 +64,86 @@ namespace Core
 namespace
 {
 constexpr double kMaxFrameTime = 0.25;
+constexpr double kUpdateBudgetFraction = 0.75; // Share of a physics step the updates of one frame may use
+constexpr uint32_t kFramesInFlight = 3;
+constexpr size_t kFrameArenaBytes = 1024 * 1024;
+constexpr size_t kStepArenaBytes = 64 * 1024;
+constexpr uint64_t kAllocationWarmupFrames = 120; // Caches, swapchain and driver state settle before this
 constexpr double kMillisecondsPerSecond = 1000.0;
 constexpr double kNanosecondsPerSecond = 1.0e9;
+constexpr float kPercent = 100.0F;
+constexpr uint32_t kCaptureFrameRate = 60; // Clip frame rate when the render rate is uncapped
+constexpr double kAudioCheckInterval = 1.0; // Seconds between looks at the capture callback's health
+
+Simulation::FieldPrecisionPolicy GetPrecisionPolicy(const Config& config)
+{
+    return Simulation::FieldPrecisionPolicy{
+        .Dye = config.HalfPrecisionDye ? Simulation::FieldPrecision::Half : Simulation::FieldPrecision::Full};
+}
+
+// Resident set size from /proc/self/statm; 0 on other platforms.
+double GetResidentBytes()
+{
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    uint64_t sizePages = 0;
+    uint64_t residentPages = 0;
+    if (statm >> sizePages >> residentPages)
+    {
+        return static_cast<double>(residentPages) * static_cast<double>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0.0;
+}
 } // namespace
 
-SDLContext::SDLContext()
+// Everything the engine reports, registered once at startup so the hot paths only touch atomics.
+struct EngineMetrics
+{
+    Histogram& FrameSeconds;
+    Histogram& StepSeconds;
+    Histogram& AnalysisSeconds;
+    Histogram& PressureIterations;
+    Counter& DroppedSteps;
+    Counter& AudioOverruns;
+    Counter& SteadyStateAllocations;
+    Gauge& Quality;
+    Gauge& ActiveFraction;
+    Gauge& FrameArenaPeakBytes;
+
+    explicit EngineMetrics(MetricsRegistry& registry)
+        : FrameSeconds(registry.AddHistogram("af_frame_seconds",
+                                             "Wall time between the starts of consecutive rendered frames",
+                                             {0.004, 0.008, 0.0125, 0.0167, 0.025, 0.0333, 0.05, 0.1, 0.25})),
+          StepSeconds(registry.AddHistogram("af_step_seconds",
+                                            "Cost of one fixed simulation step",
+                                            {0.0005, 0.001, 0.002, 0.004, 0.008, 0.0167, 0.0333, 0.1})),
+          AnalysisSeconds(registry.AddHistogram("af_audio_analysis_seconds",
+                                                "Spectrum analysis and band reduction per step",
+                                                {0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005})),
+          PressureIterations(registry.AddHistogram("af_pressure_iterations",
+                                                   "Pressure solver iterations per step",
+                                                   {4, 8, 16, 24, 32, 40, 60, 80, 120, 200})),
+          DroppedSteps(registry.AddCounter("af_dropped_steps_total",
+                                           "Simulation steps discarded because frames fell too far behind")),
+          AudioOverruns(registry.AddCounter("af_audio_overruns_total",
+                                            "Times captured audio was overwritten before it could be analyzed")),
+          SteadyStateAllocations(registry.AddCounter("af_frame_allocations_total",
+                                                     "Heap allocations on the main thread after warm-up")),
+          Quality(registry.AddGauge("af_simulation_quality", "Quality the scheduler last stepped at, 0 to 1")),
+          ActiveFraction(registry.AddGauge("af_active_fraction", "Fraction of the grid the solver last updated")),
+          FrameArenaPeakBytes(registry.AddGauge("af_frame_arena_peak_bytes", "High-water mark of the frame arena"))
+    {
+        Gauge& resident = registry.AddGauge("af_resident_memory_bytes", "Resident set size of the process");
+        registry.AddCollector([&resident] { resident.Set(GetResidentBytes()); });
+    }
+};
+
+SDLContext::SDLContext(bool headless)
 {
     LOG_INFO("Engine: Initializing SDL...");
 
-    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO))
+    if (!SDL_Init(headless ? 0 : SDL_INIT_VIDEO | SDL_INIT_AUDIO))
     {
         throw std::runtime_error(SDL_GetError());
     }
@@ -39,69 +155,277 @@ SDLContext::~SDLContext()
     SDL_Quit();
 }
 
-Engine::Engine(const Config& config) : m_config(config), m_isRunning(true)
+Engine::Engine(const Config& config)
+    : m_sdlContext(!config.ReplayPath.empty()), m_config(config), m_isRunning(true)
 {
     LOG_INFO("Engine: Initializing Subsystems...");
 
-    m_window = std::make_unique<Window>(config.WindowTitle, config.WindowWidth, config.WindowHeight);
+    const uint32_t workerCount =
+        config.WorkerThreads > 0 ? config.WorkerThreads : JobSystem::GetDefaultWorkerCount();
+
+    Trace::NameThread("Main");
+    if (!config.TracePath.empty())
+    {
+        Trace::Start(config.TracePath, workerCount);
+    }
+
+    m_metricsRegistry = std::make_unique<MetricsRegistry>();
+    m_metrics = std::make_unique<EngineMetrics>(*m_metricsRegistry);
+
+    m_jobSystem = std::make_unique<JobSystem>(workerCount);
+
+    m_stepArena = std::make_unique<FrameArena>(kStepArenaBytes, 1);
+
+    // Independent subsystems start concurrently; the window and the GPU device stay on this thread.
+    StartupGraph startup(*m_jobSystem);
+
+    const StartupGraph::PhaseId simulation = startup.Add("Simulation", [this, &config] {
+        m_fluidSolver = std::make_unique<Simulation::FluidSolver>(
+            Simulation::FluidSettings{.Width = config.SimulationWidth,
+                                      .Height = config.SimulationHeight,
+                                      .Pressure = config.ConjugateGradient
+                                                      ? Simulation::PressureSolver::ConjugateGradient
+                                                      : Simulation::PressureSolver::Jacobi,
+                                      .Boundary = config.PeriodicDomain ? Simulation::DomainBoundary::Periodic
+                                                                        : Simulation::DomainBoundary::Closed},
+            m_jobSystem.get());
+        if (!config.ObstaclePath.empty())
+        {
+            m_fluidSolver->PaintObstacleImage(config.ObstaclePath);
+        }
+        m_audioForcing = std::make_unique<Simulation::AudioForcing>();
+        if (config.MaxParticles > 0)
+        {
+            const Simulation::ParticleSettings particleSettings{.Capacity = config.MaxParticles};
+            m_particles = std::make_unique<Simulation::ParticleSystem>(
+                config.SimulationWidth, config.SimulationHeight, particleSettings, m_jobSystem.get());
+        }
+    });
+
+    if (!config.ReplayPath.empty())
+    {
+        // Replay runs headless: no window, no GPU, no audio device. Every step is driven from the file.
+        startup.Run();
+        m_replayReader = std::make_unique<ReplayReader>(config.ReplayPath);
+        CheckReplayConfig(m_replayReader->GetHeader(), config);
+        if (m_replayReader->GetHeader().CheckpointHash != 0)
+        {
+            // Unlike a live start, a replay that cannot restore its checkpoint has nothing to reproduce.
+            Simulation::CheckpointReader reader(config.CheckpointPath);
+            reader.Restore(*m_fluidSolver, m_particles.get());
+            m_stepCount = reader.GetHeader().Step;
+        }
+        LOG_INFO("Engine: Initialized for replay!");
+        return;
+    }
+
+    if (!config.CheckpointPath.empty())
+    {
+        startup.Add(
+            "Checkpoint",
+            [this, &config] {
+                RestoreCheckpoint();
+                m_checkpointWriter = std::make_unique<Simulation::CheckpointWriter>(
+                    Simulation::CheckpointSettings{.Path = config.CheckpointPath,
+                                                   .Compress = config.CompressCheckpoints},
+                    *m_fluidSolver,
+                    m_particles.get());
+                m_checkpointSteps =
+                    std::max<uint64_t>(1, std::llround(config.CheckpointInterval / Config::kPhysicsTimeStep));
+            },
+            {simulation});
+    }
+
+    m_scheduler = std::make_unique<FixedStepScheduler>(
+        FixedStepSchedulerSettings{.TimeStep = Config::kPhysicsTimeStep,
+                                   .MaxFrameTime = kMaxFrameTime,
+                                   .UpdateBudget = Config::kPhysicsTimeStep * kUpdateBudgetFraction,
+                                   .DegradeQuality = config.DegradeQualityUnderLoad});
+    m_frameArena = std::make_unique<FrameArena>(kFrameArenaBytes, kFramesInFlight);
+
+    // Created without a device so HLSL compilation can overlap window and device creation.
+    m_shaderLibrary = std::make_unique<Graphics::ShaderLibrary>();
+
+    const std::array<Graphics::ShaderRequest, 4> shaders{
+        Graphics::ShaderRequest{
+            .Name = "Fullscreen", .Path = "shaders/Fullscreen.vert.hlsl", .Stage = Graphics::ShaderStage::Vertex},
+        Graphics::ShaderRequest{
+            .Name = "Display", .Path = "shaders/Display.frag.hlsl", .Stage = Graphics::ShaderStage::Fragment},
+        Graphics::ShaderRequest{
+            .Name = "Particles", .Path = "shaders/Particles.vert.hlsl", .Stage = Graphics::ShaderStage::Vertex},
+        Graphics::ShaderRequest{.Name = "ParticleColor",
+                                .Path = "shaders/Particles.frag.hlsl",
+                                .Stage = Graphics::ShaderStage::Fragment}};
+    std::vector<Graphics::ShaderLibrary::SpirvResult> compiledShaders;
+
+    const StartupGraph::PhaseId window = startup.Add(
+        "Window",
+        [this, &config] {
+            m_window = std::make_unique<Window>(config.WindowTitle, config.WindowWidth, config.WindowHeight);
+        },
+        {},
+        JobAffinity::MainThread);
+
+    const StartupGraph::PhaseId gpu = startup.Add(
+        "GPU",
+        [this, &config] {
+            const uint64_t uploadBytes = Graphics::Renderer::GetFrameUploadBytes(
+                config.SimulationWidth, config.SimulationHeight, config.MaxParticles);
+            m_gpuContext = std::make_unique<Graphics::GPUContext>(
+                m_window->GetNativeHandle(), config.EnableGPUDebug, uploadBytes);
+            m_gpuContext->SetVSync(config.VSync);
+            m_shaderLibrary->AttachContext(m_gpuContext.get());
+            m_textureRegistry = std::make_unique<Graphics::TextureRegistry>(m_gpuContext.get());
+            m_bandBuffer = std::make_unique<Graphics::GPUBuffer>(m_gpuContext->GetDevice(),
+                                                                 static_cast<uint32_t>(sizeof(Audio::BandArray)),
+                                                                 SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ,
+                                                                 "AudioBands");
+        },
+        {window},
+        JobAffinity::MainThread);
+
+    const StartupGraph::PhaseId shaderCompile = startup.Add("ShaderCompile", [this, &shaders, &compiledShaders] {
+        compiledShaders = Graphics::ShaderLibrary::Compile(shaders, *m_jobSystem);
+    });
+
+    startup.Add(
+        "Renderer",
+        [this, &config, &shaders, &compiledShaders] {
+            m_shaderLibrary->Preload(shaders, compiledShaders);
+
+            const Simulation::ParticleSettings particleSettings =
+                m_particles ? m_particles->GetSettings() : Simulation::ParticleSettings{.Capacity = 0};
+            m_renderer = std::make_unique<Graphics::Renderer>(m_gpuContext.get(),
+                                                              m_shaderLibrary.get(),
+                                                              m_textureRegistry.get(),
+                                                              m_frameArena.get(),
+                                                              config.SimulationWidth,
+                                                              config.SimulationHeight,
+                                                              GetPrecisionPolicy(config).Dye,
+                                                              particleSettings);
+
+            if (!config.CapturePath.empty())
+            {
+                // Even dimensions keep the 4:2:0 chroma planes of Y4M whole.
+                const uint32_t width = (config.CaptureWidth > 0 ? config.CaptureWidth : config.WindowWidth) & ~1U;
+                const uint32_t height = (config.CaptureHeight > 0 ? config.CaptureHeight : config.WindowHeight) & ~1U;
+                const bool stream = std::filesystem::path(config.CapturePath).extension() == ".y4m";
+
+                m_frameCapture = std::make_unique<Graphics::FrameCapture>(
+                    m_gpuContext.get(),
+                    Graphics::FrameCaptureSettings{
+                        .Writer = {.Path = config.CapturePath,
+                                   .Format = stream ? Graphics::CaptureFormat::Y4M
+                                                    : Graphics::CaptureFormat::PngSequence,
+                                   .Width = width,
+                                   .Height = height,
+                                   .FrameRate =
+                                       config.TargetRenderFPS > 0 ? config.TargetRenderFPS : kCaptureFrameRate}});
+            }
+        },
+        {gpu, shaderCompile, simulation},
+        JobAffinity::MainThread);
+
+    startup.Add("Audio", [this] {
+        m_audioRingBuffer = std::make_unique<Audio::AudioRingBuffer>();
+
+        try
+        {
+            m_audioDriver = std::make_unique<Audio::AudioDriver>(*m_audioRingBuffer, *m_metricsRegistry);
+        }
+        catch (const std::runtime_error& e)
+        {
+            LOG_WARN("Engine: Audio unavailable ({}), continuing without input", e.what());
+        }
+
+        m_spectrumAnalyzer = std::make_unique<Audio::SpectrumAnalyzer>(*m_audioRingBuffer);
+        m_bandReducer = std::make_unique<Audio::BandReducer>(
+            Audio::BandReducerSettings{}, Audio::Config::kSampleRate, Audio::Config::kFFTSize);
+    });
+
+    startup.Run();
 
-    m_gpuContext = std::make_unique<Graphics::GPUContext>(m_window->GetNativeHandle(), config.EnableGPUDebug);
-    m_gpuContext->SetVSync(config.VSync);
+    m_snapshots = std::make_unique<SnapshotQueue>();
 
-    m_renderer = std::make_unique<Graphics::Renderer>(m_gpuContext.get());
+    if (!config.RecordPath.empty())
+    {
+        m_replayWriter =
+            std::make_unique<ReplayWriter>(config.RecordPath, MakeReplayHeader(config, m_resumedCheckpointHash));
+    }
+
+    PublishSnapshot();
+
+    if (!config.MetricsSocketPath.empty() || config.MetricsPort != 0)
+    {
+        // Monitoring is not worth refusing to start over, e.g. when the port is taken.
+        try
+        {
+            m_metricsServer = std::make_unique<MetricsServer>(
+                *m_metricsRegistry,
+                MetricsServerSettings{.SocketPath = config.MetricsSocketPath, .Port = config.MetricsPort});
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARN("Engine: Metrics unavailable ({}), continuing without them", e.what());
+        }
+    }
 
-    LOG_INFO("Engine: Initialized subsystems!");
+    LOG_INFO("Engine: Initialized subsystems{}!", config.AsyncSimulation ? " (async simulation)" : "");
 }
 
-Engine::~Engine() = default;
+Engine::~Engine()
+{
+    Trace::Stop();
+}
 
 void Engine::Run()
 {
-    const Clock clock;
-    double accumulator = 0.0;
-    double currentTime = clock.GetTotalSeconds();
+    if (m_replayReader)
+    {
+        RunReplay();
+        return;
+    }
+
+    std::jthread simulationThread;
+    if (m_config.AsyncSimulation)
+    {
+        simulationThread = std::jthread([this](const std::stop_token& stopToken) { RunSimulationThread(stopToken); });
+    }
 
-    const double maxFrameTime = kMaxFrameTime;
+    double currentTime = m_clock.GetTotalSeconds();
 
     while (m_isRunning)
     {
-        const double newTime = clock.GetTotalSeconds();
-        double frameTime = newTime - currentTime;
+        const double newTime = m_clock.GetTotalSeconds();
+        const double frameTime = newTime - currentTime;
         currentTime = newTime;
+        const uint64_t allocationsBefore = AllocationCounter::GetThreadCount();
+        TRACE_SCOPE("Frame", "frame");
+        m_metrics->FrameSeconds.Observe(frameTime);
 
-        frameTime = std::min(frameTime, maxFrameTime);
+        PumpEvents();
+        m_jobSystem->RunMainThreadJobs();
 
-        accumulator += frameTime;
-
-        SDL_Event event;
-        while (SDL_PollEvent(&event))
+        if (!m_config.AsyncSimulation)
         {
-            switch (event.type)
-            {
-                case SDL_EVENT_QUIT:
-                    m_isRunning = false;
-                    break;
-                case SDL_EVENT_WINDOW_RESIZED:
-                    m_window->OnResize(event.window.data1, event.window.data2);
-                    break;
-                default:
-                    break;
-            }
-        }
+            const uint32_t steps = RunSteps(frameTime);
 
-        while (accumulator >= Config::kPhysicsTimeStep)
-        {
-            Update(Config::kPhysicsTimeStep);
-            accumulator -= Config::kPhysicsTimeStep;
+            LOG_HOT_DEBUG("Frame {:.3f} ms: {} steps, alpha {:.3f}, {:.1f}% of the grid active",
+                          frameTime * kMillisecondsPerSecond,
+                          steps,
+                          m_scheduler->GetAlpha(),
+                          m_fluidSolver->GetActiveFraction() * kPercent);
         }
 
-        const double alpha = accumulator / Config::kPhysicsTimeStep;
-        Render(alpha);
+        Render();
+        CheckFrameAllocations(allocationsBefore);
+        CheckAudioHealth();
+        m_metrics->FrameArenaPeakBytes.Set(static_cast<double>(m_frameArena->GetHighWaterMark()));
 
         if (!m_config.VSync && m_config.TargetRenderFPS > 0)
         {
             const double targetDuration = 1.0 / static_cast<double>(m_config.TargetRenderFPS);
-            const double elapsed = clock.GetTotalSeconds() - newTime;
+            const double elapsed = m_clock.GetTotalSeconds() - newTime;
 
             if (elapsed < targetDuration)
             {
@@ -110,19 +434,382 @@ void Engine::Run()
             }
         }
     }
+
+    if (simulationThread.joinable())
+    {
+        simulationThread.request_stop();
+        simulationThread.join();
+    }
+
+    if (m_checkpointWriter)
+    {
+        // Waits out any periodic write first so the final state is never the one that gets skipped.
+        m_checkpointWriter->Flush();
+        m_checkpointWriter->Submit(m_stepCount, *m_fluidSolver, m_particles.get());
+        m_checkpointWriter->Flush();
+    }
+
+    const FixedStepSchedulerStats& stats = m_scheduler->GetStats();
+    LOG_INFO("Engine: {} steps ({} degraded, {} deferred, {} dropped), avg step {:.3f} ms",
+             stats.Steps,
+             stats.DegradedSteps,
+             stats.DeferredSteps,
+             stats.DroppedSteps,
+             stats.AverageStepCost * kMillisecondsPerSecond);
+
+    LOG_INFO("Engine: Arena peaks {} KiB/frame, {} KiB/step ({} heap fallbacks)",
+             m_frameArena->GetHighWaterMark() / 1024,
+             m_stepArena->GetHighWaterMark() / 1024,
+             m_frameArena->GetOverflowCount() + m_stepArena->GetOverflowCount());
+
+    if (m_steadyStateAllocations > 0)
+    {
+        LOG_WARN("Engine: {} heap allocations in the frame loop after warm-up", m_steadyStateAllocations);
+    }
+
+    if (m_audioDriver)
+    {
+        const Audio::AudioCallbackStats audio = m_audioDriver->GetCallbackStats();
+        LOG_INFO("Engine: Audio {} callbacks, {} frames, {} gaps, {} interruptions, worst callback {:.3f} ms, "
+                 "worst jitter {:.3f} ms",
+                 audio.Callbacks,
+                 audio.Frames,
+                 audio.Gaps,
+                 audio.Interruptions,
+                 audio.MaxCallbackSeconds * kMillisecondsPerSecond,
+                 audio.MaxJitterSeconds * kMillisecondsPerSecond);
+    }
+
+    ReportPrecision();
+}
+
+void Engine::RunSimulationThread(const std::stop_token& stopToken)
+{
+    LOG_INFO("Engine: Simulation thread started");
+    Trace::NameThread("Simulation");
+
+    try
+    {
+        double currentTime = m_clock.GetTotalSeconds();
+
+        while (!stopToken.stop_requested())
+        {
+            const double newTime = m_clock.GetTotalSeconds();
+            RunSteps(newTime - currentTime);
+            currentTime = newTime;
+
+            // Sleep until the next step falls due instead of spinning against the render thread.
+            const double untilNextStep = (1.0 - m_scheduler->GetAlpha()) * Config::kPhysicsTimeStep;
+            if (untilNextStep > 0.0)
+            {
+                SDL_DelayNS(static_cast<uint64_t>(untilNextStep * kNanosecondsPerSecond));
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LOG_CRITICAL("Engine: Simulation thread failed: {}", e.what());
+        m_isRunning = false;
+    }
+
+    LOG_INFO("Engine: Simulation thread stopped");
+}
+
+void Engine::RunReplay()
+{
+    const double timeStep = m_replayReader->GetHeader().TimeStep;
+    const Clock clock;
+
+    while (m_isRunning)
+    {
+        Update(timeStep);
+    }
+
+    const double elapsed = clock.GetTotalSeconds();
+    const uint64_t steps = m_replayReader->GetStepsRead();
+
+    LOG_INFO("Engine: Replayed {} steps in {:.3f} ms ({:.3f} ms/step)",
+             steps,
+             elapsed * kMillisecondsPerSecond,
+             steps > 0 ? elapsed * kMillisecondsPerSecond / static_cast<double>(steps) : 0.0);
+
+    ReportPrecision();
+}
+
+uint32_t Engine::RunSteps(double elapsed)
+{
+    const uint64_t droppedBefore = m_scheduler->GetStats().DroppedSteps;
+    const uint32_t steps = m_scheduler->BeginFrame(elapsed);
+    m_metrics->DroppedSteps.Add(m_scheduler->GetStats().DroppedSteps - droppedBefore);
+
+    for (uint32_t i = 0; i < steps; ++i)
+    {
+        const double stepStart = m_clock.GetTotalSeconds();
+        Update(Config::kPhysicsTimeStep);
+        const double stepCost = m_clock.GetTotalSeconds() - stepStart;
+        m_scheduler->RecordStepCost(stepCost);
+        m_metrics->StepSeconds.Observe(stepCost);
+    }
+    return steps;
+}
+
+void Engine::RestoreCheckpoint()
+{
+    if (!std::filesystem::exists(m_config.CheckpointPath))
+    {
+        LOG_INFO("Engine: No checkpoint at '{}', starting fresh", m_config.CheckpointPath);
+        return;
+    }
+
+    // A stale or foreign checkpoint should not keep the installation from starting, so failures only warn.
+    try
+    {
+        Simulation::CheckpointReader reader(m_config.CheckpointPath);
+        reader.Restore(*m_fluidSolver, m_particles.get());
+        m_stepCount = reader.GetHeader().Step;
+        LOG_INFO("Engine: Resumed from step {}", m_stepCount);
+
+        if (!m_config.RecordPath.empty())
+        {
+            m_resumedCheckpointHash = HashFileContents(m_config.CheckpointPath);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LOG_WARN("Engine: Ignoring checkpoint '{}' ({})", m_config.CheckpointPath, e.what());
+    }
+}
+
+void Engine::PumpEvents()
+{
+    TRACE_SCOPE("PumpEvents", "frame");
+    SDL_Event event;
+    while (SDL_PollEvent(&event))
+    {
+        switch (event.type)
+        {
+            case SDL_EVENT_QUIT:
+                m_isRunning = false;
+                break;
+            case SDL_EVENT_KEY_DOWN:
+                if (event.key.key == SDLK_F9 && !event.key.repeat)
+                {
+                    Trace::Dump();
+                }
+                break;
+            case SDL_EVENT_WINDOW_RESIZED:
+            {
+                m_window->OnResize(event.window.data1, event.window.data2);
+
+                const std::scoped_lock lock(m_eventMutex);
+                m_pendingEvents.push_back(InputEvent{.Type = InputEventType::Resize,
+                                                     .X = static_cast<float>(event.window.data1),
+                                                     .Y = static_cast<float>(event.window.data2)});
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+void Engine::CheckFrameAllocations(uint64_t allocationsBefore)
+{
+    if constexpr (!AllocationCounter::kEnabled)
+    {
+        return;
+    }
+
+    const uint64_t allocations = AllocationCounter::GetThreadCount() - allocationsBefore;
+    if (++m_frameCount <= kAllocationWarmupFrames || allocations == 0)
+    {
+        return;
+    }
+
+    if (m_steadyStateAllocations == 0)
+    {
+        LOG_WARN("Engine: Frame {} made {} heap allocations on the main thread", m_frameCount, allocations);
+    }
+    m_steadyStateAllocations += allocations;
+    m_metrics->SteadyStateAllocations.Add(allocations);
+}
+
+void Engine::CheckAudioHealth()
+{
+    const double now = m_clock.GetTotalSeconds();
+    if (!m_audioDriver || now < m_nextAudioCheck)
+    {
+        return;
+    }
+    m_nextAudioCheck = now + kAudioCheckInterval;
+
+    const Audio::AudioCallbackStats stats = m_audioDriver->GetCallbackStats();
+    if (stats.Gaps > m_reportedAudioGaps || stats.Interruptions > m_reportedAudioInterruptions)
+    {
+        LOG_WARN("Engine: Audio capture dropped out {} times and was interrupted {} times since the last check "
+                 "(worst callback {:.3f} ms, worst jitter {:.3f} ms)",
+                 stats.Gaps - m_reportedAudioGaps,
+                 stats.Interruptions - m_reportedAudioInterruptions,
+                 stats.MaxCallbackSeconds * kMillisecondsPerSecond,
+                 stats.MaxJitterSeconds * kMillisecondsPerSecond);
+    }
+    m_reportedAudioGaps = stats.Gaps;
+    m_reportedAudioInterruptions = stats.Interruptions;
+}
+
+void Engine::CaptureStepInput(double dt)
+{
+    const double analysisStart = m_clock.GetTotalSeconds();
+    const uint64_t overrunsBefore = m_spectrumAnalyzer->GetOverrunCount();
+    m_spectrumAnalyzer->Process();
+    m_bandReducer->Process(m_spectrumAnalyzer->GetMagnitudes(), static_cast<float>(dt));
+    m_metrics->AudioOverruns.Add(m_spectrumAnalyzer->GetOverrunCount() - overrunsBefore);
+    m_metrics->AnalysisSeconds.Observe(m_clock.GetTotalSeconds() - analysisStart);
+
+    m_stepInput.Bands = m_bandReducer->GetBands();
+    m_stepInput.Quality = m_scheduler->GetQuality();
+
+    // Events gathered since the last step are attributed to the first step that follows them.
+    m_stepInput.Events.clear();
+
+    const std::scoped_lock lock(m_eventMutex);
+    std::swap(m_stepInput.Events, m_pendingEvents);
 }
 
 void Engine::Update(double dt)
 {
-    (void)dt;
+    TRACE_SCOPE("Step", "simulation");
+    if (m_replayReader)
+    {
+        if (!m_replayReader->Read(m_stepInput))
+        {
+            m_isRunning = false;
+            return;
+        }
+    }
+    else
+    {
+        CaptureStepInput(dt);
+
+        if (m_replayWriter)
+        {
+            m_replayWriter->Write(m_stepInput);
+        }
+    }
+
+    m_stepArena->BeginFrame();
+    std::pmr::vector<Simulation::Splat> splats(m_stepArena.get());
+
+    m_audioForcing->Emit(m_stepInput.Bands, splats);
+    const Audio::BandArray confinement = m_audioForcing->ComputeConfinement(m_stepInput.Bands);
+    m_fluidSolver->Step(static_cast<float>(dt), splats, m_stepInput.Quality, confinement);
+    if (m_particles)
+    {
+        m_particles->Step(static_cast<float>(dt),
+                          m_stepInput.Bands,
+                          m_fluidSolver->GetVelocityX(),
+                          m_fluidSolver->GetVelocityY());
+    }
+    ++m_stepCount;
+
+    m_metrics->PressureIterations.Observe(m_fluidSolver->GetLastPressureIterations());
+    m_metrics->Quality.Set(m_stepInput.Quality);
+    m_metrics->ActiveFraction.Set(m_fluidSolver->GetActiveFraction());
+
+    if (m_checkpointWriter && m_stepCount % m_checkpointSteps == 0)
+    {
+        m_checkpointWriter->Submit(m_stepCount, *m_fluidSolver, m_particles.get());
+    }
+
+    LOG_HOT_TRACE("Step {}: {} splats, quality {:.2f}, {} pressure iterations (residual {:.2e}), active {:.3f}",
+                  m_stepCount,
+                  splats.size(),
+                  m_stepInput.Quality,
+                  m_fluidSolver->GetLastPressureIterations(),
+                  m_fluidSolver->GetLastPressureResidual(),
+                  m_fluidSolver->GetActiveFraction());
+
+    if (m_snapshots)
+    {
+        PublishSnapshot();
+    }
+}
+
+void Engine::PublishSnapshot()
+{
+    Simulation::SimulationSnapshot& snapshot = m_snapshots->BeginWrite();
+    snapshot.Step = m_stepCount;
+    snapshot.PublishTime = m_clock.GetTotalSeconds();
+    snapshot.Dye.Assign(m_fluidSolver->GetDye(), GetPrecisionPolicy(m_config).Dye);
+    if (m_particles)
+    {
+        snapshot.Particles = m_particles->GetParticles(); // Reuses the slot's capacity once warmed up
+    }
+    snapshot.Bands = m_stepInput.Bands;
+    m_snapshots->EndWrite();
 }
 
-void Engine::Render(double alpha)
+void Engine::ReportPrecision() const
 {
+    const Simulation::FieldPrecision precision = GetPrecisionPolicy(m_config).Dye;
+    if (precision == Simulation::FieldPrecision::Full)
+    {
+        return;
+    }
+
+    Simulation::PackedField2D packed;
+    packed.Assign(m_fluidSolver->GetDye(), precision);
+    const Simulation::PrecisionReport report = Simulation::MeasurePrecision(m_fluidSolver->GetDye(), packed);
+    LOG_INFO("Engine: fp16 dye error max {:.3e} ({:.3f}% relative), rms {:.3e}, field peak {:.3f}",
+             report.MaxAbsoluteError,
+             report.MaxRelativeError * kPercent,
+             report.RmsError,
+             report.Peak);
+}
+
+void Engine::Render()
+{
+    TRACE_SCOPE("Render", "frame");
+    m_frameArena->BeginFrame();
+    const SnapshotQueue::View view = m_snapshots->Acquire();
+
     m_gpuContext->BeginFrame();
+    if (m_frameCapture)
+    {
+        m_frameCapture->Poll();
+    }
 
-    m_renderer->Draw(alpha);
+    bool captured = false;
+    if (view.Latest)
+    {
+        // Async: render one step behind and blend towards the newest snapshot as wall time advances.
+        const double alpha =
+            m_config.AsyncSimulation
+                ? std::clamp((m_clock.GetTotalSeconds() - view.Latest->PublishTime) / Config::kPhysicsTimeStep,
+                             0.0,
+                             1.0)
+                : m_scheduler->GetAlpha();
+
+        m_gpuContext->GetUploadStream().StageBuffer(m_bandBuffer->GetHandle(),
+                                                    std::span<const float>(view.Latest->Bands));
+        m_renderer->Draw(
+            *view.Previous, *view.Latest, alpha, m_frameCapture ? m_frameCapture->GetTarget() : nullptr);
 
-    m_gpuContext->EndFrame();
+        if (m_frameCapture && m_gpuContext->GetCurrentCommandBuffer())
+        {
+            captured = m_frameCapture->Record(m_gpuContext->GetCurrentCommandBuffer(),
+                                              m_gpuContext->GetSwapchainTexture(),
+                                              m_gpuContext->GetSwapchainWidth(),
+                                              m_gpuContext->GetSwapchainHeight());
+        }
+    }
+
+    m_snapshots->Release();
+
+    SDL_GPUFence* fence = m_gpuContext->EndFrame(captured);
+    if (captured)
+    {
+        m_frameCapture->Submitted(fence);
+    }
 }
 } // namespace Core
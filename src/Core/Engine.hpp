@@ -1,22 +1,60 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <stop_token>
+#include <vector>
 
+#include "Clock.hpp"
 #include "Config.hpp"
+#include "SnapshotBuffer.hpp"
+#include "StepInput.hpp"
+
+namespace Audio
+{
+class AudioRingBuffer;
+class AudioDriver;
+class SpectrumAnalyzer;
+class BandReducer;
+} // namespace Audio
+
+namespace Simulation
+{
+class FluidSolver;
+class AudioForcing;
+class ParticleSystem;
+class CheckpointWriter;
+struct Splat;
+struct SimulationSnapshot;
+} // namespace Simulation
 
 namespace Graphics
 {
+class FrameCapture;
+class GPUBuffer;
 class GPUContext;
 class Renderer;
+class ShaderLibrary;
+class TextureRegistry;
 } // namespace Graphics
 
 namespace Core
 {
 class Window;
+class FrameArena;
+class JobSystem;
+class FixedStepScheduler;
+class ReplayWriter;
+class ReplayReader;
+class MetricsRegistry;
+class MetricsServer;
+struct EngineMetrics;
 
 struct SDLContext
 {
-    SDLContext();
+    explicit SDLContext(bool headless);
     ~SDLContext();
 
     SDLContext(const SDLContext&) = delete;
@@ -39,15 +77,72 @@ class Engine
     void Run();
 
 private:
+    void RunReplay();
+    void RunSimulationThread(const std::stop_token& stopToken);
+    uint32_t RunSteps(double elapsed);
+
+    void PumpEvents();
     void Update(double dt);
-    void Render(double alpha);
+    void Render();
+
+    void RestoreCheckpoint();
+    void CheckFrameAllocations(uint64_t allocationsBefore);
+    void CheckAudioHealth();
+    void CaptureStepInput(double dt);
+    void PublishSnapshot();
+    void ReportPrecision() const;
+
+    using SnapshotQueue = SnapshotBuffer<Simulation::SimulationSnapshot>;
 
     SDLContext m_sdlContext;
     Config m_config;
-    bool m_isRunning = false;
+    Clock m_clock;
+    std::atomic<bool> m_isRunning = false;
+
+    std::unique_ptr<MetricsRegistry> m_metricsRegistry;
+    std::unique_ptr<EngineMetrics> m_metrics;
+    std::unique_ptr<MetricsServer> m_metricsServer;
+
+    std::unique_ptr<JobSystem> m_jobSystem;
+    std::unique_ptr<FrameArena> m_frameArena; // Render thread, one slot per frame in flight
+    std::unique_ptr<FrameArena> m_stepArena;  // Whichever thread steps the simulation, reset every step
 
     std::unique_ptr<Window> m_window;
     std::unique_ptr<Graphics::GPUContext> m_gpuContext;
+    std::unique_ptr<Graphics::ShaderLibrary> m_shaderLibrary;
+    std::unique_ptr<Graphics::TextureRegistry> m_textureRegistry;
     std::unique_ptr<Graphics::Renderer> m_renderer;
+    std::unique_ptr<Graphics::FrameCapture> m_frameCapture;
+    std::unique_ptr<Graphics::GPUBuffer> m_bandBuffer;
+
+    std::unique_ptr<Audio::AudioRingBuffer> m_audioRingBuffer;
+    std::unique_ptr<Audio::AudioDriver> m_audioDriver;
+    std::unique_ptr<Audio::SpectrumAnalyzer> m_spectrumAnalyzer;
+    std::unique_ptr<Audio::BandReducer> m_bandReducer;
+
+    std::unique_ptr<Simulation::FluidSolver> m_fluidSolver;
+    std::unique_ptr<Simulation::AudioForcing> m_audioForcing;
+    std::unique_ptr<Simulation::ParticleSystem> m_particles;
+
+    std::unique_ptr<FixedStepScheduler> m_scheduler;
+    std::unique_ptr<ReplayWriter> m_replayWriter;
+    std::unique_ptr<ReplayReader> m_replayReader;
+    std::unique_ptr<Simulation::CheckpointWriter> m_checkpointWriter;
+    uint64_t m_checkpointSteps = 0;
+    uint64_t m_resumedCheckpointHash = 0; // Recorded into the replay header when recording
+
+    std::unique_ptr<SnapshotQueue> m_snapshots;
+    uint64_t m_stepCount = 0;
+
+    uint64_t m_frameCount = 0;
+    uint64_t m_steadyStateAllocations = 0;
+
+    double m_nextAudioCheck = 0.0;
+    uint64_t m_reportedAudioGaps = 0;
+    uint64_t m_reportedAudioInterruptions = 0;
+
+    StepInput m_stepInput;
+    std::mutex m_eventMutex;
+    std::vector<InputEvent> m_pendingEvents;
 };
 } // namespace Core
@@ -0,0 +1,121 @@
+#include "FixedStepScheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "Logger.hpp"
+
+namespace Core
+{
+namespace
+{
+constexpr double kCostSmoothing = 0.1;
+constexpr float kQualityBackoff = 0.75F;
+constexpr double kMillisecondsPerSecond = 1000.0;
+} // namespace
+
+FixedStepScheduler::FixedStepScheduler(const FixedStepSchedulerSettings& settings) : m_settings(settings) {}
+
+uint32_t FixedStepScheduler::BeginFrame(double frameTime)
+{
+    const double timeStep = m_settings.TimeStep;
+
+    if (frameTime > m_settings.MaxFrameTime)
+    {
+        m_stats.DroppedSteps += static_cast<uint64_t>((frameTime - m_settings.MaxFrameTime) / timeStep);
+        frameTime = m_settings.MaxFrameTime;
+    }
+
+    m_accumulator += frameTime;
+
+    const auto due = static_cast<uint32_t>(m_accumulator / timeStep);
+    const uint32_t affordable = GetAffordableSteps();
+    const uint32_t steps = std::min(due, affordable);
+
+    if (due > affordable)
+    {
+        const uint32_t excess = due - affordable;
+
+        if (m_settings.DegradeQuality && m_quality > m_settings.MinQuality)
+        {
+            // Cheaper steps next frame; keep the backlog (bounded by one capped frame) so no time is lost.
+            m_quality = std::max(m_quality * kQualityBackoff, m_settings.MinQuality);
+
+            const double maxBacklog = static_cast<double>(m_settings.MaxSubsteps) * timeStep;
+            double backlog = m_accumulator - (static_cast<double>(steps) * timeStep);
+            if (backlog > maxBacklog)
+            {
+                m_stats.DroppedSteps += static_cast<uint64_t>((backlog - maxBacklog) / timeStep);
+                m_accumulator = maxBacklog + (static_cast<double>(steps) * timeStep);
+                backlog = maxBacklog;
+            }
+
+            // The oldest steps run first, so any of last frame's carried steps not run now are already counted.
+            const auto carried = static_cast<uint32_t>(backlog / timeStep);
+            const uint32_t stillCarried = m_carriedSteps > steps ? m_carriedSteps - steps : 0;
+            m_stats.DeferredSteps += carried > stillCarried ? carried - stillCarried : 0;
+        }
+        else
+        {
+            m_stats.DroppedSteps += excess;
+            m_accumulator -= static_cast<double>(excess) * timeStep;
+            LOG_DEBUG("FixedStepScheduler: Dropped {} steps (avg step {:.3f} ms)",
+                      excess,
+                      m_stats.AverageStepCost * kMillisecondsPerSecond);
+        }
+    }
+    else if (m_quality < 1.0F && due * 2 <= affordable)
+    {
+        m_quality = std::min(m_quality + m_settings.QualityRecovery, 1.0F);
+    }
+
+    m_accumulator -= static_cast<double>(steps) * timeStep;
+    m_carriedSteps = static_cast<uint32_t>(m_accumulator / timeStep);
+    m_stats.Steps += steps;
+    m_stats.LastSubsteps = steps;
+
+    if (m_quality < 1.0F)
+    {
+        m_stats.DegradedSteps += steps;
+    }
+
+    return steps;
+}
+
+void FixedStepScheduler::RecordStepCost(double seconds)
+{
+    if (m_stats.AverageStepCost <= 0.0)
+    {
+        m_stats.AverageStepCost = seconds;
+        return;
+    }
+    m_stats.AverageStepCost += kCostSmoothing * (seconds - m_stats.AverageStepCost);
+}
+
+uint32_t FixedStepScheduler::GetAffordableSteps() const
+{
+    if (m_stats.AverageStepCost <= 0.0)
+    {
+        return m_settings.MaxSubsteps;
+    }
+
+    const auto affordable = static_cast<uint32_t>(m_settings.UpdateBudget / m_stats.AverageStepCost);
+    return std::clamp(affordable, 1U, m_settings.MaxSubsteps);
+}
+
+double FixedStepScheduler::GetAlpha() const
+{
+    return std::clamp(m_accumulator / m_settings.TimeStep, 0.0, 1.0);
+}
+
+float FixedStepScheduler::GetQuality() const
+{
+    return m_quality;
+}
+
+const FixedStepSchedulerStats& FixedStepScheduler::GetStats() const
+{
+    return m_stats;
+}
+} // namespace Core
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Core
+{
+struct FixedStepSchedulerSettings
+{
+    double TimeStep = 1.0 / 60.0;
+    double MaxFrameTime = 0.25;   // Longer frames (breakpoints, window drags) are dropped outright
+    double UpdateBudget = 0.012;  // Wall time per frame the simulation may consume
+    uint32_t MaxSubsteps = 4;     // Hard cap regardless of measured cost
+    bool DegradeQuality = true;   // Lower solver quality and defer backlog instead of dropping it
+    float MinQuality = 0.25F;
+    float QualityRecovery = 0.05F; // Quality regained per frame once the budget has headroom
+};
+
+struct FixedStepSchedulerStats
+{
+    uint64_t Steps = 0;
+    uint64_t DroppedSteps = 0;  // Simulation time discarded, in whole steps
+    uint64_t DeferredSteps = 0; // Steps carried into a later frame, counted once however long they wait
+    uint64_t DegradedSteps = 0; // Steps run below full quality
+    uint32_t LastSubsteps = 0;
+    double AverageStepCost = 0.0;
+};
+
+// Fixed-step accumulator with a time budget. The number of substeps per frame is capped by the measured
+// cost of a step so a slow step cannot snowball into ever longer frames. Steps are never merged into one longer
+// step, as replays and the solver's stability both rely on every step being TimeStep long: time over the budget
+// is either deferred, at lower quality, or dropped.
+class FixedStepScheduler
+{
+public:
+    explicit FixedStepScheduler(const FixedStepSchedulerSettings& settings);
+
+    // Adds the frame's elapsed time and returns how many steps to run this frame.
+    [[nodiscard]] uint32_t BeginFrame(double frameTime);
+    void RecordStepCost(double seconds);
+
+    [[nodiscard]] double GetAlpha() const;
+    [[nodiscard]] float GetQuality() const;
+    [[nodiscard]] const FixedStepSchedulerStats& GetStats() const;
+
+private:
+    [[nodiscard]] uint32_t GetAffordableSteps() const;
+
+    FixedStepSchedulerSettings m_settings;
+    FixedStepSchedulerStats m_stats;
+    double m_accumulator = 0.0;
+    uint32_t m_carriedSteps = 0; // Whole steps left in the accumulator by the last frame, already counted as deferred
+    float m_quality = 1.0F;
+};
+} // namespace Core
@@ -0,0 +1,130 @@
+#include "FrameArena.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+
+#include "Logger.hpp"
+
+namespace Core
+{
+namespace
+{
+constexpr size_t kOverflowHeaderAlignment = alignof(std::max_align_t);
+} // namespace
+
+FrameArena::FrameArena(size_t bytesPerFrame, uint32_t frameCount)
+    : m_capacity(bytesPerFrame), m_upstream(std::pmr::new_delete_resource())
+{
+    if (frameCount == 0)
+    {
+        LOG_ERROR("FrameArena: Frame count must be at least 1");
+        throw std::invalid_argument("FrameArena: Invalid Frame Count");
+    }
+
+    m_slots.resize(frameCount);
+    for (Slot& slot : m_slots)
+    {
+        slot.Memory = std::make_unique_for_overwrite<std::byte[]>(bytesPerFrame); // NOLINT
+    }
+
+    LOG_INFO("FrameArena: {} x {} KiB", frameCount, bytesPerFrame / 1024);
+}
+
+FrameArena::~FrameArena()
+{
+    for (Slot& slot : m_slots)
+    {
+        ReleaseOverflow(slot);
+    }
+}
+
+void FrameArena::BeginFrame()
+{
+    m_current = (m_current + 1) % static_cast<uint32_t>(m_slots.size());
+
+    Slot& slot = m_slots[m_current];
+    ReleaseOverflow(slot);
+    slot.Offset = 0;
+    slot.Requested = 0;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment)
+{
+    Slot& slot = m_slots[m_current];
+
+    slot.Requested += bytes;
+    m_highWaterMark = std::max(m_highWaterMark, slot.Requested);
+
+    const auto base = reinterpret_cast<uintptr_t>(slot.Memory.get()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const uintptr_t aligned = (base + slot.Offset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    const size_t offset = aligned - base;
+
+    if (offset + bytes > m_capacity)
+    {
+        return AllocateOverflow(slot, bytes, alignment);
+    }
+
+    slot.Offset = offset + bytes;
+    return slot.Memory.get() + offset;
+}
+
+void FrameArena::do_deallocate(void* /*ptr*/, size_t /*bytes*/, size_t /*alignment*/) {}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void* FrameArena::AllocateOverflow(Slot& slot, size_t bytes, size_t alignment)
+{
+    if (m_overflowCount++ == 0)
+    {
+        LOG_WARN("FrameArena: Frame exceeded {} KiB, falling back to the heap", m_capacity / 1024);
+    }
+
+    // Header first, padded so the payload keeps the requested alignment.
+    const size_t headerBytes = (sizeof(OverflowBlock) + alignment - 1) & ~(alignment - 1);
+    const size_t blockAlignment = std::max(alignment, kOverflowHeaderAlignment);
+    const size_t blockBytes = headerBytes + bytes;
+
+    auto* block = static_cast<std::byte*>(m_upstream->allocate(blockBytes, blockAlignment));
+    auto* header = new (block) OverflowBlock{.Next = slot.Overflow, .Bytes = blockBytes, .Alignment = blockAlignment};
+    slot.Overflow = header;
+
+    return block + headerBytes;
+}
+
+void FrameArena::ReleaseOverflow(Slot& slot)
+{
+    while (slot.Overflow)
+    {
+        OverflowBlock* block = slot.Overflow;
+        slot.Overflow = block->Next;
+        m_upstream->deallocate(block, block->Bytes, block->Alignment);
+    }
+}
+
+size_t FrameArena::GetCapacity() const
+{
+    return m_capacity;
+}
+
+size_t FrameArena::GetUsed() const
+{
+    return m_slots[m_current].Requested;
+}
+
+size_t FrameArena::GetHighWaterMark() const
+{
+    return m_highWaterMark;
+}
+
+uint64_t FrameArena::GetOverflowCount() const
+{
+    return m_overflowCount;
+}
+} // namespace Core
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace Core
+{
+// Bump allocator for data that lives at most one frame. Each of `frameCount` slots owns a fixed block;
+// BeginFrame() moves to the next slot and rewinds it, so memory handed out in a frame stays valid while
+// up to frameCount - 1 later frames are recorded. Deallocation is a no-op.
+//
+// Derives from std::pmr::memory_resource so transient containers can be std::pmr::vector<T>(&arena).
+// Requests that do not fit fall back to the upstream resource and are released when the slot comes round
+// again; the high-water mark shows how large the blocks need to be to avoid that.
+class FrameArena final : public std::pmr::memory_resource
+{
+public:
+    FrameArena(size_t bytesPerFrame, uint32_t frameCount);
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    FrameArena(FrameArena&&) = delete;
+    FrameArena& operator=(FrameArena&&) = delete;
+
+    void BeginFrame();
+
+    [[nodiscard]] size_t GetCapacity() const;
+    [[nodiscard]] size_t GetUsed() const;
+    [[nodiscard]] size_t GetHighWaterMark() const; // Peak bytes requested in any single frame, overflow included
+    [[nodiscard]] uint64_t GetOverflowCount() const;
+
+private:
+    // Overflow blocks are chained through a header at their start so tracking them never allocates.
+    struct OverflowBlock
+    {
+        OverflowBlock* Next;
+        size_t Bytes;
+        size_t Alignment;
+    };
+
+    struct Slot
+    {
+        std::unique_ptr<std::byte[]> Memory; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+        size_t Offset = 0;
+        size_t Requested = 0;
+        OverflowBlock* Overflow = nullptr;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    void* AllocateOverflow(Slot& slot, size_t bytes, size_t alignment);
+    void ReleaseOverflow(Slot& slot);
+
+    size_t m_capacity;
+    std::vector<Slot> m_slots;
+    uint32_t m_current = 0;
+    size_t m_highWaterMark = 0;
+    uint64_t m_overflowCount = 0;
+    std::pmr::memory_resource* m_upstream;
+};
+} // namespace Core
@@ -0,0 +1,405 @@
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+
+#include "Logger.hpp"
+#include "Trace.hpp"
+
+namespace Core
+{
+namespace
+{
+constexpr uint32_t kChunksPerThread = 4;
+
+thread_local const JobSystem* t_owner = nullptr;
+thread_local uint32_t t_queueIndex = 0;
+} // namespace
+
+JobSystem::JobSystem(uint32_t workerCount) : m_jobs(std::make_unique<Job[]>(kMaxJobs))
+{
+    m_queues.reserve(workerCount + 2);
+    for (uint32_t i = 0; i < workerCount + 2; ++i)
+    {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    t_owner = this;
+    t_queueIndex = 0;
+
+    m_workers.reserve(workerCount);
+    for (uint32_t i = 1; i <= workerCount; ++i)
+    {
+        m_workers.emplace_back([this, i] { WorkerMain(i); });
+    }
+
+    LOG_INFO("JobSystem: Started {} workers", workerCount);
+}
+
+JobSystem::~JobSystem()
+{
+    m_stopping.store(true, std::memory_order::release);
+    m_queuedJobs.fetch_add(1, std::memory_order::release);
+    m_queuedJobs.notify_all();
+    m_workers.clear();
+
+    if (t_owner == this)
+    {
+        t_owner = nullptr;
+    }
+}
+
+JobHandle JobSystem::Schedule(std::function<void()> function,
+                              std::span<const JobHandle> dependencies,
+                              JobAffinity affinity)
+{
+    const uint32_t index = m_nextJob.fetch_add(1, std::memory_order::relaxed) % kMaxJobs;
+    Job& job = m_jobs[index];
+
+    // The pool is a ring; if it wrapped onto a job that is still pending, help until that slot frees up.
+    while (!job.Finished.load(std::memory_order::acquire))
+    {
+        if (!TryRunOne())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    const uint32_t generation = job.Generation.load(std::memory_order::relaxed) + 1;
+
+    job.Function = std::move(function);
+    job.Affinity = affinity;
+    job.PendingDependencies.store(1, std::memory_order::relaxed);
+    {
+        const std::scoped_lock lock(job.ContinuationMutex);
+        job.ContinuationCount = 0;
+        job.Finished.store(false, std::memory_order::release);
+        job.Generation.store(generation, std::memory_order::release);
+    }
+
+    for (const JobHandle dependency : dependencies)
+    {
+        job.PendingDependencies.fetch_add(1, std::memory_order::acq_rel);
+        if (!AddContinuation(dependency, index))
+        {
+            job.PendingDependencies.fetch_sub(1, std::memory_order::acq_rel);
+        }
+    }
+
+    if (job.PendingDependencies.fetch_sub(1, std::memory_order::acq_rel) == 1)
+    {
+        Enqueue(index);
+    }
+
+    return JobHandle{.Index = index, .Generation = generation};
+}
+
+bool JobSystem::AddContinuation(JobHandle dependency, uint32_t continuation)
+{
+    Job& job = m_jobs[dependency.Index % kMaxJobs];
+    bool full = false;
+    {
+        const std::scoped_lock lock(job.ContinuationMutex);
+        if (job.Generation.load(std::memory_order::acquire) != dependency.Generation ||
+            job.Finished.load(std::memory_order::acquire))
+        {
+            return false;
+        }
+
+        if (job.ContinuationCount < kMaxContinuations)
+        {
+            job.Continuations[job.ContinuationCount++] = continuation;
+            return true;
+        }
+        full = true;
+    }
+
+    // Too many dependents on one job: resolve this dependency eagerly instead.
+    if (full)
+    {
+        Wait(dependency);
+    }
+    return false;
+}
+
+void JobSystem::Wait(JobHandle handle)
+{
+    while (!IsDone(handle))
+    {
+        if (!TryRunOne())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::IsDone(JobHandle handle) const
+{
+    const Job& job = m_jobs[handle.Index % kMaxJobs];
+    return job.Generation.load(std::memory_order::acquire) != handle.Generation ||
+           job.Finished.load(std::memory_order::acquire);
+}
+
+void JobSystem::RunMainThreadJobs()
+{
+    uint32_t jobIndex = 0;
+    while (TryPopMainThread(jobIndex))
+    {
+        Execute(jobIndex);
+    }
+}
+
+void JobSystem::ParallelForRanges(uint32_t count, uint32_t grain, RangeFunction function, const void* context)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    grain = std::max(grain, 1U);
+    const uint32_t maxChunks = GetThreadCount() * kChunksPerThread;
+    const uint32_t chunks = std::min((count + grain - 1) / grain, maxChunks);
+
+    if (chunks <= 1 || m_workers.empty())
+    {
+        function(context, 0, count);
+        return;
+    }
+
+    const uint32_t chunkSize = (count + chunks - 1) / chunks;
+    const uint32_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+    struct SharedState
+    {
+        RangeFunction Function;
+        const void* Context;
+        std::atomic<uint32_t> Remaining;
+        std::mutex ErrorMutex;
+        std::exception_ptr Error; // First chunk to throw; rethrown on the calling thread once every chunk is done
+
+        void RunChunk(uint32_t begin, uint32_t end) noexcept
+        {
+            try
+            {
+                Function(Context, begin, end);
+            }
+            catch (...)
+            {
+                const std::scoped_lock lock(ErrorMutex);
+                if (!Error)
+                {
+                    Error = std::current_exception();
+                }
+            }
+        }
+    };
+
+    // Signals a queued chunk as done however it leaves, so the caller never waits on a chunk that threw.
+    struct ChunkDone
+    {
+        SharedState& State;
+        ~ChunkDone() { State.Remaining.fetch_sub(1, std::memory_order::release); }
+    };
+
+    SharedState state{.Function = function, .Context = context, .Remaining = chunkCount - 1};
+
+    // The lambda captures exactly one pointer and two integers so it stays inside std::function's inline storage.
+    for (uint32_t chunk = 1; chunk < chunkCount; ++chunk)
+    {
+        const uint32_t begin = chunk * chunkSize;
+        const uint32_t end = std::min(begin + chunkSize, count);
+        Schedule([sharedState = &state, begin, end] {
+            const ChunkDone done{*sharedState};
+            sharedState->RunChunk(begin, end);
+        });
+    }
+
+    state.RunChunk(0, std::min(chunkSize, count));
+
+    // Queued chunks point at this stack frame, so wait for all of them even when one has already failed.
+    while (state.Remaining.load(std::memory_order::acquire) > 0)
+    {
+        if (!TryRunOne())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (state.Error)
+    {
+        std::rethrow_exception(state.Error);
+    }
+}
+
+uint32_t JobSystem::GetThreadCount() const
+{
+    return static_cast<uint32_t>(m_workers.size()) + 1;
+}
+
+uint32_t JobSystem::GetDefaultWorkerCount()
+{
+    return std::max(std::thread::hardware_concurrency(), 1U) - 1;
+}
+
+void JobSystem::WorkerMain(uint32_t queueIndex)
+{
+    t_owner = this;
+    t_queueIndex = queueIndex;
+    Trace::NameThread("Worker");
+
+    while (!m_stopping.load(std::memory_order::acquire))
+    {
+        if (TryRunOne())
+        {
+            continue;
+        }
+
+        if (m_queuedJobs.load(std::memory_order::acquire) == 0)
+        {
+            m_queuedJobs.wait(0, std::memory_order::acquire);
+        }
+    }
+}
+
+uint32_t JobSystem::GetCurrentQueue() const
+{
+    if (t_owner == this)
+    {
+        return t_queueIndex;
+    }
+    return static_cast<uint32_t>(m_queues.size()) - 1;
+}
+
+bool JobSystem::IsMainThread() const
+{
+    return t_owner == this && t_queueIndex == 0;
+}
+
+void JobSystem::Enqueue(uint32_t jobIndex)
+{
+    if (m_jobs[jobIndex].Affinity == JobAffinity::MainThread)
+    {
+        const std::scoped_lock lock(m_mainThreadQueue.Mutex);
+        m_mainThreadQueue.Jobs.push_back(jobIndex);
+        return;
+    }
+
+    WorkQueue& queue = *m_queues[GetCurrentQueue()];
+    {
+        const std::scoped_lock lock(queue.Mutex);
+        queue.Jobs.push_back(jobIndex);
+    }
+
+    m_queuedJobs.fetch_add(1, std::memory_order::release);
+    m_queuedJobs.notify_one();
+}
+
+bool JobSystem::TryPop(uint32_t queueIndex, uint32_t& outJob)
+{
+    WorkQueue& queue = *m_queues[queueIndex];
+    const std::scoped_lock lock(queue.Mutex);
+
+    if (queue.Jobs.empty())
+    {
+        return false;
+    }
+
+    outJob = queue.Jobs.back();
+    queue.Jobs.pop_back();
+    m_queuedJobs.fetch_sub(1, std::memory_order::acq_rel);
+    return true;
+}
+
+bool JobSystem::TrySteal(uint32_t thiefIndex, uint32_t& outJob)
+{
+    const auto queueCount = static_cast<uint32_t>(m_queues.size());
+
+    for (uint32_t offset = 1; offset < queueCount; ++offset)
+    {
+        WorkQueue& victim = *m_queues[(thiefIndex + offset) % queueCount];
+        const std::scoped_lock lock(victim.Mutex);
+
+        if (!victim.Jobs.empty())
+        {
+            outJob = victim.Jobs.front();
+            victim.Jobs.pop_front();
+            m_queuedJobs.fetch_sub(1, std::memory_order::acq_rel);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::TryPopMainThread(uint32_t& outJob)
+{
+    const std::scoped_lock lock(m_mainThreadQueue.Mutex);
+
+    if (m_mainThreadQueue.Jobs.empty())
+    {
+        return false;
+    }
+
+    outJob = m_mainThreadQueue.Jobs.front();
+    m_mainThreadQueue.Jobs.pop_front();
+    return true;
+}
+
+bool JobSystem::TryRunOne()
+{
+    uint32_t jobIndex = 0;
+    const uint32_t self = GetCurrentQueue();
+
+    if ((IsMainThread() && TryPopMainThread(jobIndex)) || TryPop(self, jobIndex) || TrySteal(self, jobIndex))
+    {
+        Execute(jobIndex);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(uint32_t jobIndex)
+{
+    Job& job = m_jobs[jobIndex];
+
+    try
+    {
+        TRACE_SCOPE("Job", "jobs");
+        job.Function();
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("JobSystem: Job threw: {}", e.what());
+    }
+    catch (...)
+    {
+        // Anything else would end the worker and leave the job's dependents waiting forever.
+        LOG_ERROR("JobSystem: Job threw a non-standard exception");
+    }
+    job.Function = nullptr;
+
+    std::array<uint32_t, kMaxContinuations> continuations{};
+    uint32_t continuationCount = 0;
+    {
+        const std::scoped_lock lock(job.ContinuationMutex);
+        job.Finished.store(true, std::memory_order::release);
+        continuations = job.Continuations;
+        continuationCount = std::exchange(job.ContinuationCount, 0);
+    }
+
+    for (uint32_t i = 0; i < continuationCount; ++i)
+    {
+        if (m_jobs[continuations[i]].PendingDependencies.fetch_sub(1, std::memory_order::acq_rel) == 1)
+        {
+            Enqueue(continuations[i]);
+        }
+    }
+}
+} // namespace Core
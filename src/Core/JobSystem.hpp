@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace Core
+{
+enum class JobAffinity : std::uint8_t
+{
+    Any,
+    MainThread // SDL GPU object creation and anything else that must run on the thread that owns the device
+};
+
+struct JobHandle
+{
+    uint32_t Index = 0;
+    uint32_t Generation = 0;
+};
+
+struct TileRange
+{
+    uint32_t X0 = 0;
+    uint32_t Y0 = 0;
+    uint32_t X1 = 0;
+    uint32_t Y1 = 0;
+};
+
+// Fixed pool of worker threads, each with its own deque. Owners push and pop at the back (LIFO, cache warm),
+// idle threads steal from the front of other deques. The constructing thread is treated as worker 0 and is
+// the only thread that runs MainThread jobs; threads the system does not own share one injection deque.
+// Waiting threads execute queued jobs instead of blocking.
+class JobSystem
+{
+public:
+    using RangeFunction = void (*)(const void* context, uint32_t begin, uint32_t end);
+
+    explicit JobSystem(uint32_t workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    JobSystem(JobSystem&&) = delete;
+    JobSystem& operator=(JobSystem&&) = delete;
+
+    // The job runs once every dependency has finished.
+    JobHandle Schedule(std::function<void()> function,
+                       std::span<const JobHandle> dependencies = {},
+                       JobAffinity affinity = JobAffinity::Any);
+
+    void Wait(JobHandle handle);
+    [[nodiscard]] bool IsDone(JobHandle handle) const;
+
+    // Drains jobs pinned to the main thread; call once per frame from the main thread.
+    void RunMainThreadJobs();
+
+    // Splits [0, count) into chunks of at least `grain` items and blocks until all of them have run.
+    // If any chunk throws, the first exception is rethrown here once every chunk has finished.
+    void ParallelForRanges(uint32_t count, uint32_t grain, RangeFunction function, const void* context);
+
+    template <typename Fn>
+    void ParallelFor(uint32_t count, uint32_t grain, const Fn& function)
+    {
+        ParallelForRanges(
+            count,
+            grain,
+            [](const void* context, uint32_t begin, uint32_t end) { (*static_cast<const Fn*>(context))(begin, end); },
+            &function);
+    }
+
+    // Invokes function(const TileRange&) once per tileSize x tileSize tile of a width x height domain.
+    template <typename Fn>
+    void ParallelForTiles(uint32_t width, uint32_t height, uint32_t tileSize, const Fn& function)
+    {
+        const uint32_t tilesX = (width + tileSize - 1) / tileSize;
+        const uint32_t tilesY = (height + tileSize - 1) / tileSize;
+
+        ParallelFor(tilesX * tilesY, 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t tile = begin; tile < end; ++tile)
+            {
+                const uint32_t x0 = (tile % tilesX) * tileSize;
+                const uint32_t y0 = (tile / tilesX) * tileSize;
+                function(TileRange{.X0 = x0,
+                                   .Y0 = y0,
+                                   .X1 = std::min(x0 + tileSize, width),
+                                   .Y1 = std::min(y0 + tileSize, height)});
+            }
+        });
+    }
+
+    [[nodiscard]] uint32_t GetThreadCount() const;
+
+    [[nodiscard]] static uint32_t GetDefaultWorkerCount();
+
+private:
+    static constexpr uint32_t kMaxJobs = 4096;
+    static constexpr uint32_t kMaxContinuations = 8;
+
+    struct Job
+    {
+        std::function<void()> Function;
+        std::atomic<uint32_t> Generation = 0;
+        std::atomic<bool> Finished = true;
+        std::atomic<int32_t> PendingDependencies = 0;
+        JobAffinity Affinity = JobAffinity::Any;
+
+        std::mutex ContinuationMutex;
+        std::array<uint32_t, kMaxContinuations> Continuations{};
+        uint32_t ContinuationCount = 0;
+    };
+
+    struct WorkQueue
+    {
+        std::mutex Mutex;
+        std::deque<uint32_t> Jobs;
+    };
+
+    void WorkerMain(uint32_t queueIndex);
+
+    [[nodiscard]] uint32_t GetCurrentQueue() const;
+    [[nodiscard]] bool IsMainThread() const;
+
+    bool AddContinuation(JobHandle dependency, uint32_t continuation);
+    void Enqueue(uint32_t jobIndex);
+    [[nodiscard]] bool TryPop(uint32_t queueIndex, uint32_t& outJob);
+    [[nodiscard]] bool TrySteal(uint32_t thiefIndex, uint32_t& outJob);
+    [[nodiscard]] bool TryPopMainThread(uint32_t& outJob);
+    [[nodiscard]] bool TryRunOne();
+    void Execute(uint32_t jobIndex);
+
+    std::unique_ptr<Job[]> m_jobs; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    std::atomic<uint32_t> m_nextJob = 0;
+
+    // [0] main thread, [1..N] workers, [N+1] threads not owned by the system.
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    WorkQueue m_mainThreadQueue;
+
+    std::vector<std::jthread> m_workers;
+    std::atomic<uint32_t> m_queuedJobs = 0; // Idle workers sleep on this via atomic wait
+    std::atomic<bool> m_stopping = false;
+};
+} // namespace Core
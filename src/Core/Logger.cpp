@@ -3,7 +3,9 @@
 #include <spdlog/async.h>
 #include <spdlog/async_logger.h>
 #include <spdlog/common.h>
+#include <spdlog/details/log_msg.h>
 #include <spdlog/logger.h>
+#include <spdlog/sinks/dist_sink.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
@@ -13,6 +15,9 @@
 #include <memory>
 #include <vector>
 
+#include "BinaryLog.hpp"
+#include "Trace.hpp"
+
 namespace Core
 {
 namespace
@@ -20,6 +25,25 @@ namespace
 constexpr size_t kAsyncQueueSize = 8192;
 constexpr size_t kMaxFileSize = 10ULL * 1024 * 1024;
 constexpr size_t kMaxFiles = 3;
+#if defined(NDEBUG)
+constexpr spdlog::level::level_enum kDefaultHotLevel = spdlog::level::info; // --hot-log-level lowers it
+#else
+constexpr spdlog::level::level_enum kDefaultHotLevel = spdlog::level::trace;
+#endif
+
+// Fans out to the real sinks; exists so the async worker's formatting and writes show up in traces.
+class TracedSink : public spdlog::sinks::dist_sink_mt
+{
+public:
+    using dist_sink::dist_sink;
+
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override
+    {
+        TRACE_SCOPE("Log", "log");
+        dist_sink::sink_it_(msg);
+    }
+};
 } // namespace
 
 std::shared_ptr<spdlog::logger> Logger::s_Logger;
@@ -31,7 +55,7 @@ void Logger::Init()
         std::filesystem::create_directory("logs");
     }
 
-    spdlog::init_thread_pool(kAsyncQueueSize, 1);
+    spdlog::init_thread_pool(kAsyncQueueSize, 1, [] { Trace::NameThread("spdlog"); });
 
     std::vector<spdlog::sink_ptr> sinks;
 
@@ -44,17 +68,25 @@ void Logger::Init()
     fileSink->set_pattern("[%Y-%m-%d %T] [%l] %v");
     sinks.push_back(fileSink);
 
-    s_Logger = std::make_shared<spdlog::async_logger>(
-        "APP", begin(sinks), end(sinks), spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
+    s_Logger = std::make_shared<spdlog::async_logger>("APP",
+                                                      std::make_shared<TracedSink>(sinks),
+                                                      spdlog::thread_pool(),
+                                                      spdlog::async_overflow_policy::overrun_oldest);
 
     spdlog::register_logger(s_Logger);
 
     s_Logger->set_level(spdlog::level::trace);
     s_Logger->flush_on(spdlog::level::err);
+
+    // Hot-path records only go to the file; per-frame output would drown the console. Release builds compile the
+    // debug records in but leave them off until asked for.
+    BinaryLog::Start(fileSink, kDefaultHotLevel);
 }
 
 void Logger::Shutdown()
 {
+    BinaryLog::Stop();
+
     if (s_Logger)
     {
         s_Logger->flush();
@@ -67,4 +99,9 @@ std::shared_ptr<spdlog::logger>& Logger::GetLogger()
 {
     return s_Logger;
 }
+
+void Logger::SetHotLevel(spdlog::level::level_enum level)
+{
+    BinaryLog::SetLevel(level);
+}
 } // namespace Core
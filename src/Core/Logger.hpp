@@ -4,6 +4,8 @@
 
 #include <memory>
 
+#include "BinaryLog.hpp"
+
 namespace Core
 {
 class Logger
@@ -14,6 +16,9 @@ class Logger
 
     static std::shared_ptr<spdlog::logger>& GetLogger();
 
+    // Lowest LOG_HOT_* level recorded from now on; levels compiled out by AF_HOT_LOG_LEVEL stay out.
+    static void SetHotLevel(spdlog::level::level_enum level);
+
     struct Scoped
     {
         Scoped() { Logger::Init(); }
@@ -32,17 +37,106 @@ class Logger
 
 } // namespace Core
 
+// Compile-time level filter: calls below AF_LOG_LEVEL (an SPDLOG_LEVEL_* value) compile away. Their arguments are
+// still type-checked against the format string but never evaluated, so values that exist only to be logged do not
+// turn into unused-variable warnings at higher levels. Defaults to everything in debug builds and info and above
+// otherwise.
+// LOG_HOT_* take the same format strings but arithmetic or enum arguments only, and go through BinaryLog:
+// cheap enough to leave per-frame diagnostics compiled in. They have their own filter, AF_HOT_LOG_LEVEL, which
+// follows an explicit AF_LOG_LEVEL and otherwise keeps debug and above in release builds; Logger::SetHotLevel
+// chooses at runtime which of those are recorded.
 // NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#if !defined(AF_HOT_LOG_LEVEL)
+#if defined(AF_LOG_LEVEL)
+#define AF_HOT_LOG_LEVEL AF_LOG_LEVEL
+#elif defined(NDEBUG)
+#define AF_HOT_LOG_LEVEL SPDLOG_LEVEL_DEBUG
+#else
+#define AF_HOT_LOG_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+#endif
+
+#if !defined(AF_LOG_LEVEL)
 #if defined(NDEBUG)
-#define LOG_TRACE(...) (void)0
-#define LOG_DEBUG(...) (void)0
+#define AF_LOG_LEVEL SPDLOG_LEVEL_INFO
 #else
+#define AF_LOG_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+#endif
+
+#define AF_LOG_HOT(level, format, ...)                                                                                \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        static constexpr ::Core::LogSite afLogSite{.Level = (level), .Format = (format)};                              \
+        ::Core::BinaryLog::Write(afLogSite __VA_OPT__(, ) __VA_ARGS__);                                                \
+    } while (false)
+
+#define AF_LOG_DISCARD(...)                                                                                            \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if constexpr (false)                                                                                           \
+        {                                                                                                              \
+            (void)::fmt::format(__VA_ARGS__);                                                                          \
+        }                                                                                                              \
+    } while (false)
+
+#if AF_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
 #define LOG_TRACE(...) ::Core::Logger::GetLogger()->trace(__VA_ARGS__)
+#else
+#define LOG_TRACE(...) AF_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if AF_LOG_LEVEL <= SPDLOG_LEVEL_DEBUG
 #define LOG_DEBUG(...) ::Core::Logger::GetLogger()->debug(__VA_ARGS__)
+#else
+#define LOG_DEBUG(...) AF_LOG_DISCARD(__VA_ARGS__)
 #endif
 
+#if AF_LOG_LEVEL <= SPDLOG_LEVEL_INFO
 #define LOG_INFO(...) ::Core::Logger::GetLogger()->info(__VA_ARGS__)
+#else
+#define LOG_INFO(...) AF_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if AF_LOG_LEVEL <= SPDLOG_LEVEL_WARN
 #define LOG_WARN(...) ::Core::Logger::GetLogger()->warn(__VA_ARGS__)
+#else
+#define LOG_WARN(...) AF_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if AF_LOG_LEVEL <= SPDLOG_LEVEL_ERROR
 #define LOG_ERROR(...) ::Core::Logger::GetLogger()->error(__VA_ARGS__)
+#else
+#define LOG_ERROR(...) AF_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if AF_LOG_LEVEL <= SPDLOG_LEVEL_CRITICAL
 #define LOG_CRITICAL(...) ::Core::Logger::GetLogger()->critical(__VA_ARGS__)
+#else
+#define LOG_CRITICAL(...) AF_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if AF_HOT_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
+#define LOG_HOT_TRACE(...) AF_LOG_HOT(::spdlog::level::trace, __VA_ARGS__)
+#else
+#define LOG_HOT_TRACE(...) AF_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if AF_HOT_LOG_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define LOG_HOT_DEBUG(...) AF_LOG_HOT(::spdlog::level::debug, __VA_ARGS__)
+#else
+#define LOG_HOT_DEBUG(...) AF_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if AF_HOT_LOG_LEVEL <= SPDLOG_LEVEL_INFO
+#define LOG_HOT_INFO(...) AF_LOG_HOT(::spdlog::level::info, __VA_ARGS__)
+#else
+#define LOG_HOT_INFO(...) AF_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if AF_HOT_LOG_LEVEL <= SPDLOG_LEVEL_WARN
+#define LOG_HOT_WARN(...) AF_LOG_HOT(::spdlog::level::warn, __VA_ARGS__)
+#else
+#define LOG_HOT_WARN(...) AF_LOG_DISCARD(__VA_ARGS__)
+#endif
 // NOLINTEND(cppcoreguidelines-macro-usage)
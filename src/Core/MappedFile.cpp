@@ -0,0 +1,109 @@
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include "Logger.hpp"
+
+namespace Core
+{
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& path)
+{
+    m_file = CreateFileA(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        m_file = nullptr;
+        LOG_ERROR("MappedFile: Failed to open '{}' (error {})", path, GetLastError());
+        throw std::runtime_error("Mapped File Open Failed");
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+    {
+        LOG_ERROR("MappedFile: '{}' is empty or unreadable", path);
+        CloseHandle(m_file);
+        throw std::runtime_error("Mapped File Open Failed");
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view)
+    {
+        LOG_ERROR("MappedFile: Failed to map '{}' (error {})", path, GetLastError());
+        if (m_mapping)
+        {
+            CloseHandle(m_mapping);
+        }
+        CloseHandle(m_file);
+        throw std::runtime_error("Mapped File Map Failed");
+    }
+    m_data = static_cast<const std::byte*>(view);
+}
+
+MappedFile::~MappedFile()
+{
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mapping);
+    CloseHandle(m_file);
+}
+#else
+MappedFile::MappedFile(const std::string& path)
+{
+    const int file = open(path.c_str(), O_RDONLY); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (file < 0)
+    {
+        LOG_ERROR("MappedFile: Failed to open '{}'", path);
+        throw std::runtime_error("Mapped File Open Failed");
+    }
+
+    struct stat status{};
+    if (fstat(file, &status) != 0 || status.st_size == 0)
+    {
+        LOG_ERROR("MappedFile: '{}' is empty or unreadable", path);
+        close(file);
+        throw std::runtime_error("Mapped File Open Failed");
+    }
+    m_size = static_cast<size_t>(status.st_size);
+
+    // The mapping keeps its own reference to the file, so the descriptor can go right away.
+    void* view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (view == MAP_FAILED)
+    {
+        LOG_ERROR("MappedFile: Failed to map '{}'", path);
+        throw std::runtime_error("Mapped File Map Failed");
+    }
+    m_data = static_cast<const std::byte*>(view);
+}
+
+MappedFile::~MappedFile()
+{
+    munmap(const_cast<std::byte*>(m_data), m_size); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+}
+#endif
+
+std::span<const std::byte> MappedFile::GetData() const
+{
+    return {m_data, m_size};
+}
+} // namespace Core
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace Core
+{
+// Read-only view of a whole file through the OS page cache. Pages are faulted in on first touch, so opening is
+// constant time regardless of the file size and untouched regions are never read from disk.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) noexcept = delete;
+    MappedFile& operator=(MappedFile&&) noexcept = delete;
+
+    [[nodiscard]] std::span<const std::byte> GetData() const;
+
+private:
+    const std::byte* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
+} // namespace Core
@@ -0,0 +1,167 @@
+#include "Metrics.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "Logger.hpp"
+
+namespace Core
+{
+namespace
+{
+// [a-zA-Z_:][a-zA-Z0-9_:]*
+bool IsValidName(std::string_view name)
+{
+    const auto isLead = [](char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':'; };
+    return !name.empty() && isLead(name.front()) &&
+           std::ranges::all_of(name, [&](char c) { return isLead(c) || (c >= '0' && c <= '9'); });
+}
+
+// HELP text escapes backslashes and line feeds.
+void AppendHelp(fmt::memory_buffer& out, std::string_view name, std::string_view help)
+{
+    fmt::format_to(fmt::appender(out), "# HELP {} ", name);
+    for (const char c : help)
+    {
+        if (c == '\\')
+        {
+            fmt::format_to(fmt::appender(out), "\\\\");
+        }
+        else if (c == '\n')
+        {
+            fmt::format_to(fmt::appender(out), "\\n");
+        }
+        else
+        {
+            out.push_back(c);
+        }
+    }
+    out.push_back('\n');
+}
+} // namespace
+
+Histogram::Histogram(std::vector<double> bounds)
+    : m_bounds(std::move(bounds)),
+      m_buckets(std::make_unique<std::atomic<uint64_t>[]>(m_bounds.size() + 1)) // NOLINT(*-avoid-c-arrays)
+{
+    if (std::ranges::adjacent_find(m_bounds, std::ranges::greater_equal{}) != m_bounds.end())
+    {
+        LOG_ERROR("Metrics: Histogram bounds must be strictly increasing");
+        throw std::invalid_argument("Invalid Histogram Bounds");
+    }
+}
+
+void Histogram::Observe(double value)
+{
+    const size_t bucket =
+        static_cast<size_t>(std::ranges::lower_bound(m_bounds, value) - m_bounds.begin()); // First bound >= value
+    m_buckets[bucket].fetch_add(1, std::memory_order::relaxed);
+    m_sum.fetch_add(value, std::memory_order::relaxed);
+}
+
+uint64_t Histogram::GetBucketCount(size_t bucket) const
+{
+    return m_buckets[bucket].load(std::memory_order::relaxed);
+}
+
+Counter& MetricsRegistry::AddCounter(std::string name, std::string help)
+{
+    return Add(std::move(name), std::move(help), std::make_unique<Counter>());
+}
+
+Gauge& MetricsRegistry::AddGauge(std::string name, std::string help)
+{
+    return Add(std::move(name), std::move(help), std::make_unique<Gauge>());
+}
+
+Histogram& MetricsRegistry::AddHistogram(std::string name, std::string help, std::vector<double> bounds)
+{
+    return Add(std::move(name), std::move(help), std::make_unique<Histogram>(std::move(bounds)));
+}
+
+void MetricsRegistry::AddCollector(std::function<void()> collector)
+{
+    const std::scoped_lock lock(m_mutex);
+    m_collectors.push_back(std::move(collector));
+}
+
+template <typename T>
+T& MetricsRegistry::Add(std::string name, std::string help, std::unique_ptr<T> metric)
+{
+    if (!IsValidName(name))
+    {
+        LOG_ERROR("Metrics: '{}' is not a valid metric name", name);
+        throw std::invalid_argument("Invalid Metric Name");
+    }
+
+    const std::scoped_lock lock(m_mutex);
+    if (std::ranges::find(m_entries, name, &Entry::Name) != m_entries.end())
+    {
+        LOG_ERROR("Metrics: '{}' is already registered", name);
+        throw std::invalid_argument("Duplicate Metric Name");
+    }
+
+    T& added = *metric;
+    m_entries.push_back(Entry{.Name = std::move(name), .Help = std::move(help), .Metric = std::move(metric)});
+    return added;
+}
+
+std::string MetricsRegistry::Render() const
+{
+    const std::scoped_lock lock(m_mutex);
+    for (const std::function<void()>& collector : m_collectors)
+    {
+        collector();
+    }
+
+    fmt::memory_buffer out;
+    for (const Entry& entry : m_entries)
+    {
+        AppendHelp(out, entry.Name, entry.Help);
+
+        if (const auto* counter = std::get_if<std::unique_ptr<Counter>>(&entry.Metric))
+        {
+            fmt::format_to(fmt::appender(out), "# TYPE {0} counter\n{0} {1}\n", entry.Name, (*counter)->Get());
+        }
+        else if (const auto* gauge = std::get_if<std::unique_ptr<Gauge>>(&entry.Metric))
+        {
+            fmt::format_to(fmt::appender(out), "# TYPE {0} gauge\n{0} {1}\n", entry.Name, (*gauge)->Get());
+        }
+        else
+        {
+            const Histogram& histogram = *std::get<std::unique_ptr<Histogram>>(entry.Metric);
+            const std::vector<double>& bounds = histogram.GetBounds();
+            fmt::format_to(fmt::appender(out), "# TYPE {} histogram\n", entry.Name);
+
+            // Prometheus buckets are cumulative. Updates may land mid-render; the count is taken from the same
+            // pass as the buckets so the +Inf bucket and _count always agree.
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i < bounds.size(); ++i)
+            {
+                cumulative += histogram.GetBucketCount(i);
+                fmt::format_to(fmt::appender(out), "{}_bucket{{le=\"{}\"}} {}\n", entry.Name, bounds[i], cumulative);
+            }
+            cumulative += histogram.GetBucketCount(bounds.size());
+            fmt::format_to(fmt::appender(out),
+                           "{0}_bucket{{le=\"+Inf\"}} {1}\n{0}_sum {2}\n{0}_count {1}\n",
+                           entry.Name,
+                           cumulative,
+                           histogram.GetSum());
+        }
+    }
+    return fmt::to_string(out);
+}
+} // namespace Core
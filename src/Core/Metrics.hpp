@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace Core
+{
+// Monotonic total. Add is a single relaxed atomic increment.
+class Counter
+{
+public:
+    void Add(uint64_t amount = 1) { m_value.fetch_add(amount, std::memory_order::relaxed); }
+    [[nodiscard]] uint64_t Get() const { return m_value.load(std::memory_order::relaxed); }
+
+private:
+    std::atomic<uint64_t> m_value = 0;
+};
+
+// Last written value.
+class Gauge
+{
+public:
+    void Set(double value) { m_value.store(value, std::memory_order::relaxed); }
+    [[nodiscard]] double Get() const { return m_value.load(std::memory_order::relaxed); }
+
+private:
+    std::atomic<double> m_value = 0.0;
+};
+
+// Counts observations into fixed buckets. Observe scans the (short) bound list and does two relaxed atomic adds.
+class Histogram
+{
+public:
+    // Upper bounds, strictly increasing; an implicit +Inf bucket catches the rest.
+    explicit Histogram(std::vector<double> bounds);
+
+    void Observe(double value);
+
+    [[nodiscard]] const std::vector<double>& GetBounds() const { return m_bounds; }
+    // Observations in bucket i alone, not cumulative; the last is the +Inf bucket.
+    [[nodiscard]] uint64_t GetBucketCount(size_t bucket) const;
+    [[nodiscard]] double GetSum() const { return m_sum.load(std::memory_order::relaxed); }
+
+private:
+    std::vector<double> m_bounds;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_buckets; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    std::atomic<double> m_sum = 0.0;
+};
+
+// Owns every metric. Registration takes a lock and belongs in setup code; the returned references stay valid for
+// the registry's lifetime and are what the hot paths update. Render() produces the Prometheus text format.
+class MetricsRegistry
+{
+public:
+    Counter& AddCounter(std::string name, std::string help);
+    Gauge& AddGauge(std::string name, std::string help);
+    Histogram& AddHistogram(std::string name, std::string help, std::vector<double> bounds);
+
+    // Runs at the start of every Render(), on the thread calling it: the MetricsServer thread, once per scrape. For
+    // values that are cheaper to sample than to push, so it may only touch state that thread can safely read.
+    void AddCollector(std::function<void()> collector);
+
+    [[nodiscard]] std::string Render() const;
+
+private:
+    struct Entry
+    {
+        std::string Name;
+        std::string Help;
+        std::variant<std::unique_ptr<Counter>, std::unique_ptr<Gauge>, std::unique_ptr<Histogram>> Metric;
+    };
+
+    template <typename T>
+    T& Add(std::string name, std::string help, std::unique_ptr<T> metric);
+
+    mutable std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+    std::vector<std::function<void()>> m_collectors;
+};
+} // namespace Core
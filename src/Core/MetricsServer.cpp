@@ -0,0 +1,253 @@
+#include "MetricsServer.hpp"
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Logger.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+
+namespace Core
+{
+#ifdef _WIN32
+MetricsServer::MetricsServer(const MetricsRegistry& registry, MetricsServerSettings settings)
+    : m_registry(registry), m_settings(std::move(settings))
+{
+    LOG_WARN("MetricsServer: Not available on this platform, metrics will not be exported");
+}
+
+MetricsServer::~MetricsServer() = default;
+
+void MetricsServer::Serve([[maybe_unused]] const std::stop_token& stopToken) {}
+
+void MetricsServer::Respond([[maybe_unused]] int client) const {}
+#else
+namespace
+{
+constexpr int kListenBacklog = 8;
+constexpr int kPollTimeoutMs = 200; // How long a stop request can go unnoticed
+constexpr size_t kMaxRequestBytes = 4096;
+constexpr timeval kClientTimeout{.tv_sec = 1, .tv_usec = 0};
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL; // A scraper hanging up early must not raise SIGPIPE
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+int Listen(const sockaddr* address, socklen_t size, const std::string& description)
+{
+    const int listener = socket(address->sa_family, SOCK_STREAM, 0);
+    if (listener < 0)
+    {
+        LOG_ERROR("MetricsServer: Cannot create a socket for {}: {}", description, std::strerror(errno));
+        throw std::runtime_error("Metrics Socket Creation Failed");
+    }
+
+    if (address->sa_family == AF_INET)
+    {
+        const int reuse = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    }
+
+    if (bind(listener, address, size) != 0 || listen(listener, kListenBacklog) != 0)
+    {
+        LOG_ERROR("MetricsServer: Cannot listen on {}: {}", description, std::strerror(errno));
+        close(listener);
+        throw std::runtime_error("Metrics Listen Failed");
+    }
+
+    LOG_INFO("MetricsServer: Serving on {}", description);
+    return listener;
+}
+
+int ListenUnix(const std::string& path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        LOG_ERROR("MetricsServer: Socket path '{}' is too long", path);
+        throw std::invalid_argument("Metrics Socket Path Too Long");
+    }
+    std::ranges::copy(path, std::begin(address.sun_path));
+
+    // A socket left behind by a previous run would make bind fail; anything else at the path is left alone.
+    struct stat status{};
+    if (lstat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode))
+    {
+        unlink(path.c_str());
+    }
+
+    return Listen(reinterpret_cast<const sockaddr*>(&address), // NOLINT(*-reinterpret-cast)
+                  sizeof(address),
+                  fmt::format("unix:{}", path));
+}
+
+int ListenLoopback(uint16_t port)
+{
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    return Listen(reinterpret_cast<const sockaddr*>(&address), // NOLINT(*-reinterpret-cast)
+                  sizeof(address),
+                  fmt::format("http://127.0.0.1:{}/metrics", port));
+}
+
+bool SendAll(int client, std::string_view data)
+{
+    while (!data.empty())
+    {
+        const ssize_t sent = send(client, data.data(), data.size(), kSendFlags);
+        if (sent <= 0)
+        {
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(sent));
+    }
+    return true;
+}
+} // namespace
+
+MetricsServer::MetricsServer(const MetricsRegistry& registry, MetricsServerSettings settings)
+    : m_registry(registry), m_settings(std::move(settings))
+{
+    try
+    {
+        if (!m_settings.SocketPath.empty())
+        {
+            m_listeners.push_back(ListenUnix(m_settings.SocketPath));
+        }
+        if (m_settings.Port != 0)
+        {
+            m_listeners.push_back(ListenLoopback(m_settings.Port));
+        }
+    }
+    catch (const std::exception&)
+    {
+        for (const int listener : m_listeners)
+        {
+            close(listener);
+        }
+        throw;
+    }
+
+    if (!m_listeners.empty())
+    {
+        m_thread = std::jthread([this](const std::stop_token& stopToken) { Serve(stopToken); });
+    }
+}
+
+MetricsServer::~MetricsServer()
+{
+    if (m_thread.joinable())
+    {
+        m_thread.request_stop();
+        m_thread.join();
+    }
+
+    for (const int listener : m_listeners)
+    {
+        close(listener);
+    }
+    if (!m_settings.SocketPath.empty())
+    {
+        unlink(m_settings.SocketPath.c_str());
+    }
+}
+
+void MetricsServer::Serve(const std::stop_token& stopToken)
+{
+    Trace::NameThread("Metrics");
+
+    std::vector<pollfd> polled;
+    for (const int listener : m_listeners)
+    {
+        polled.push_back(pollfd{.fd = listener, .events = POLLIN, .revents = 0});
+    }
+
+    while (!stopToken.stop_requested())
+    {
+        if (poll(polled.data(), polled.size(), kPollTimeoutMs) <= 0)
+        {
+            continue;
+        }
+
+        for (const pollfd& entry : polled)
+        {
+            if ((entry.revents & POLLIN) == 0)
+            {
+                continue;
+            }
+
+            const int client = accept(entry.fd, nullptr, nullptr);
+            if (client < 0)
+            {
+                continue;
+            }
+
+            // A client that connects and stalls must not hold up the next scrape for long.
+            setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &kClientTimeout, sizeof(kClientTimeout));
+            setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &kClientTimeout, sizeof(kClientTimeout));
+            Respond(client);
+            close(client);
+        }
+    }
+}
+
+void MetricsServer::Respond(int client) const
+{
+    std::string request;
+    std::array<char, 512> chunk{};
+    while (request.size() < kMaxRequestBytes && !request.contains("\r\n\r\n"))
+    {
+        const ssize_t received = recv(client, chunk.data(), chunk.size(), 0);
+        if (received <= 0)
+        {
+            break;
+        }
+        request.append(chunk.data(), static_cast<size_t>(received));
+    }
+
+    const bool found = request.starts_with("GET /metrics ") || request.starts_with("GET / ");
+    const std::string body = found ? m_registry.Render() : std::string("Not Found\n");
+    const std::string header = fmt::format("HTTP/1.0 {}\r\n"
+                                           "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                                           "Content-Length: {}\r\n"
+                                           "Connection: close\r\n\r\n",
+                                           found ? "200 OK" : "404 Not Found",
+                                           body.size());
+
+    if (!SendAll(client, header) || !SendAll(client, body))
+    {
+        LOG_DEBUG("MetricsServer: Client went away mid-response");
+    }
+}
+#endif
+} // namespace Core
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Core
+{
+class MetricsRegistry;
+
+struct MetricsServerSettings
+{
+    std::string SocketPath; // Non-empty: listen on this Unix domain socket
+    uint16_t Port = 0;      // Non-zero: listen on 127.0.0.1:Port
+};
+
+// Serves MetricsRegistry::Render() as a minimal HTTP/1.0 response on a background thread, so Prometheus (over the
+// loopback port) or a node agent (curl --unix-socket) can scrape it. Requests are answered one at a time, which
+// is plenty for a scrape every few seconds. Loopback only: nothing here is meant to face the network.
+// POSIX sockets; on Windows the server logs that it is unavailable and does nothing.
+class MetricsServer
+{
+public:
+    MetricsServer(const MetricsRegistry& registry, MetricsServerSettings settings);
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+    MetricsServer(MetricsServer&&) noexcept = delete;
+    MetricsServer& operator=(MetricsServer&&) noexcept = delete;
+
+private:
+    void Serve(const std::stop_token& stopToken);
+    void Respond(int client) const;
+
+    const MetricsRegistry& m_registry;
+    MetricsServerSettings m_settings;
+    std::vector<int> m_listeners;
+    std::jthread m_thread;
+};
+} // namespace Core
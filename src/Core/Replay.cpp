@@ -0,0 +1,259 @@
+#include "Replay.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "../Audio/AudioConfig.hpp"
+#include "Config.hpp"
+#include "Logger.hpp"
+#include "StepInput.hpp"
+
+namespace Core
+{
+namespace
+{
+// Per-step record: uint32 event count, float quality, kBandCount floats, then the events. The time step is fixed and
+// stored once in the header, and the step index is implicit in the record order.
+constexpr uint32_t kMaxEventsPerStep = 1024;
+constexpr uint64_t kFnvOffsetBasis = 0xCBF29CE484222325ULL;
+constexpr uint64_t kFnvPrime = 0x100000001B3ULL;
+constexpr size_t kHashChunkBytes = 64 * 1024;
+
+template <typename T>
+void WritePod(std::ofstream& file, const T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+template <typename T>
+bool ReadPod(std::ifstream& file, T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    file.read(reinterpret_cast<char*>(&value), sizeof(T)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    return static_cast<bool>(file);
+}
+
+uint32_t GetFlags(const Config& config)
+{
+    return (config.PeriodicDomain ? ReplayFlags::kPeriodicDomain : 0U) |
+           (config.ConjugateGradient ? ReplayFlags::kConjugateGradient : 0U) |
+           (config.HalfPrecisionDye ? ReplayFlags::kHalfPrecisionDye : 0U);
+}
+
+std::string DescribeFlag(uint32_t flags, uint32_t flag, const char* name)
+{
+    return fmt::format("{} {}", name, (flags & flag) != 0 ? "on" : "off");
+}
+} // namespace
+
+uint64_t HashFileContents(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        LOG_ERROR("Replay: Failed to open '{}' for hashing", path);
+        throw std::runtime_error("Replay Input Open Failed");
+    }
+
+    uint64_t hash = kFnvOffsetBasis;
+    std::array<char, kHashChunkBytes> chunk{};
+    while (file.read(chunk.data(), chunk.size()) || file.gcount() > 0)
+    {
+        for (std::streamsize i = 0; i < file.gcount(); ++i)
+        {
+            hash = (hash ^ static_cast<uint8_t>(chunk[static_cast<size_t>(i)])) * kFnvPrime;
+        }
+    }
+    return hash;
+}
+
+ReplayHeader MakeReplayHeader(const Config& config, uint64_t checkpointHash)
+{
+    return ReplayHeader{.TimeStep = Config::kPhysicsTimeStep,
+                        .SampleRate = Audio::Config::kSampleRate,
+                        .FFTSize = Audio::Config::kFFTSize,
+                        .BandCount = Audio::Config::kBandCount,
+                        .WindowWidth = config.WindowWidth,
+                        .WindowHeight = config.WindowHeight,
+                        .SimulationWidth = config.SimulationWidth,
+                        .SimulationHeight = config.SimulationHeight,
+                        .MaxParticles = config.MaxParticles,
+                        .Flags = GetFlags(config),
+                        .ObstacleHash = config.ObstaclePath.empty() ? 0 : HashFileContents(config.ObstaclePath),
+                        .CheckpointHash = checkpointHash};
+}
+
+void CheckReplayConfig(const ReplayHeader& recorded, const Config& config)
+{
+    const uint64_t checkpointHash = recorded.CheckpointHash != 0 && !config.CheckpointPath.empty()
+                                        ? HashFileContents(config.CheckpointPath)
+                                        : 0;
+    const ReplayHeader current = MakeReplayHeader(config, checkpointHash);
+    bool matches = true;
+
+    const auto mismatch = [&](std::string_view setting, const std::string& expected, const std::string& actual) {
+        LOG_ERROR("Replay: Recorded with {} {}, this run has {}", setting, expected, actual);
+        matches = false;
+    };
+
+    if (recorded.SimulationWidth != current.SimulationWidth || recorded.SimulationHeight != current.SimulationHeight)
+    {
+        mismatch("simulation size",
+                 fmt::format("{}x{}", recorded.SimulationWidth, recorded.SimulationHeight),
+                 fmt::format("{}x{}", current.SimulationWidth, current.SimulationHeight));
+    }
+    if (recorded.MaxParticles != current.MaxParticles)
+    {
+        mismatch("max particles", fmt::format("{}", recorded.MaxParticles), fmt::format("{}", current.MaxParticles));
+    }
+    for (const auto& [flag, name] : {std::pair{ReplayFlags::kPeriodicDomain, "periodic domain"},
+                                     std::pair{ReplayFlags::kConjugateGradient, "conjugate gradient"},
+                                     std::pair{ReplayFlags::kHalfPrecisionDye, "half precision dye"}})
+    {
+        if ((recorded.Flags & flag) != (current.Flags & flag))
+        {
+            mismatch("setting", DescribeFlag(recorded.Flags, flag, name), DescribeFlag(current.Flags, flag, name));
+        }
+    }
+    if (recorded.ObstacleHash != current.ObstacleHash)
+    {
+        mismatch("obstacle image",
+                 recorded.ObstacleHash != 0 ? fmt::format("{:016x}", recorded.ObstacleHash) : "none",
+                 current.ObstacleHash != 0 ? fmt::format("{:016x} from '{}'", current.ObstacleHash, config.ObstaclePath)
+                                           : "none");
+    }
+    if (recorded.CheckpointHash != current.CheckpointHash)
+    {
+        // Checkpoints are overwritten as a recording runs, so the one it resumed from has to be kept aside.
+        const std::string actual = current.CheckpointHash != 0
+                                       ? fmt::format("{:016x} from '{}'", current.CheckpointHash, config.CheckpointPath)
+                                       : std::string("none (pass the checkpoint it resumed from)");
+        mismatch("starting checkpoint", fmt::format("{:016x}", recorded.CheckpointHash), actual);
+    }
+
+    if (!matches)
+    {
+        throw std::runtime_error("Replay Settings Mismatch");
+    }
+}
+
+ReplayWriter::ReplayWriter(const std::string& path, const ReplayHeader& header)
+    : m_file(path, std::ios::binary | std::ios::trunc), m_header(header)
+{
+    if (!m_file.is_open())
+    {
+        LOG_ERROR("Replay: Failed to open '{}' for recording", path);
+        throw std::runtime_error("Replay File Open Failed");
+    }
+
+    m_header.StepCount = 0;
+    WritePod(m_file, m_header);
+
+    LOG_INFO("Replay: Recording to '{}'", path);
+}
+
+ReplayWriter::~ReplayWriter()
+{
+    // Patch the final step count into the header so readers can report progress.
+    m_file.seekp(0);
+    WritePod(m_file, m_header);
+    m_file.close();
+
+    LOG_INFO("Replay: Recorded {} steps", m_header.StepCount);
+}
+
+void ReplayWriter::Write(const StepInput& input)
+{
+    WritePod(m_file, static_cast<uint32_t>(input.Events.size()));
+    WritePod(m_file, input.Quality);
+    WritePod(m_file, input.Bands);
+
+    for (const InputEvent& event : input.Events)
+    {
+        WritePod(m_file, event);
+    }
+
+    ++m_header.StepCount;
+}
+
+uint64_t ReplayWriter::GetStepCount() const
+{
+    return m_header.StepCount;
+}
+
+ReplayReader::ReplayReader(const std::string& path) : m_file(path, std::ios::binary)
+{
+    if (!m_file.is_open())
+    {
+        LOG_ERROR("Replay: Failed to open '{}'", path);
+        throw std::runtime_error("Replay File Open Failed");
+    }
+
+    if (!ReadPod(m_file, m_header) || m_header.Magic != ReplayHeader::kMagic)
+    {
+        LOG_ERROR("Replay: '{}' is not a replay file", path);
+        throw std::runtime_error("Replay Header Invalid");
+    }
+
+    if (m_header.Version != ReplayHeader::kVersion || m_header.BandCount != Audio::Config::kBandCount)
+    {
+        LOG_ERROR("Replay: '{}' has version {} with {} bands, expected version {} with {} bands",
+                  path,
+                  m_header.Version,
+                  m_header.BandCount,
+                  ReplayHeader::kVersion,
+                  Audio::Config::kBandCount);
+        throw std::runtime_error("Replay Version Mismatch");
+    }
+
+    LOG_INFO("Replay: Loaded '{}' ({} steps at {:.2f} Hz)", path, m_header.StepCount, 1.0 / m_header.TimeStep);
+}
+
+bool ReplayReader::Read(StepInput& outInput)
+{
+    uint32_t eventCount = 0;
+    if (!ReadPod(m_file, eventCount) || !ReadPod(m_file, outInput.Quality) || !ReadPod(m_file, outInput.Bands))
+    {
+        return false;
+    }
+
+    if (eventCount > kMaxEventsPerStep)
+    {
+        LOG_ERROR("Replay: Corrupt record at step {} ({} events)", m_stepsRead, eventCount);
+        return false;
+    }
+
+    outInput.Events.resize(eventCount);
+    for (InputEvent& event : outInput.Events)
+    {
+        if (!ReadPod(m_file, event))
+        {
+            return false;
+        }
+    }
+
+    ++m_stepsRead;
+    return true;
+}
+
+const ReplayHeader& ReplayReader::GetHeader() const
+{
+    return m_header;
+}
+
+uint64_t ReplayReader::GetStepsRead() const
+{
+    return m_stepsRead;
+}
+} // namespace Core
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "StepInput.hpp"
+
+namespace Core
+{
+struct Config;
+
+namespace ReplayFlags
+{
+inline constexpr uint32_t kPeriodicDomain = 1U << 0;
+inline constexpr uint32_t kConjugateGradient = 1U << 1;
+inline constexpr uint32_t kHalfPrecisionDye = 1U << 2;
+} // namespace ReplayFlags
+
+// Besides the audio shape, the header records every setting that changes what a step computes, so a replay can
+// tell whether it would reproduce the recording. Files that feed the simulation are recorded by content hash.
+struct ReplayHeader
+{
+    static constexpr uint32_t kMagic = 0x50524641; // "AFRP"
+    static constexpr uint32_t kVersion = 3;
+
+    uint32_t Magic = kMagic;
+    uint32_t Version = kVersion;
+    double TimeStep = 0.0;
+    uint32_t SampleRate = 0;
+    uint32_t FFTSize = 0;
+    uint32_t BandCount = 0;
+    uint32_t WindowWidth = 0;
+    uint32_t WindowHeight = 0;
+    uint32_t SimulationWidth = 0;
+    uint32_t SimulationHeight = 0;
+    uint32_t MaxParticles = 0;
+    uint32_t Flags = 0; // ReplayFlags
+    uint32_t Reserved = 0;
+    uint64_t ObstacleHash = 0;   // Of the obstacle image; 0 without one
+    uint64_t CheckpointHash = 0; // Of the checkpoint the recording resumed from; 0 for a fresh start
+    uint64_t StepCount = 0;
+};
+
+// 64-bit FNV-1a of a file's contents.
+[[nodiscard]] uint64_t HashFileContents(const std::string& path);
+
+// The header a recording made with config gets; checkpointHash is that of the checkpoint it resumed from, if any.
+[[nodiscard]] ReplayHeader MakeReplayHeader(const Config& config, uint64_t checkpointHash);
+
+// Logs every setting in which config differs from the recording and throws if there are any, since the replay
+// would silently diverge from it. The checkpoint is compared against the file at config.CheckpointPath.
+void CheckReplayConfig(const ReplayHeader& recorded, const Config& config);
+
+class ReplayWriter
+{
+public:
+    ReplayWriter(const std::string& path, const ReplayHeader& header);
+    ~ReplayWriter();
+
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+    ReplayWriter(ReplayWriter&&) = delete;
+    ReplayWriter& operator=(ReplayWriter&&) = delete;
+
+    void Write(const StepInput& input);
+
+    [[nodiscard]] uint64_t GetStepCount() const;
+
+private:
+    std::ofstream m_file;
+    ReplayHeader m_header;
+};
+
+class ReplayReader
+{
+public:
+    explicit ReplayReader(const std::string& path);
+    ~ReplayReader() = default;
+
+    ReplayReader(const ReplayReader&) = delete;
+    ReplayReader& operator=(const ReplayReader&) = delete;
+    ReplayReader(ReplayReader&&) = delete;
+    ReplayReader& operator=(ReplayReader&&) = delete;
+
+    [[nodiscard]] bool Read(StepInput& outInput);
+
+    [[nodiscard]] const ReplayHeader& GetHeader() const;
+    [[nodiscard]] uint64_t GetStepsRead() const;
+
+private:
+    std::ifstream m_file;
+    ReplayHeader m_header;
+    uint64_t m_stepsRead = 0;
+};
+} // namespace Core
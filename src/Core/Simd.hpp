@@ -0,0 +1,149 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#if defined(__AVX2__)
+#define AF_SIMD_AVX2 1
+#endif
+
+// MSVC has no F16C switch of its own; /arch:AVX2 implies it.
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define AF_SIMD_F16C 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AF_SIMD_SSE2 1
+#endif
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+#if defined(AF_SIMD_AVX2) || defined(AF_SIMD_SSE2) || defined(AF_SIMD_F16C)
+#include <immintrin.h>
+#endif
+
+namespace Core::Simd
+{
+#if defined(AF_SIMD_AVX2)
+inline constexpr size_t kFloatLanes = 8;
+#elif defined(AF_SIMD_SSE2)
+inline constexpr size_t kFloatLanes = 4;
+#else
+inline constexpr size_t kFloatLanes = 1;
+#endif
+
+[[nodiscard]] inline float DotProduct(const float* a, const float* b, size_t count)
+{
+    size_t i = 0;
+    float result = 0.0F;
+
+#if defined(AF_SIMD_AVX2)
+    __m256 acc = _mm256_setzero_ps();
+    for (; i + 8 <= count; i += 8)
+    {
+        acc = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc);
+    }
+    const __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    const __m128 pairs = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    result = _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+#elif defined(AF_SIMD_SSE2)
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4)
+    {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    const __m128 pairs = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    result = _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+#endif
+
+    for (; i < count; ++i)
+    {
+        result += a[i] * b[i];
+    }
+    return result;
+}
+
+// IEEE binary16 with round to nearest even, matching F16C, so both paths produce the same bits.
+[[nodiscard]] inline uint16_t FloatToHalf(float value)
+{
+    const uint32_t bits = std::bit_cast<uint32_t>(value);
+    const auto sign = static_cast<uint16_t>((bits >> 16U) & 0x8000U);
+    const uint32_t magnitude = bits & 0x7FFFFFFFU;
+
+    if (magnitude >= 0x7F800000U)
+    {
+        // Infinity stays infinity; NaN keeps its top payload bits and stays quiet.
+        const uint32_t payload = magnitude > 0x7F800000U ? 0x0200U | ((magnitude >> 13U) & 0x3FFU) : 0U;
+        return static_cast<uint16_t>(sign | 0x7C00U | payload);
+    }
+    if (magnitude >= 0x477FF000U)
+    {
+        return static_cast<uint16_t>(sign | 0x7C00U); // Rounds past 65504
+    }
+    if (magnitude < 0x38800000U)
+    {
+        // Subnormal: adding 0.5 aligns the mantissa so the FPU does the rounding.
+        const float scaled = std::bit_cast<float>(magnitude) + 0.5F;
+        return static_cast<uint16_t>(sign | (std::bit_cast<uint32_t>(scaled) - 0x3F000000U));
+    }
+
+    const uint32_t odd = (magnitude >> 13U) & 1U;
+    return static_cast<uint16_t>(sign | ((magnitude + 0xC8000FFFU + odd) >> 13U));
+}
+
+[[nodiscard]] inline float HalfToFloat(uint16_t half)
+{
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000U) << 16U;
+    const uint32_t exponent = (half >> 10U) & 0x1FU;
+    const uint32_t mantissa = half & 0x3FFU;
+
+    if (exponent == 0x1FU)
+    {
+        return std::bit_cast<float>(sign | 0x7F800000U | (mantissa != 0 ? 0x400000U : 0U) | (mantissa << 13U));
+    }
+    if (exponent == 0)
+    {
+        // Zero or subnormal: the mantissa counts units of 2^-24.
+        const float value = static_cast<float>(mantissa) * 0x1.0p-24F;
+        return sign != 0 ? -value : value;
+    }
+    return std::bit_cast<float>(sign | ((exponent + 112U) << 23U) | (mantissa << 13U));
+}
+
+inline void ConvertToHalf(const float* input, uint16_t* output, size_t count)
+{
+    size_t i = 0;
+
+#if defined(AF_SIMD_F16C)
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i packed = _mm256_cvtps_ph(_mm256_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), packed); // NOLINT(*-reinterpret-cast)
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        output[i] = FloatToHalf(input[i]);
+    }
+}
+
+inline void ConvertFromHalf(const uint16_t* input, float* output, size_t count)
+{
+    size_t i = 0;
+
+#if defined(AF_SIMD_F16C)
+    for (; i + 8 <= count; i += 8)
+    {
+        const auto* packed = reinterpret_cast<const __m128i*>(input + i); // NOLINT(*-reinterpret-cast)
+        _mm256_storeu_ps(output + i, _mm256_cvtph_ps(_mm_loadu_si128(packed)));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        output[i] = HalfToFloat(input[i]);
+    }
+}
+} // namespace Core::Simd
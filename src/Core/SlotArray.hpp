@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Core
+{
+// Index into a SlotArray plus the generation of the slot it was issued for. A default handle never resolves.
+// Tag makes handles of different registries distinct types.
+template <typename Tag>
+struct SlotHandle
+{
+    uint32_t Index = 0;
+    uint32_t Generation = 0;
+
+    [[nodiscard]] bool IsValid() const { return Generation != 0; }
+
+    [[nodiscard]] bool operator==(const SlotHandle&) const = default;
+};
+
+// Values in a dense array addressed by generational handles. Removing a value bumps its slot's generation, so
+// handles to it stop resolving instead of aliasing whatever reuses the slot. Generations are odd while a slot
+// is live and even while it is free, and never 0, so Get() is one bounds check and one compare.
+template <typename T, typename Tag>
+class SlotArray
+{
+public:
+    using Handle = SlotHandle<Tag>;
+
+    Handle Insert(T value)
+    {
+        uint32_t index = 0;
+        if (m_free.empty())
+        {
+            index = static_cast<uint32_t>(m_values.size());
+            m_values.push_back(std::move(value));
+            m_generations.push_back(1);
+        }
+        else
+        {
+            index = m_free.back();
+            m_free.pop_back();
+            m_values[index] = std::move(value);
+            ++m_generations[index];
+        }
+        return Handle{.Index = index, .Generation = m_generations[index]};
+    }
+
+    // Moves the value out into removed for the caller to release; false if the handle was stale.
+    bool Remove(Handle handle, T& removed)
+    {
+        if (!Contains(handle))
+        {
+            return false;
+        }
+
+        removed = std::exchange(m_values[handle.Index], T{});
+        ++m_generations[handle.Index];
+        m_free.push_back(handle.Index);
+        return true;
+    }
+
+    [[nodiscard]] bool Contains(Handle handle) const
+    {
+        return handle.Index < m_generations.size() && m_generations[handle.Index] == handle.Generation;
+    }
+
+    [[nodiscard]] T* Get(Handle handle) { return Contains(handle) ? &m_values[handle.Index] : nullptr; }
+
+    [[nodiscard]] const T* Get(Handle handle) const { return Contains(handle) ? &m_values[handle.Index] : nullptr; }
+
+    // Calls function(value) for every live slot.
+    template <typename Fn>
+    void ForEach(const Fn& function)
+    {
+        for (size_t i = 0; i < m_values.size(); ++i)
+        {
+            if ((m_generations[i] & 1U) != 0)
+            {
+                function(m_values[i]);
+            }
+        }
+    }
+
+    [[nodiscard]] size_t GetSize() const { return m_values.size() - m_free.size(); }
+
+private:
+    std::vector<T> m_values;
+    std::vector<uint32_t> m_generations;
+    std::vector<uint32_t> m_free;
+};
+} // namespace Core
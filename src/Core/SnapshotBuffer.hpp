@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace Core
+{
+// Hands simulation state from one producer thread to one consumer thread. The producer fills a free slot
+// and publishes it; the consumer pins the two newest published slots for interpolation. Slots are reused
+// in place, so steady-state publishing does not allocate. The lock only guards slot indices.
+template <typename T>
+class SnapshotBuffer
+{
+public:
+    struct View
+    {
+        const T* Previous = nullptr;
+        const T* Latest = nullptr;
+    };
+
+    // Returns a slot that is neither published nor pinned by the reader.
+    T& BeginWrite()
+    {
+        const std::scoped_lock lock(m_mutex);
+        for (size_t i = 0; i < kSlotCount; ++i)
+        {
+            if (i != m_latest && i != m_previous && i != m_pinnedLatest && i != m_pinnedPrevious)
+            {
+                m_writing = i;
+                break;
+            }
+        }
+        return m_slots[m_writing];
+    }
+
+    void EndWrite()
+    {
+        const std::scoped_lock lock(m_mutex);
+        m_previous = m_latest == kNone ? m_writing : m_latest;
+        m_latest = m_writing;
+        m_writing = kNone;
+        ++m_publishCount;
+    }
+
+    // Pins the two newest snapshots until Release(). Both pointers are null before the first publish.
+    [[nodiscard]] View Acquire()
+    {
+        const std::scoped_lock lock(m_mutex);
+        m_pinnedLatest = m_latest;
+        m_pinnedPrevious = m_previous;
+
+        if (m_latest == kNone)
+        {
+            return {};
+        }
+        return View{.Previous = &m_slots[m_previous], .Latest = &m_slots[m_latest]};
+    }
+
+    void Release()
+    {
+        const std::scoped_lock lock(m_mutex);
+        m_pinnedLatest = kNone;
+        m_pinnedPrevious = kNone;
+    }
+
+    [[nodiscard]] uint64_t GetPublishCount() const
+    {
+        const std::scoped_lock lock(m_mutex);
+        return m_publishCount;
+    }
+
+private:
+    // Two published + two pinned can all be distinct, so one more is always free for the writer.
+    static constexpr size_t kSlotCount = 5;
+    static constexpr size_t kNone = kSlotCount;
+
+    std::array<T, kSlotCount> m_slots{};
+    mutable std::mutex m_mutex;
+    size_t m_latest = kNone;
+    size_t m_previous = kNone;
+    size_t m_pinnedLatest = kNone;
+    size_t m_pinnedPrevious = kNone;
+    size_t m_writing = kNone;
+    uint64_t m_publishCount = 0;
+};
+} // namespace Core
@@ -0,0 +1,129 @@
+#include "StartupGraph.hpp"
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Clock.hpp"
+#include "JobSystem.hpp"
+#include "Logger.hpp"
+
+namespace Core
+{
+namespace
+{
+constexpr double kMillisecondsPerSecond = 1000.0;
+} // namespace
+
+StartupGraph::StartupGraph(JobSystem& jobSystem) : m_jobSystem(jobSystem) {}
+
+StartupGraph::PhaseId StartupGraph::Add(std::string name,
+                                        std::function<void()> function,
+                                        std::initializer_list<PhaseId> dependencies,
+                                        JobAffinity affinity)
+{
+    m_phases.push_back(Phase{.Name = std::move(name),
+                             .Function = std::move(function),
+                             .Dependencies = dependencies,
+                             .Affinity = affinity});
+    return static_cast<PhaseId>(m_phases.size() - 1);
+}
+
+void StartupGraph::Run()
+{
+    m_clock = Clock();
+
+    std::vector<JobHandle> dependencies;
+    for (Phase& phase : m_phases)
+    {
+        dependencies.clear();
+        for (const PhaseId dependency : phase.Dependencies)
+        {
+            dependencies.push_back(m_phases[dependency].Handle);
+        }
+        phase.Handle = m_jobSystem.Schedule([this, &phase] { Execute(phase); }, dependencies, phase.Affinity);
+    }
+
+    // Main-thread phases first: waiting on a worker phase could have this thread steal a long job while the
+    // window or device chain sits ready in the main-thread queue.
+    for (const Phase& phase : m_phases)
+    {
+        if (phase.Affinity == JobAffinity::MainThread)
+        {
+            m_jobSystem.Wait(phase.Handle);
+        }
+    }
+    for (const Phase& phase : m_phases)
+    {
+        m_jobSystem.Wait(phase.Handle);
+    }
+
+    LogTimings(m_clock.GetTotalSeconds());
+
+    std::vector<Phase> phases = std::exchange(m_phases, {});
+    for (const Phase& phase : phases)
+    {
+        if (phase.Error)
+        {
+            std::rethrow_exception(phase.Error);
+        }
+    }
+}
+
+void StartupGraph::Execute(Phase& phase)
+{
+    for (const PhaseId dependency : phase.Dependencies)
+    {
+        if (m_phases[dependency].Error || m_phases[dependency].Skipped)
+        {
+            phase.Skipped = true;
+            return;
+        }
+    }
+
+    phase.Start = m_clock.GetTotalSeconds();
+    try
+    {
+        phase.Function();
+    }
+    catch (...)
+    {
+        phase.Error = std::current_exception();
+    }
+    phase.End = m_clock.GetTotalSeconds();
+}
+
+void StartupGraph::LogTimings(double total) const
+{
+    double serial = 0.0;
+    for (const Phase& phase : m_phases)
+    {
+        serial += phase.End - phase.Start;
+    }
+
+    LOG_INFO("Startup: {} phases in {:.1f} ms ({:.1f} ms back to back)",
+             m_phases.size(),
+             total * kMillisecondsPerSecond,
+             serial * kMillisecondsPerSecond);
+
+    for (const Phase& phase : m_phases)
+    {
+        if (phase.Skipped)
+        {
+            LOG_WARN("Startup:   {:<12} skipped after an upstream failure", phase.Name);
+            continue;
+        }
+
+        LOG_INFO("Startup:   {:<12} {:7.1f} ms  [{:7.1f} .. {:7.1f}]{}",
+                 phase.Name,
+                 (phase.End - phase.Start) * kMillisecondsPerSecond,
+                 phase.Start * kMillisecondsPerSecond,
+                 phase.End * kMillisecondsPerSecond,
+                 phase.Error ? " failed" : "");
+    }
+}
+} // namespace Core
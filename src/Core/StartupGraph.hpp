@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "Clock.hpp"
+#include "JobSystem.hpp"
+
+namespace Core
+{
+// Startup expressed as named phases with dependencies, run on the job system so independent phases overlap.
+// Phases that touch the window or the GPU device take MainThread affinity and run on the caller of Run().
+// A phase that throws skips everything downstream of it, and Run() rethrows the first failure once the rest
+// of the graph has settled, so a failed startup still unwinds on the constructing thread.
+class StartupGraph
+{
+public:
+    using PhaseId = uint32_t;
+
+    explicit StartupGraph(JobSystem& jobSystem);
+
+    // Dependencies must have been added before the phase that names them.
+    PhaseId Add(std::string name,
+                std::function<void()> function,
+                std::initializer_list<PhaseId> dependencies = {},
+                JobAffinity affinity = JobAffinity::Any);
+
+    // Runs every phase added so far, waits for all of them and logs when each ran and for how long.
+    void Run();
+
+private:
+    struct Phase
+    {
+        std::string Name;
+        std::function<void()> Function;
+        std::vector<PhaseId> Dependencies;
+        JobAffinity Affinity = JobAffinity::Any;
+        JobHandle Handle;
+
+        double Start = 0.0; // Seconds since Run()
+        double End = 0.0;
+        bool Skipped = false;
+        std::exception_ptr Error;
+    };
+
+    void Execute(Phase& phase);
+    void LogTimings(double total) const;
+
+    JobSystem& m_jobSystem;
+    std::vector<Phase> m_phases;
+    Clock m_clock;
+};
+} // namespace Core
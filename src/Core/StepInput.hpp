@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../Audio/BandReducer.hpp"
+
+namespace Core
+{
+enum class InputEventType : std::uint8_t
+{
+    Resize
+};
+
+struct InputEvent
+{
+    InputEventType Type = InputEventType::Resize;
+    float X = 0.0F;
+    float Y = 0.0F;
+    float Z = 0.0F;
+    float W = 0.0F;
+};
+
+// Everything a single fixed simulation step consumes. Live runs build it from the audio chain and the
+// event pump; replay runs read it back from a recording, so the step itself never touches a device.
+struct StepInput
+{
+    Audio::BandArray Bands{};
+    float Quality = 1.0F; // Solver quality chosen by the scheduler for this step
+    std::vector<InputEvent> Events;
+};
+} // namespace Core
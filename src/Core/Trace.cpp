@@ -0,0 +1,307 @@
+#include "Trace.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Logger.hpp"
+
+namespace Core
+{
+namespace
+{
+constexpr size_t kMaxThreads = 256;       // Ring headers; only the first few get event storage from Start()
+constexpr size_t kFixedThreads = 6;       // Main, audio, simulation, spdlog, BinaryLog and metrics
+constexpr size_t kSpareThreads = 4;       // Threads nobody planned for, such as a device thread after a reconnect
+constexpr size_t kRingEvents = 32 * 1024; // Per thread; power of two
+constexpr uintptr_t kEndBit = 1;          // Low bit of the site pointer: 0 begins a span, 1 ends it
+constexpr double kNanosecondsPerMicrosecond = 1000.0;
+
+static_assert(alignof(TraceSite) > kEndBit, "TraceSite pointers need a free low bit");
+
+// Plain words accessed through std::atomic_ref, so the rings can be allocated without touching (and committing)
+// every page up front.
+struct TraceEvent
+{
+    uint64_t Site; // TraceSite pointer | kEndBit
+    int64_t Time;  // Nanoseconds since Start()
+};
+
+// Written only by the thread that claimed it, read by whichever thread dumps. Events stays null for rings past
+// the count Start() sized the pool for; their threads are named in the dump's warning but record nothing.
+struct ThreadRing
+{
+    std::unique_ptr<TraceEvent[]> Events; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    std::atomic<const char*> Name = nullptr;
+    // Begun is bumped before an event's words are written and Written after, so a dump can tell which of the
+    // events it copied may have been overwritten while it read them.
+    alignas(64) std::atomic<uint64_t> Begun = 0;
+    std::atomic<uint64_t> Written = 0;
+};
+
+struct TraceState
+{
+    std::array<ThreadRing, kMaxThreads> Rings;
+    std::atomic<size_t> ClaimedRings = 0; // May run past kMaxThreads; each thread adds to it once
+    size_t StoredRings = 0;               // Rings with event storage; set by Start() before Enabled
+    std::atomic<bool> Enabled = false;
+    std::atomic<int64_t> Origin = 0; // steady_clock nanoseconds at Start()
+
+    std::mutex DumpMutex; // Start, Stop and Dump only
+    std::string Path;
+};
+
+TraceState& GetState()
+{
+    static TraceState state;
+    return state;
+}
+
+thread_local ThreadRing* t_ring = nullptr;
+thread_local bool t_ringless = false; // Asked once and found the pool exhausted; never asks again
+
+int64_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// The calling thread's ring, claiming one on first use; null if every header was already taken then. Each thread
+// touches the shared claim counter at most once, and nothing here logs, as this runs inside the audio callback.
+// Running out is reported by the next dump.
+ThreadRing* GetRing(TraceState& state)
+{
+    if (!t_ring && !t_ringless)
+    {
+        const size_t index = state.ClaimedRings.fetch_add(1, std::memory_order::relaxed);
+        if (index >= kMaxThreads)
+        {
+            t_ringless = true;
+            return nullptr;
+        }
+        t_ring = &state.Rings[index];
+    }
+    return t_ring;
+}
+
+void Record(const TraceSite& site, uintptr_t phase)
+{
+    TraceState& state = GetState();
+    if (!state.Enabled.load(std::memory_order::acquire))
+    {
+        return;
+    }
+
+    ThreadRing* ring = GetRing(state);
+    if (!ring || !ring->Events)
+    {
+        return;
+    }
+
+    const uint64_t index = ring->Written.load(std::memory_order::relaxed);
+    ring->Begun.store(index + 1, std::memory_order::relaxed);
+    std::atomic_thread_fence(std::memory_order::release);
+
+    TraceEvent& event = ring->Events[index & (kRingEvents - 1)];
+    std::atomic_ref(event.Site).store(reinterpret_cast<uintptr_t>(&site) | phase, // NOLINT(*-reinterpret-cast)
+                                      std::memory_order::relaxed);
+    std::atomic_ref(event.Time).store(Now() - state.Origin.load(std::memory_order::relaxed),
+                                      std::memory_order::relaxed);
+
+    ring->Written.store(index + 1, std::memory_order::release);
+}
+
+// Copies the events of ring that were not overwritten during the copy, oldest first.
+std::vector<TraceEvent> Snapshot(ThreadRing& ring)
+{
+    const uint64_t written = ring.Written.load(std::memory_order::acquire);
+    const uint64_t first = written > kRingEvents ? written - kRingEvents : 0;
+
+    std::vector<TraceEvent> events;
+    events.reserve(written - first);
+    for (uint64_t i = first; i < written; ++i)
+    {
+        TraceEvent& event = ring.Events[i & (kRingEvents - 1)];
+        events.push_back(TraceEvent{.Site = std::atomic_ref(event.Site).load(std::memory_order::relaxed),
+                                    .Time = std::atomic_ref(event.Time).load(std::memory_order::relaxed)});
+    }
+
+    std::atomic_thread_fence(std::memory_order::acquire);
+    const uint64_t begun = ring.Begun.load(std::memory_order::relaxed);
+    const uint64_t firstIntact = std::clamp(begun > kRingEvents ? begun - kRingEvents : 0, first, written);
+    events.erase(events.begin(), events.begin() + static_cast<ptrdiff_t>(firstIntact - first));
+    return events;
+}
+
+void AppendEscaped(fmt::memory_buffer& out, std::string_view text)
+{
+    for (const char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out.push_back('\\');
+        }
+        out.push_back(c);
+    }
+}
+
+// Chrome trace JSON: one "B"/"E" pair per span, timestamps in microseconds, one track per ring.
+void Write(TraceState& state)
+{
+    fmt::memory_buffer out;
+    fmt::format_to(fmt::appender(out), R"({{"displayTimeUnit":"ms","traceEvents":[)");
+
+    size_t eventCount = 0;
+    size_t threadCount = 0;
+    const char* separator = "\n";
+    const size_t claimed = state.ClaimedRings.load(std::memory_order::relaxed);
+    const size_t stored = std::min(claimed, state.StoredRings);
+
+    for (size_t tid = 0; tid < stored; ++tid)
+    {
+        ThreadRing& ring = state.Rings[tid];
+        const std::vector<TraceEvent> events = Snapshot(ring);
+
+        const char* name = ring.Name.load(std::memory_order::relaxed);
+        fmt::format_to(fmt::appender(out),
+                       R"({}{{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":")",
+                       separator,
+                       tid);
+        AppendEscaped(out, name ? std::string_view(name) : fmt::format("Thread {}", tid));
+        fmt::format_to(fmt::appender(out), R"("}}}})");
+        separator = ",\n";
+
+        // The ring may have dropped the begin of the oldest spans; an end with nothing open would confuse viewers.
+        size_t depth = 0;
+        for (const TraceEvent& event : events)
+        {
+            const bool end = (event.Site & kEndBit) != 0;
+            if (end && depth == 0)
+            {
+                continue;
+            }
+            depth = end ? depth - 1 : depth + 1;
+
+            const auto* site = reinterpret_cast<const TraceSite*>(event.Site & ~kEndBit); // NOLINT(*-reinterpret-cast)
+            fmt::format_to(fmt::appender(out), R"({}{{"name":")", separator);
+            AppendEscaped(out, site->Name);
+            fmt::format_to(fmt::appender(out), R"(","cat":")");
+            AppendEscaped(out, site->Category);
+            fmt::format_to(fmt::appender(out),
+                           R"(","ph":"{}","pid":1,"tid":{},"ts":{:.3f}}})",
+                           end ? 'E' : 'B',
+                           tid,
+                           static_cast<double>(event.Time) / kNanosecondsPerMicrosecond);
+            ++eventCount;
+        }
+        ++threadCount;
+    }
+    fmt::format_to(fmt::appender(out), "\n]}}\n");
+
+    std::ofstream file(state.Path, std::ios::binary | std::ios::trunc);
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    if (!file)
+    {
+        LOG_ERROR("Trace: Failed to write '{}'", state.Path);
+        return;
+    }
+
+    LOG_INFO("Trace: Wrote {} events from {} threads to '{}'", eventCount, threadCount, state.Path);
+
+    if (claimed > stored)
+    {
+        std::string missing;
+        for (size_t tid = stored; tid < std::min(claimed, kMaxThreads); ++tid)
+        {
+            const char* name = state.Rings[tid].Name.load(std::memory_order::relaxed);
+            missing += fmt::format("{}{}", missing.empty() ? "" : ", ", name ? name : "unnamed");
+        }
+        LOG_WARN("Trace: {} threads found no ring and are missing from the trace ({}); {} rings were allocated",
+                 claimed - stored,
+                 missing,
+                 stored);
+    }
+}
+} // namespace
+
+void Trace::Start(std::string path, size_t workerThreads)
+{
+    TraceState& state = GetState();
+    const std::scoped_lock lock(state.DumpMutex);
+
+#if !defined(AF_TRACING)
+    LOG_WARN("Trace: Built without ACOUSTIC_FLUIDS_TRACING, the trace will hold no spans");
+#endif
+
+    // Storage for every thread the engine runs, so the workers of a many-core machine cannot crowd out the audio
+    // callback. Rings are never freed or moved, as a thread may be mid-event in one.
+    const size_t wanted = std::min(workerThreads + kFixedThreads + kSpareThreads, kMaxThreads);
+    state.StoredRings = std::max(state.StoredRings, wanted);
+    for (size_t i = 0; i < state.StoredRings; ++i)
+    {
+        ThreadRing& ring = state.Rings[i];
+        if (!ring.Events)
+        {
+            ring.Events = std::make_unique_for_overwrite<TraceEvent[]>(kRingEvents); // NOLINT(*-avoid-c-arrays)
+        }
+    }
+
+    state.Path = std::move(path);
+    state.Origin.store(Now(), std::memory_order::relaxed);
+    state.Enabled.store(true, std::memory_order::release);
+    LOG_INFO("Trace: Recording to '{}'", state.Path);
+}
+
+void Trace::Stop()
+{
+    TraceState& state = GetState();
+    const std::scoped_lock lock(state.DumpMutex);
+    if (!state.Enabled.exchange(false, std::memory_order::acq_rel))
+    {
+        return;
+    }
+    Write(state);
+}
+
+void Trace::Dump()
+{
+    TraceState& state = GetState();
+    const std::scoped_lock lock(state.DumpMutex);
+    if (!state.Enabled.load(std::memory_order::acquire))
+    {
+        return;
+    }
+    Write(state);
+}
+
+void Trace::NameThread(const char* name)
+{
+    if (ThreadRing* ring = GetRing(GetState()))
+    {
+        ring->Name.store(name, std::memory_order::relaxed);
+    }
+}
+
+void Trace::Begin(const TraceSite& site)
+{
+    Record(site, 0);
+}
+
+void Trace::End(const TraceSite& site)
+{
+    Record(site, kEndBit);
+}
+} // namespace Core
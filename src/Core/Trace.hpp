@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace Core
+{
+// One per TRACE_SCOPE, in static storage; its address identifies the span in the recorded events.
+struct TraceSite
+{
+    std::string_view Name;
+    std::string_view Category;
+};
+
+// Timeline recorder for seeing how threads interleave. Begin and End store the site pointer and a timestamp into
+// a ring owned by the calling thread: a pool of rings sized for the engine's threads is allocated by Start(), and a
+// thread claims one with a single atomic increment the first time it records, so recording takes no lock, never
+// allocates and never logs, including inside the audio callback. Rings overwrite their oldest events, so a dump
+// holds the most recent history of each thread. Dumps are Chrome trace JSON, which chrome://tracing and the
+// Perfetto UI both open.
+class Trace
+{
+public:
+    // Records until Stop(); path is where Dump() and Stop() write. The pool holds a ring for each of workerThreads
+    // plus the engine's fixed threads; threads beyond that are reported by the dumps.
+    static void Start(std::string path, size_t workerThreads);
+    // Writes a final dump and stops recording. The rings stay allocated, as a thread may still be mid-event.
+    static void Stop();
+    // Writes what the rings currently hold without stopping.
+    static void Dump();
+
+    // Labels the calling thread's track; name must have static storage. Safe on real-time threads.
+    static void NameThread(const char* name);
+
+    static void Begin(const TraceSite& site);
+    static void End(const TraceSite& site);
+};
+
+class TraceScope
+{
+public:
+    explicit TraceScope(const TraceSite& site) : m_site(site) { Trace::Begin(site); }
+    ~TraceScope() { Trace::End(m_site); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    TraceScope(TraceScope&&) = delete;
+    TraceScope& operator=(TraceScope&&) = delete;
+
+private:
+    const TraceSite& m_site;
+};
+} // namespace Core
+
+// TRACE_SCOPE(name, category) records the enclosing scope as one span; both arguments must be string literals.
+// Compiled out unless AF_TRACING is defined.
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#if defined(AF_TRACING)
+#define AF_TRACE_CONCAT_IMPL(a, b) a##b
+#define AF_TRACE_CONCAT(a, b) AF_TRACE_CONCAT_IMPL(a, b)
+#define TRACE_SCOPE(name, category)                                                                                   \
+    static constexpr ::Core::TraceSite AF_TRACE_CONCAT(afTraceSite, __LINE__){.Name = (name), .Category = (category)}; \
+    const ::Core::TraceScope AF_TRACE_CONCAT(afTraceScope, __LINE__)(AF_TRACE_CONCAT(afTraceSite, __LINE__))
+#else
+#define TRACE_SCOPE(name, category) (void)0
+#endif
+// NOLINTEND(cppcoreguidelines-macro-usage)
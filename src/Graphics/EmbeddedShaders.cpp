@@ -0,0 +1,33 @@
+#include "EmbeddedShaders.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "Shader.hpp"
+
+namespace Graphics
+{
+namespace
+{
+#if defined(AF_EMBEDDED_SHADERS)
+// Generated at build time: the bytecode arrays and kEmbeddedShaders.
+#include "EmbeddedShaderData.inl"
+#else
+constexpr std::array<EmbeddedShader, 0> kEmbeddedShaders{};
+#endif
+} // namespace
+
+std::span<const EmbeddedShader> GetEmbeddedShaders()
+{
+    return kEmbeddedShaders;
+}
+
+const EmbeddedShader* FindEmbeddedShader(std::string_view path)
+{
+    const auto it = std::ranges::find(kEmbeddedShaders, path, &EmbeddedShader::Path);
+    return it != kEmbeddedShaders.end() ? &*it : nullptr;
+}
+} // namespace Graphics
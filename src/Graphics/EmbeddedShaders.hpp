@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "Shader.hpp"
+
+namespace Graphics
+{
+// A shader compiled to SPIR-V and reflected by the build (tools/ShaderBaker), linked into the executable.
+struct EmbeddedShader
+{
+    std::string_view Path; // Source it was compiled from, relative to the repository root
+    ShaderStage Stage = ShaderStage::Vertex;
+    std::span<const uint8_t> Bytecode;
+    ShaderResources Resources;
+};
+
+// Empty when the build was configured without ACOUSTIC_FLUIDS_EMBED_SHADERS.
+[[nodiscard]] std::span<const EmbeddedShader> GetEmbeddedShaders();
+
+// The embedded shader compiled from path, or null.
+[[nodiscard]] const EmbeddedShader* FindEmbeddedShader(std::string_view path);
+} // namespace Graphics
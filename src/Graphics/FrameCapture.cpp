@@ -0,0 +1,207 @@
+#include "FrameCapture.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+
+#include "../Core/Logger.hpp"
+#include "FrameWriter.hpp"
+#include "GPUContext.hpp"
+
+namespace Graphics
+{
+namespace
+{
+constexpr uint32_t kBytesPerPixel = 4;
+} // namespace
+
+FrameCapture::FrameCapture(GPUContext* context, const FrameCaptureSettings& settings)
+    : m_context(context), m_width(settings.Writer.Width), m_height(settings.Writer.Height)
+{
+    SDL_GPUDevice* device = m_context->GetDevice();
+    const auto format = static_cast<SDL_GPUTextureFormat>(m_context->GetSwapchainFormat());
+
+    // The target must match the format the renderer's pipelines were built for, so only 8-bit swapchains work.
+    const bool bgra =
+        format == SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM || format == SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM_SRGB;
+    const bool rgba =
+        format == SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM || format == SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM_SRGB;
+    if (!bgra && !rgba)
+    {
+        LOG_ERROR("FrameCapture: Swapchain format {} is not 8-bit RGBA or BGRA", static_cast<uint32_t>(format));
+        throw std::runtime_error("FrameCapture: Unsupported Swapchain Format");
+    }
+
+    FrameWriterSettings writerSettings = settings.Writer;
+    writerSettings.SwapRedBlue = bgra;
+    m_writer = std::make_unique<FrameWriter>(writerSettings);
+
+    // Sampler usage makes it a valid blit source for presenting.
+    const SDL_GPUTextureCreateInfo targetInfo{
+        .type = SDL_GPU_TEXTURETYPE_2D,
+        .format = format,
+        .usage = SDL_GPU_TEXTUREUSAGE_COLOR_TARGET | SDL_GPU_TEXTUREUSAGE_SAMPLER,
+        .width = m_width,
+        .height = m_height,
+        .layer_count_or_depth = 1,
+        .num_levels = 1,
+        .sample_count = SDL_GPU_SAMPLECOUNT_1};
+    m_target = SDL_CreateGPUTexture(device, &targetInfo);
+    if (!m_target)
+    {
+        LOG_ERROR("FrameCapture: Failed to create capture target: {}", SDL_GetError());
+        throw std::runtime_error("Capture Target Creation Failed");
+    }
+    SDL_SetGPUTextureName(device, m_target, "CaptureTarget");
+
+    const SDL_GPUTransferBufferCreateInfo bufferInfo{.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD,
+                                                     .size = m_width * m_height * kBytesPerPixel};
+    m_slots.resize(settings.ReadbackSlots);
+    for (Slot& slot : m_slots)
+    {
+        slot.Buffer = SDL_CreateGPUTransferBuffer(device, &bufferInfo);
+        if (!slot.Buffer)
+        {
+            LOG_ERROR("FrameCapture: Failed to create readback buffer: {}", SDL_GetError());
+            throw std::runtime_error("Transfer Buffer Creation Failed");
+        }
+    }
+
+    LOG_INFO("FrameCapture: {} readback slots of {} KiB", m_slots.size(), bufferInfo.size / 1024);
+}
+
+FrameCapture::~FrameCapture()
+{
+    SDL_GPUDevice* device = m_context->GetDevice();
+
+    // Shutdown may wait: whatever is still on the GPU is part of the clip.
+    for (size_t i = 0; i < m_slots.size(); ++i)
+    {
+        Slot& slot = m_slots[m_readSlot];
+        if (slot.InFlight && slot.Fence)
+        {
+            SDL_WaitForGPUFences(device, true, &slot.Fence, 1);
+        }
+        Retire(slot, slot.Fence != nullptr);
+        m_readSlot = (m_readSlot + 1) % static_cast<uint32_t>(m_slots.size());
+    }
+
+    for (const Slot& slot : m_slots)
+    {
+        if (slot.Buffer)
+        {
+            SDL_ReleaseGPUTransferBuffer(device, slot.Buffer);
+        }
+    }
+    if (m_target)
+    {
+        SDL_ReleaseGPUTexture(device, m_target);
+    }
+
+    if (m_skipped > 0)
+    {
+        LOG_WARN("FrameCapture: {} frames found no free readback slot", m_skipped);
+    }
+}
+
+SDL_GPUTexture* FrameCapture::GetTarget() const
+{
+    return m_target;
+}
+
+void FrameCapture::Poll()
+{
+    SDL_GPUDevice* device = m_context->GetDevice();
+
+    for (size_t i = 0; i < m_slots.size(); ++i)
+    {
+        Slot& slot = m_slots[m_readSlot];
+        if (!slot.InFlight || (slot.Fence && !SDL_QueryGPUFence(device, slot.Fence)))
+        {
+            return;
+        }
+
+        // No fence means the submit failed and the download never ran.
+        Retire(slot, slot.Fence != nullptr);
+        m_readSlot = (m_readSlot + 1) % static_cast<uint32_t>(m_slots.size());
+    }
+}
+
+bool FrameCapture::Record(SDL_GPUCommandBuffer* cmd,
+                          SDL_GPUTexture* swapchain,
+                          uint32_t swapchainWidth,
+                          uint32_t swapchainHeight)
+{
+    if (swapchain)
+    {
+        SDL_GPUBlitInfo blit{};
+        blit.source = SDL_GPUBlitRegion{.texture = m_target, .w = m_width, .h = m_height};
+        blit.destination = SDL_GPUBlitRegion{.texture = swapchain, .w = swapchainWidth, .h = swapchainHeight};
+        blit.load_op = SDL_GPU_LOADOP_DONT_CARE;
+        blit.filter = SDL_GPU_FILTER_LINEAR;
+        SDL_BlitGPUTexture(cmd, &blit);
+    }
+
+    Slot& slot = m_slots[m_recordSlot];
+    if (slot.InFlight)
+    {
+        ++m_skipped;
+        return false;
+    }
+
+    SDL_GPUCopyPass* pass = SDL_BeginGPUCopyPass(cmd);
+    const SDL_GPUTextureRegion source{.texture = m_target, .w = m_width, .h = m_height, .d = 1};
+    const SDL_GPUTextureTransferInfo destination{.transfer_buffer = slot.Buffer, .offset = 0};
+    SDL_DownloadFromGPUTexture(pass, &source, &destination);
+    SDL_EndGPUCopyPass(pass);
+
+    slot.CaptureTimeNs = SDL_GetTicksNS();
+    slot.InFlight = true;
+    return true;
+}
+
+void FrameCapture::Submitted(SDL_GPUFence* fence)
+{
+    m_slots[m_recordSlot].Fence = fence;
+    m_recordSlot = (m_recordSlot + 1) % static_cast<uint32_t>(m_slots.size());
+}
+
+void FrameCapture::Retire(Slot& slot, bool keep)
+{
+    if (!slot.InFlight)
+    {
+        return;
+    }
+
+    SDL_GPUDevice* device = m_context->GetDevice();
+    const void* mapped = keep ? SDL_MapGPUTransferBuffer(device, slot.Buffer, false) : nullptr;
+
+    if (mapped)
+    {
+        // An empty frame means the writer is backed up; the writer counts the drop.
+        const std::span<std::byte> frame = m_writer->BeginFrame();
+        if (!frame.empty())
+        {
+            std::memcpy(frame.data(), mapped, frame.size());
+            m_writer->EndFrame(slot.CaptureTimeNs);
+        }
+        SDL_UnmapGPUTransferBuffer(device, slot.Buffer);
+    }
+    else if (keep)
+    {
+        LOG_ERROR("FrameCapture: Failed to map readback buffer: {}", SDL_GetError());
+    }
+
+    if (slot.Fence)
+    {
+        SDL_ReleaseGPUFence(device, slot.Fence);
+        slot.Fence = nullptr;
+    }
+    slot.InFlight = false;
+}
+} // namespace Graphics
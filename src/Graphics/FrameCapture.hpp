@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "FrameWriter.hpp"
+
+struct SDL_GPUCommandBuffer;
+struct SDL_GPUFence;
+struct SDL_GPUTexture;
+struct SDL_GPUTransferBuffer;
+
+namespace Graphics
+{
+class GPUContext;
+
+struct FrameCaptureSettings
+{
+    FrameWriterSettings Writer; // Width and Height set the capture resolution
+    uint32_t ReadbackSlots = 3; // Downloads in flight; a frame is read back once its slot's fence signals
+};
+
+// Reads rendered frames back without stalling. While capturing, the renderer draws into an offscreen target
+// that is blitted to the swapchain for display and downloaded into the next of a ring of transfer buffers.
+// Each frame's command buffer is submitted with a fence, and the slot is only mapped, a few frames later, once
+// that fence has signalled; its pixels are then copied into the writer's pool and encoded on its thread. When
+// every slot is in flight or the writer is backed up the frame is dropped rather than waited for; frames carry
+// their capture time, so the writer fills the hole by repeating the previous frame and the clip keeps real time.
+class FrameCapture
+{
+public:
+    FrameCapture(GPUContext* context, const FrameCaptureSettings& settings);
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+    FrameCapture(FrameCapture&&) = delete;
+    FrameCapture& operator=(FrameCapture&&) = delete;
+
+    // Where the renderer draws this frame instead of the swapchain.
+    [[nodiscard]] SDL_GPUTexture* GetTarget() const;
+
+    // Hands every finished download to the writer. Never waits on the GPU.
+    void Poll();
+
+    // Presents the target on the swapchain (if any) and records its download. Returns whether a download was
+    // recorded, in which case the frame must be submitted with a fence and that fence passed to Submitted.
+    bool Record(SDL_GPUCommandBuffer* cmd,
+                SDL_GPUTexture* swapchain,
+                uint32_t swapchainWidth,
+                uint32_t swapchainHeight);
+    void Submitted(SDL_GPUFence* fence);
+
+private:
+    struct Slot
+    {
+        SDL_GPUTransferBuffer* Buffer = nullptr;
+        SDL_GPUFence* Fence = nullptr;
+        uint64_t CaptureTimeNs = 0;
+        bool InFlight = false;
+    };
+
+    void Retire(Slot& slot, bool keep);
+
+    GPUContext* m_context;
+    uint32_t m_width;
+    uint32_t m_height;
+    SDL_GPUTexture* m_target = nullptr;
+    std::vector<Slot> m_slots;
+    uint32_t m_recordSlot = 0; // Next slot to download into
+    uint32_t m_readSlot = 0;   // Oldest slot in flight; slots retire in submission order
+    uint64_t m_skipped = 0;    // Frames with no free slot
+
+    std::unique_ptr<FrameWriter> m_writer;
+};
+} // namespace Graphics
@@ -0,0 +1,313 @@
+#include "FrameWriter.hpp"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include <spdlog/fmt/fmt.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ios>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "../Core/Logger.hpp"
+
+namespace Graphics
+{
+namespace
+{
+constexpr size_t kBytesPerPixel = 4;
+constexpr int kPngChannels = 3; // Alpha is dropped; the swapchain's is meaningless
+constexpr uint64_t kNanosecondsPerSecond = 1'000'000'000;
+
+// BT.601 limited range, 8-bit fixed point.
+[[nodiscard]] uint8_t Luma(int r, int g, int b)
+{
+    return static_cast<uint8_t>((((66 * r) + (129 * g) + (25 * b) + 128) >> 8) + 16);
+}
+
+[[nodiscard]] uint8_t ChromaBlue(int r, int g, int b)
+{
+    return static_cast<uint8_t>((((-38 * r) - (74 * g) + (112 * b) + 128) >> 8) + 128);
+}
+
+[[nodiscard]] uint8_t ChromaRed(int r, int g, int b)
+{
+    return static_cast<uint8_t>((((112 * r) - (94 * g) - (18 * b) + 128) >> 8) + 128);
+}
+} // namespace
+
+FrameWriter::FrameWriter(const FrameWriterSettings& settings)
+    : m_settings(settings), m_frameBytes(static_cast<size_t>(settings.Width) * settings.Height * kBytesPerPixel)
+{
+    const bool oddSize = settings.Width % 2 != 0 || settings.Height % 2 != 0;
+    if (m_frameBytes == 0 || settings.PoolSize == 0 || (settings.Format == CaptureFormat::Y4M && oddSize))
+    {
+        LOG_ERROR("FrameWriter: Invalid {}x{} capture with {} buffers", settings.Width, settings.Height, settings.PoolSize);
+        throw std::invalid_argument("FrameWriter: Invalid Settings");
+    }
+
+    if (settings.Format == CaptureFormat::Y4M)
+    {
+        m_stream.open(settings.Path, std::ios::binary | std::ios::trunc);
+        if (!m_stream.is_open())
+        {
+            LOG_ERROR("FrameWriter: Failed to open '{}'", settings.Path);
+            throw std::runtime_error("Capture File Open Failed");
+        }
+
+        m_stream << fmt::format(
+            "YUV4MPEG2 W{} H{} F{}:1 Ip A1:1 C420jpeg\n", settings.Width, settings.Height, settings.FrameRate);
+        m_planes.resize(m_frameBytes / kBytesPerPixel * 3 / 2);
+    }
+
+    m_frames.resize(settings.PoolSize);
+    m_free.reserve(settings.PoolSize);
+    for (uint32_t i = 0; i < settings.PoolSize; ++i)
+    {
+        m_frames[i].resize(m_frameBytes);
+        m_free.push_back(i);
+    }
+    m_queue.resize(settings.PoolSize);
+
+    m_thread = std::jthread([this](const std::stop_token& stopToken) { Run(stopToken); });
+
+    LOG_INFO("FrameWriter: Capturing {}x{} to '{}' ({})",
+             settings.Width,
+             settings.Height,
+             settings.Path,
+             settings.Format == CaptureFormat::Y4M ? "Y4M" : "PNG sequence");
+}
+
+FrameWriter::~FrameWriter()
+{
+    // The writer drains whatever is queued before it sees the stop.
+    m_thread.request_stop();
+    m_thread.join();
+
+    const uint64_t written = m_written.load();
+    LOG_INFO("FrameWriter: Wrote {} frames ({:.1f} s at {} fps): {} captured, {} repeated to fill gaps, {} skipped "
+             "ahead of the frame rate, {} dropped",
+             written,
+             static_cast<double>(written) / m_settings.FrameRate,
+             m_settings.FrameRate,
+             m_encoded,
+             m_repeated,
+             m_superseded,
+             m_dropped);
+}
+
+std::span<std::byte> FrameWriter::BeginFrame()
+{
+    const std::scoped_lock lock(m_mutex);
+    if (m_free.empty())
+    {
+        ++m_dropped;
+        return {};
+    }
+
+    m_current = m_free.back();
+    m_free.pop_back();
+    return m_frames[m_current];
+}
+
+void FrameWriter::EndFrame(uint64_t captureTimeNs)
+{
+    {
+        const std::scoped_lock lock(m_mutex);
+        m_queue[(m_queueHead + m_queueCount) % m_queue.size()] =
+            QueuedFrame{.Buffer = m_current, .CaptureTimeNs = captureTimeNs};
+        ++m_queueCount;
+    }
+    m_condition.notify_one();
+}
+
+uint64_t FrameWriter::GetWrittenCount() const
+{
+    return m_written.load();
+}
+
+uint64_t FrameWriter::GetDroppedCount() const
+{
+    return m_dropped;
+}
+
+void FrameWriter::Run(const std::stop_token& stopToken)
+{
+    while (true)
+    {
+        QueuedFrame frame;
+        {
+            std::unique_lock lock(m_mutex);
+            if (!m_condition.wait(lock, stopToken, [this] { return m_queueCount > 0; }))
+            {
+                return;
+            }
+
+            frame = m_queue[m_queueHead];
+            m_queueHead = (m_queueHead + 1) % static_cast<uint32_t>(m_queue.size());
+            --m_queueCount;
+        }
+
+        Encode(m_frames[frame.Buffer], frame.CaptureTimeNs);
+
+        const std::scoped_lock lock(m_mutex);
+        m_free.push_back(frame.Buffer);
+    }
+}
+
+void FrameWriter::Encode(std::span<std::byte> pixels, uint64_t captureTimeNs)
+{
+    const uint64_t written = m_written.load();
+    if (written == 0)
+    {
+        m_originNs = captureTimeNs;
+    }
+
+    // Nearest slot on the timeline; earlier slots still empty get the previous frame again.
+    const uint64_t elapsedNs = captureTimeNs > m_originNs ? captureTimeNs - m_originNs : 0;
+    const uint64_t slot = ((elapsedNs * m_settings.FrameRate) + (kNanosecondsPerSecond / 2)) / kNanosecondsPerSecond;
+    if (written > 0 && slot < written)
+    {
+        ++m_superseded;
+        return;
+    }
+    if (slot > written)
+    {
+        Repeat(slot - written);
+    }
+
+    if (m_settings.SwapRedBlue)
+    {
+        for (size_t i = 0; i < pixels.size(); i += kBytesPerPixel)
+        {
+            std::swap(pixels[i], pixels[i + 2]);
+        }
+    }
+
+    if (m_settings.Format == CaptureFormat::Y4M)
+    {
+        WriteY4M(pixels);
+    }
+    else
+    {
+        WritePng(pixels);
+    }
+
+    ++m_written;
+    ++m_encoded;
+}
+
+void FrameWriter::Repeat(uint64_t count)
+{
+    if (m_settings.Format == CaptureFormat::Y4M)
+    {
+        // m_planes still holds the previous frame.
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            AppendY4MFrame();
+        }
+    }
+    else
+    {
+        const std::string previous = fmt::format("{}{:06}.png", m_settings.Path, m_written.load() - 1);
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            const std::string path = fmt::format("{}{:06}.png", m_settings.Path, m_written.load() + i);
+            std::error_code error;
+            std::filesystem::copy_file(previous, path, std::filesystem::copy_options::overwrite_existing, error);
+            if (error)
+            {
+                LOG_ERROR("FrameWriter: Failed to write '{}': {}", path, error.message());
+            }
+        }
+    }
+
+    m_written += count;
+    m_repeated += count;
+}
+
+void FrameWriter::WritePng(std::span<std::byte> pixels)
+{
+    // Packs RGBA to RGB in place; each write lands at or before the pixel it reads.
+    const size_t pixelCount = pixels.size() / kBytesPerPixel;
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        pixels[(i * kPngChannels) + 0] = pixels[(i * kBytesPerPixel) + 0];
+        pixels[(i * kPngChannels) + 1] = pixels[(i * kBytesPerPixel) + 1];
+        pixels[(i * kPngChannels) + 2] = pixels[(i * kBytesPerPixel) + 2];
+    }
+
+    const std::string path = fmt::format("{}{:06}.png", m_settings.Path, m_written.load());
+    const auto width = static_cast<int>(m_settings.Width);
+
+    if (!stbi_write_png(
+            path.c_str(), width, static_cast<int>(m_settings.Height), kPngChannels, pixels.data(), width * kPngChannels))
+    {
+        LOG_ERROR("FrameWriter: Failed to write '{}'", path);
+    }
+}
+
+void FrameWriter::WriteY4M(std::span<const std::byte> pixels)
+{
+    const uint32_t width = m_settings.Width;
+    const uint32_t height = m_settings.Height;
+    const size_t lumaBytes = static_cast<size_t>(width) * height;
+    const std::span<uint8_t> luma = std::span(m_planes).first(lumaBytes);
+    const std::span<uint8_t> blue = std::span(m_planes).subspan(lumaBytes, lumaBytes / 4);
+    const std::span<uint8_t> red = std::span(m_planes).subspan(lumaBytes + (lumaBytes / 4), lumaBytes / 4);
+
+    const auto channel = [pixels, width](uint32_t x, uint32_t y, size_t c) {
+        return std::to_integer<int>(pixels[((static_cast<size_t>(y) * width + x) * kBytesPerPixel) + c]);
+    };
+
+    // Chroma from the mean of each 2x2 block, sited at its centre as C420jpeg declares.
+    for (uint32_t y = 0; y < height; y += 2)
+    {
+        for (uint32_t x = 0; x < width; x += 2)
+        {
+            int sumR = 0;
+            int sumG = 0;
+            int sumB = 0;
+
+            for (uint32_t dy = 0; dy < 2; ++dy)
+            {
+                for (uint32_t dx = 0; dx < 2; ++dx)
+                {
+                    const int r = channel(x + dx, y + dy, 0);
+                    const int g = channel(x + dx, y + dy, 1);
+                    const int b = channel(x + dx, y + dy, 2);
+                    luma[(static_cast<size_t>(y + dy) * width) + x + dx] = Luma(r, g, b);
+                    sumR += r;
+                    sumG += g;
+                    sumB += b;
+                }
+            }
+
+            const size_t chroma = (static_cast<size_t>(y / 2) * (width / 2)) + (x / 2);
+            blue[chroma] = ChromaBlue((sumR + 2) / 4, (sumG + 2) / 4, (sumB + 2) / 4);
+            red[chroma] = ChromaRed((sumR + 2) / 4, (sumG + 2) / 4, (sumB + 2) / 4);
+        }
+    }
+
+    AppendY4MFrame();
+}
+
+void FrameWriter::AppendY4MFrame()
+{
+    m_stream << "FRAME\n";
+    m_stream.write(reinterpret_cast<const char*>(m_planes.data()), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                   static_cast<std::streamsize>(m_planes.size()));
+    if (!m_stream)
+    {
+        LOG_ERROR("FrameWriter: Failed to append to '{}'", m_settings.Path);
+    }
+}
+} // namespace Graphics
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Graphics
+{
+enum class CaptureFormat : std::uint8_t
+{
+    PngSequence, // One numbered PNG per frame, Path used as the name prefix
+    Y4M          // A single YUV4MPEG2 stream (4:2:0, BT.601 limited range) at Path
+};
+
+struct FrameWriterSettings
+{
+    std::string Path;
+    CaptureFormat Format = CaptureFormat::PngSequence;
+    uint32_t Width = 0; // Must be even for Y4M
+    uint32_t Height = 0;
+    uint32_t FrameRate = 60;  // Rate of the clip's timeline; written into the Y4M header
+    bool SwapRedBlue = false; // Frames arrive as BGRA8 rather than RGBA8
+    uint32_t PoolSize = 6;    // Frames that can wait for the writer before new ones are dropped
+};
+
+// Encodes captured frames on a background thread. Frame memory comes from a fixed pool: the producer borrows a
+// buffer, fills it and queues it, and when every buffer is still waiting to be written the producer is told so
+// and drops its frame instead of waiting. Queued frames are finished before destruction returns.
+//
+// Frames arrive at whatever rate the display runs and some are dropped, so each is stamped with its capture time
+// and placed on a timeline of exactly FrameRate frames per second: a frame whose slot is already filled is
+// skipped, and slots nothing arrived for repeat the previous frame. The clip therefore plays back in real time,
+// in step with the audio it was reacting to, whatever the render rate was.
+class FrameWriter
+{
+public:
+    explicit FrameWriter(const FrameWriterSettings& settings);
+    ~FrameWriter();
+
+    FrameWriter(const FrameWriter&) = delete;
+    FrameWriter& operator=(const FrameWriter&) = delete;
+    FrameWriter(FrameWriter&&) noexcept = delete;
+    FrameWriter& operator=(FrameWriter&&) noexcept = delete;
+
+    // Width * Height * 4 bytes to fill, or empty when the pool is exhausted. Single producer only.
+    [[nodiscard]] std::span<std::byte> BeginFrame();
+    // Queues the buffer from the last successful BeginFrame, captured at captureTimeNs on any monotonic clock.
+    void EndFrame(uint64_t captureTimeNs);
+
+    // Frames in the clip, repeats included.
+    [[nodiscard]] uint64_t GetWrittenCount() const;
+    [[nodiscard]] uint64_t GetDroppedCount() const;
+
+private:
+    struct QueuedFrame
+    {
+        uint32_t Buffer = 0;
+        uint64_t CaptureTimeNs = 0;
+    };
+
+    void Run(const std::stop_token& stopToken);
+    void Encode(std::span<std::byte> pixels, uint64_t captureTimeNs);
+    void Repeat(uint64_t count);
+    void WritePng(std::span<std::byte> pixels);
+    void WriteY4M(std::span<const std::byte> pixels);
+    void AppendY4MFrame();
+
+    FrameWriterSettings m_settings;
+    size_t m_frameBytes;
+    std::vector<std::vector<std::byte>> m_frames;
+
+    std::mutex m_mutex;
+    std::condition_variable_any m_condition;
+    std::vector<uint32_t> m_free;
+    std::vector<QueuedFrame> m_queue; // Ring of PoolSize entries
+    uint32_t m_queueHead = 0;
+    uint32_t m_queueCount = 0;
+    uint32_t m_current = 0; // Buffer handed out by BeginFrame
+    std::atomic<uint64_t> m_written = 0;
+    uint64_t m_dropped = 0; // Producer only
+
+    // Writer thread only.
+    std::ofstream m_stream;
+    std::vector<uint8_t> m_planes; // Last Y4M frame, kept for repeats
+    uint64_t m_originNs = 0;       // Capture time of the first frame, the start of the timeline
+    uint64_t m_encoded = 0;        // Distinct frames in the clip
+    uint64_t m_repeated = 0;       // Slots filled with the previous frame
+    uint64_t m_superseded = 0;     // Frames skipped because their slot was already filled
+
+    std::jthread m_thread;
+};
+} // namespace Graphics
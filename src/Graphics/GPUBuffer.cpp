@@ -0,0 +1,71 @@
+#include "GPUBuffer.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "../Core/Logger.hpp"
+
+namespace Graphics
+{
+GPUBuffer::GPUBuffer(SDL_GPUDevice* device, uint32_t size, uint32_t usage, const char* debugName)
+    : m_device(device), m_size(size)
+{
+    const SDL_PropertiesID props = SDL_CreateProperties();
+    SDL_SetStringProperty(props, SDL_PROP_GPU_BUFFER_CREATE_NAME_STRING, debugName);
+
+    const SDL_GPUBufferCreateInfo createInfo{.usage = usage, .size = size, .props = props};
+    m_handle = SDL_CreateGPUBuffer(m_device, &createInfo);
+
+    SDL_DestroyProperties(props);
+
+    if (!m_handle)
+    {
+        LOG_ERROR("GPUBuffer: Failed to create buffer '{}': {}", debugName, SDL_GetError());
+        throw std::runtime_error("Buffer Creation Failed");
+    }
+}
+
+GPUBuffer::~GPUBuffer()
+{
+    Release();
+}
+
+GPUBuffer::GPUBuffer(GPUBuffer&& other) noexcept
+    : m_device(other.m_device), m_handle(std::exchange(other.m_handle, nullptr)), m_size(other.m_size)
+{
+}
+
+GPUBuffer& GPUBuffer::operator=(GPUBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        m_device = other.m_device;
+        m_handle = std::exchange(other.m_handle, nullptr);
+        m_size = other.m_size;
+    }
+    return *this;
+}
+
+SDL_GPUBuffer* GPUBuffer::GetHandle() const
+{
+    return m_handle;
+}
+
+uint32_t GPUBuffer::GetSize() const
+{
+    return m_size;
+}
+
+void GPUBuffer::Release()
+{
+    if (m_handle)
+    {
+        SDL_ReleaseGPUBuffer(m_device, m_handle);
+        m_handle = nullptr;
+    }
+}
+} // namespace Graphics
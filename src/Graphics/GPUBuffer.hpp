@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+struct SDL_GPUDevice;
+struct SDL_GPUBuffer;
+
+namespace Graphics
+{
+class GPUBuffer
+{
+public:
+    GPUBuffer(SDL_GPUDevice* device, uint32_t size, uint32_t usage, const char* debugName);
+    ~GPUBuffer();
+
+    GPUBuffer(const GPUBuffer&) = delete;
+    GPUBuffer& operator=(const GPUBuffer&) = delete;
+    GPUBuffer(GPUBuffer&& other) noexcept;
+    GPUBuffer& operator=(GPUBuffer&& other) noexcept;
+
+    [[nodiscard]] SDL_GPUBuffer* GetHandle() const;
+    [[nodiscard]] uint32_t GetSize() const;
+
+private:
+    void Release();
+
+    SDL_GPUDevice* m_device;
+    SDL_GPUBuffer* m_handle = nullptr;
+    uint32_t m_size;
+};
+} // namespace Graphics
@@ -2,9 +2,14 @@
 
 #include <SDL3/SDL.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <stdexcept>
 
 #include "../Core/Logger.hpp"
+#include "UploadStream.hpp"
 
 namespace Graphics
 {
@@ -18,6 +23,9 @@ void GPUContext::GPUDeviceDestroyer::operator()(SDL_GPUDevice* device) const
 
 namespace
 {
+constexpr uint64_t kMinUploadStreamCapacity = 8U * 1024 * 1024;
+constexpr uint64_t kMaxUploadStreamCapacity = std::numeric_limits<uint32_t>::max();
+
 void LogGPUSpecs(SDL_GPUDevice* device)
 {
     const SDL_PropertiesID props = SDL_GetGPUDeviceProperties(device);
@@ -34,7 +42,7 @@ void LogGPUSpecs(SDL_GPUDevice* device)
 }
 } // namespace
 
-GPUContext::GPUContext(SDL_Window* window, bool debugMode) : m_windowHandle(window)
+GPUContext::GPUContext(SDL_Window* window, bool debugMode, uint64_t uploadBytes) : m_windowHandle(window)
 {
     m_device.reset(SDL_CreateGPUDevice(
         SDL_GPU_SHADERFORMAT_SPIRV | SDL_GPU_SHADERFORMAT_DXIL | SDL_GPU_SHADERFORMAT_METALLIB, debugMode, nullptr));
@@ -49,6 +57,14 @@ GPUContext::GPUContext(SDL_Window* window, bool debugMode) : m_windowHandle(wind
     const char* backend = SDL_GetGPUDeviceDriver(m_device.get());
     LOG_INFO("GPU: Device created using backend: {}", backend ? backend : "Unknown");
 
+    const uint64_t capacity = std::clamp(uploadBytes, kMinUploadStreamCapacity, kMaxUploadStreamCapacity);
+    if (capacity < uploadBytes)
+    {
+        LOG_WARN("GPU: Upload stream capped at {} of the {} bytes a frame needs", capacity, uploadBytes);
+    }
+    m_uploadStream = std::make_unique<UploadStream>(m_device.get(), static_cast<uint32_t>(capacity));
+    LOG_INFO("GPU: Upload stream of {:.1f} MiB", static_cast<double>(capacity) / (1024.0 * 1024.0));
+
     if (m_windowHandle)
     {
         if (!SDL_ClaimWindowForGPUDevice(m_device.get(), m_windowHandle))
@@ -60,6 +76,8 @@ GPUContext::GPUContext(SDL_Window* window, bool debugMode) : m_windowHandle(wind
 
 GPUContext::~GPUContext()
 {
+    m_uploadStream.reset();
+
     if (m_device && m_windowHandle)
     {
         SDL_ReleaseWindowFromGPUDevice(m_device.get(), m_windowHandle);
@@ -85,25 +103,44 @@ void GPUContext::BeginFrame()
     }
 
     if (!SDL_WaitAndAcquireGPUSwapchainTexture(
-            m_currentCmdBuffer, m_windowHandle, &m_swapchainTexture, nullptr, nullptr))
+            m_currentCmdBuffer, m_windowHandle, &m_swapchainTexture, &m_swapchainWidth, &m_swapchainHeight))
     {
         m_swapchainTexture = nullptr;
         LOG_ERROR("GPU: Failed to acquire swapchain texture: {}", SDL_GetError());
     }
 }
 
-void GPUContext::EndFrame()
+SDL_GPUFence* GPUContext::EndFrame(bool acquireFence)
 {
-    if (m_currentCmdBuffer)
+    if (!m_currentCmdBuffer)
     {
-        if (!SDL_SubmitGPUCommandBuffer(m_currentCmdBuffer))
+        return nullptr;
+    }
+
+    FlushUploads();
+
+    SDL_GPUFence* fence = nullptr;
+    if (acquireFence)
+    {
+        fence = SDL_SubmitGPUCommandBufferAndAcquireFence(m_currentCmdBuffer);
+        if (!fence)
         {
             LOG_ERROR("GPU: Failed to submit command buffer: {}", SDL_GetError());
         }
-
-        m_currentCmdBuffer = nullptr;
-        m_swapchainTexture = nullptr;
     }
+    else if (!SDL_SubmitGPUCommandBuffer(m_currentCmdBuffer))
+    {
+        LOG_ERROR("GPU: Failed to submit command buffer: {}", SDL_GetError());
+    }
+
+    m_currentCmdBuffer = nullptr;
+    m_swapchainTexture = nullptr;
+    return fence;
+}
+
+void GPUContext::FlushUploads()
+{
+    m_uploadStream->Flush(m_currentCmdBuffer);
 }
 
 void GPUContext::SetVSync(bool enabled)
@@ -136,4 +173,28 @@ SDL_GPUTexture* GPUContext::GetSwapchainTexture() const
 {
     return m_swapchainTexture;
 }
+
+uint32_t GPUContext::GetSwapchainWidth() const
+{
+    return m_swapchainWidth;
+}
+
+uint32_t GPUContext::GetSwapchainHeight() const
+{
+    return m_swapchainHeight;
+}
+
+uint32_t GPUContext::GetSwapchainFormat() const
+{
+    if (!m_windowHandle)
+    {
+        return SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM;
+    }
+    return SDL_GetGPUSwapchainTextureFormat(m_device.get(), m_windowHandle);
+}
+
+UploadStream& GPUContext::GetUploadStream() const
+{
+    return *m_uploadStream;
+}
 } // namespace Graphics
@@ -1,18 +1,23 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 struct SDL_Window;
 struct SDL_GPUDevice;
 struct SDL_GPUCommandBuffer;
 struct SDL_GPUTexture;
+struct SDL_GPUFence;
 
 namespace Graphics
 {
+class UploadStream;
+
 class GPUContext
 {
 public:
-    explicit GPUContext(SDL_Window* window, bool debugMode = false);
+    // uploadBytes sizes the per-frame upload stream; it never goes below a default that covers small grids.
+    explicit GPUContext(SDL_Window* window, bool debugMode = false, uint64_t uploadBytes = 0);
     ~GPUContext();
 
     GPUContext(const GPUContext&) = delete;
@@ -21,13 +26,20 @@ class GPUContext
     GPUContext& operator=(GPUContext&&) noexcept;
 
     void BeginFrame();
-    void EndFrame();
+    // Submits the frame. With acquireFence the caller owns the returned fence (null if the submit failed).
+    SDL_GPUFence* EndFrame(bool acquireFence = false);
+
+    void FlushUploads();
 
     void SetVSync(bool enabled);
 
     [[nodiscard]] SDL_GPUDevice* GetDevice() const;
     [[nodiscard]] SDL_GPUCommandBuffer* GetCurrentCommandBuffer() const;
     [[nodiscard]] SDL_GPUTexture* GetSwapchainTexture() const;
+    [[nodiscard]] uint32_t GetSwapchainWidth() const;
+    [[nodiscard]] uint32_t GetSwapchainHeight() const;
+    [[nodiscard]] uint32_t GetSwapchainFormat() const;
+    [[nodiscard]] UploadStream& GetUploadStream() const;
 
 private:
     struct GPUDeviceDestroyer
@@ -38,8 +50,11 @@ class GPUContext
     using GPUDevicePtr = std::unique_ptr<SDL_GPUDevice, GPUDeviceDestroyer>;
 
     GPUDevicePtr m_device;
+    std::unique_ptr<UploadStream> m_uploadStream;
     SDL_Window* m_windowHandle = nullptr;
     SDL_GPUCommandBuffer* m_currentCmdBuffer = nullptr;
     SDL_GPUTexture* m_swapchainTexture = nullptr;
+    uint32_t m_swapchainWidth = 0;
+    uint32_t m_swapchainHeight = 0;
 };
 } // namespace Graphics
@@ -17,7 +17,9 @@ constexpr SDL_GPUTextureFormat kDefaultFormat = SDL_GPU_TEXTUREFORMAT_B8G8R8A8_U
 } // namespace
 
 GraphicsPipelineBuilder::GraphicsPipelineBuilder(SDL_GPUDevice* device)
-    : m_device(device), m_colorFormat(static_cast<uint32_t>(kDefaultFormat))
+    : m_device(device),
+      m_colorFormat(static_cast<uint32_t>(kDefaultFormat)),
+      m_primitiveType(static_cast<uint32_t>(SDL_GPU_PRIMITIVETYPE_TRIANGLELIST))
 {
     m_blendState = {.EnableBlend = false,
                     .SrcColorBlendFactor = SDL_GPU_BLENDFACTOR_ONE,
@@ -50,7 +52,8 @@ SDL_GPUGraphicsPipeline* GraphicsPipelineBuilder::Build()
 
     const SDL_GPUGraphicsPipelineCreateInfo info{.vertex_shader = m_vertexShader,
                                                  .fragment_shader = m_fragmentShader,
-                                                 .primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST,
+                                                 .primitive_type =
+                                                     static_cast<SDL_GPUPrimitiveType>(m_primitiveType),
                                                  .rasterizer_state =
                                                      {
                                                          .fill_mode = SDL_GPU_FILLMODE_FILL,
@@ -108,4 +111,10 @@ GraphicsPipelineBuilder& GraphicsPipelineBuilder::SetBlendState(const BlendState
     m_blendState = state;
     return *this;
 }
+
+GraphicsPipelineBuilder& GraphicsPipelineBuilder::SetPrimitiveType(uint32_t type)
+{
+    m_primitiveType = type;
+    return *this;
+}
 } // namespace Graphics
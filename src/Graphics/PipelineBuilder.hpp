@@ -39,12 +39,14 @@ class GraphicsPipelineBuilder
     GraphicsPipelineBuilder& SetFragmentShader(const Shader* shader);
     GraphicsPipelineBuilder& SetOutputPixelFormat(uint32_t format);
     GraphicsPipelineBuilder& SetBlendState(const BlendState& state);
+    GraphicsPipelineBuilder& SetPrimitiveType(uint32_t type);
 
 private:
     SDL_GPUDevice* m_device = nullptr;
     SDL_GPUShader* m_vertexShader = nullptr;
     SDL_GPUShader* m_fragmentShader = nullptr;
     uint32_t m_colorFormat = 0;
+    uint32_t m_primitiveType = 0;
     BlendState m_blendState{};
 };
 } // namespace Graphics
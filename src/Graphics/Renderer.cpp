@@ -2,8 +2,30 @@
 
 #include <SDL3/SDL.h>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "../Audio/BandReducer.hpp"
+#include "../Core/FrameArena.hpp"
 #include "../Core/Logger.hpp"
+#include "../Core/Simd.hpp"
+#include "../Simulation/FieldPrecision.hpp"
+#include "../Simulation/ParticleSystem.hpp"
+#include "../Simulation/SimulationSnapshot.hpp"
+#include "GPUBuffer.hpp"
 #include "GPUContext.hpp"
+#include "PipelineBuilder.hpp"
+#include "ShaderLibrary.hpp"
+#include "TextureRegistry.hpp"
+#include "UploadStream.hpp"
 
 namespace Graphics
 {
@@ -11,41 +33,323 @@ namespace
 {
 constexpr float kDefaultClearColor = 0.1F;
 constexpr float kOpaqueAlpha = 1.0F;
+constexpr float kDefaultTintR = 0.35F;
+constexpr float kDefaultTintG = 0.75F;
+constexpr float kDefaultTintB = 1.0F;
+constexpr float kDisplayExposure = 1.5F;
+constexpr uint32_t kFullscreenTriangleVertices = 3;
+constexpr const char* kDisplayTextureName = "Display";
+constexpr float kParticleIntensity = 0.35F;
+constexpr uint32_t kParticleArrays = 4; // x, y, age, colour
+constexpr uint32_t kParticleBytes = kParticleArrays * sizeof(float);
+constexpr size_t kStagedSections = 2 + kParticleArrays; // Audio bands, display field, then each particle array
+
+// Everything staged ahead of the particles each frame, with worst-case padding for every section.
+size_t GetFixedUploadBytes(size_t displayBytes)
+{
+    return sizeof(Audio::BandArray) + displayBytes + (kStagedSections * (UploadStream::kAlignment - 1));
+}
+constexpr size_t kBlendChunk = 512; // Cells unpacked, blended and repacked at a time, in stack buffers
+
+struct DisplayUniforms
+{
+    Color Background;
+    Color Tint;
+    float Exposure = 1.0F;
+    float Padding[3] = {}; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+};
+
+struct ParticleUniforms
+{
+    float GridWidth = 0.0F;
+    float GridHeight = 0.0F;
+    float Lifetime = 0.0F;
+    uint32_t Capacity = 0;
+    float Intensity = 1.0F;
+    float Padding[3] = {}; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+};
 } // namespace
 
-Renderer::Renderer(GPUContext* context)
-    : m_context(context), m_clearColor(kDefaultClearColor, kDefaultClearColor, kDefaultClearColor, kOpaqueAlpha)
+Renderer::Renderer(GPUContext* context,
+                   ShaderLibrary* shaders,
+                   TextureRegistry* textures,
+                   Core::FrameArena* frameArena,
+                   uint32_t fieldWidth,
+                   uint32_t fieldHeight,
+                   Simulation::FieldPrecision displayPrecision,
+                   const Simulation::ParticleSettings& particles)
+    : m_context(context),
+      m_textures(textures),
+      m_frameArena(frameArena),
+      m_clearColor(kDefaultClearColor, kDefaultClearColor, kDefaultClearColor, kOpaqueAlpha),
+      m_tint(kDefaultTintR, kDefaultTintG, kDefaultTintB, kOpaqueAlpha),
+      m_displayCells(static_cast<size_t>(fieldWidth) * fieldHeight),
+      m_particleLifetime(particles.Lifetime),
+      m_fieldWidth(static_cast<float>(fieldWidth)),
+      m_fieldHeight(static_cast<float>(fieldHeight))
 {
+    SDL_GPUDevice* device = m_context->GetDevice();
+
+    const Shader* vertex =
+        shaders->Get(shaders->LoadGraphics("Fullscreen", "shaders/Fullscreen.vert.hlsl", ShaderStage::Vertex));
+    const Shader* fragment =
+        shaders->Get(shaders->LoadGraphics("Display", "shaders/Display.frag.hlsl", ShaderStage::Fragment));
+
+    m_displayPipeline = GraphicsPipelineBuilder(device)
+                            .SetVertexShader(vertex)
+                            .SetFragmentShader(fragment)
+                            .SetOutputPixelFormat(m_context->GetSwapchainFormat())
+                            .Build();
+
+    const SDL_GPUSamplerCreateInfo samplerInfo{.min_filter = SDL_GPU_FILTER_LINEAR,
+                                               .mag_filter = SDL_GPU_FILTER_LINEAR,
+                                               .address_mode_u = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
+                                               .address_mode_v = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
+                                               .address_mode_w = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE};
+
+    m_sampler = SDL_CreateGPUSampler(device, &samplerInfo);
+    if (!m_sampler)
+    {
+        LOG_ERROR("Renderer: Failed to create sampler: {}", SDL_GetError());
+        throw std::runtime_error("Sampler Creation Failed");
+    }
+
+    // Double-buffered so the upload for frame N never overwrites the texture frame N-1 is still sampling.
+    // The registry falls back to R32_FLOAT where R16_FLOAT is unsupported, so the upload follows what it chose.
+    m_display = m_textures->CreatePingPong(kDisplayTextureName,
+                                           fieldWidth,
+                                           fieldHeight,
+                                           displayPrecision == Simulation::FieldPrecision::Half
+                                               ? SDL_GPU_TEXTUREFORMAT_R16_FLOAT
+                                               : SDL_GPU_TEXTUREFORMAT_R32_FLOAT);
+    m_halfDisplay = m_textures->GetBuffer(m_display)->GetWrite().Format == SDL_GPU_TEXTUREFORMAT_R16_FLOAT;
+    const size_t displayBytes = m_displayCells * (m_halfDisplay ? sizeof(uint16_t) : sizeof(float));
+
+    if (particles.Capacity > 0)
+    {
+        // Every frame stages the audio bands, the display field and the tracers through the same upload stream,
+        // in that order, each section padded up to the stream's alignment.
+        const size_t capacity = m_context->GetUploadStream().GetCapacity();
+        const size_t reserved = GetFixedUploadBytes(displayBytes);
+        const size_t budget = reserved >= capacity ? 0 : capacity - reserved;
+        m_particleCapacity = static_cast<uint32_t>(std::min<size_t>(particles.Capacity, budget / kParticleBytes));
+        if (m_particleCapacity == 0)
+        {
+            LOG_WARN("Renderer: Upload stream ({} bytes) has no room for particles after the display field ({} bytes), "
+                     "particles disabled",
+                     capacity,
+                     displayBytes);
+        }
+        else if (m_particleCapacity < particles.Capacity)
+        {
+            LOG_WARN("Renderer: Upload stream fits {} of {} particles per frame",
+                     m_particleCapacity,
+                     particles.Capacity);
+        }
+    }
+
+    if (m_particleCapacity > 0)
+    {
+        const Shader* particleVertex =
+            shaders->Get(shaders->LoadGraphics("Particles", "shaders/Particles.vert.hlsl", ShaderStage::Vertex));
+        const Shader* particleFragment =
+            shaders->Get(shaders->LoadGraphics("ParticleColor", "shaders/Particles.frag.hlsl", ShaderStage::Fragment));
+
+        const BlendState additive{.EnableBlend = true,
+                                  .SrcColorBlendFactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA,
+                                  .DstColorBlendFactor = SDL_GPU_BLENDFACTOR_ONE,
+                                  .ColorBlendOp = SDL_GPU_BLENDOP_ADD,
+                                  .SrcAlphaBlendFactor = SDL_GPU_BLENDFACTOR_ZERO,
+                                  .DstAlphaBlendFactor = SDL_GPU_BLENDFACTOR_ONE,
+                                  .AlphaBlendOp = SDL_GPU_BLENDOP_ADD,
+                                  .ColorWriteMask = SDL_GPU_COLORCOMPONENT_R | SDL_GPU_COLORCOMPONENT_G |
+                                                    SDL_GPU_COLORCOMPONENT_B | SDL_GPU_COLORCOMPONENT_A};
+
+        m_particlePipeline = GraphicsPipelineBuilder(device)
+                                 .SetVertexShader(particleVertex)
+                                 .SetFragmentShader(particleFragment)
+                                 .SetOutputPixelFormat(m_context->GetSwapchainFormat())
+                                 .SetBlendState(additive)
+                                 .SetPrimitiveType(SDL_GPU_PRIMITIVETYPE_POINTLIST)
+                                 .Build();
+
+        for (std::unique_ptr<GPUBuffer>& buffer : m_particleBuffers)
+        {
+            buffer = std::make_unique<GPUBuffer>(
+                device, m_particleCapacity * kParticleBytes, SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ, "Particles");
+        }
+    }
+
     LOG_INFO("Renderer: System initialized");
 }
 
-void Renderer::Draw(double alpha)
+Renderer::~Renderer()
 {
-    (void)alpha;
+    SDL_GPUDevice* device = m_context->GetDevice();
+
+    if (m_sampler)
+    {
+        SDL_ReleaseGPUSampler(device, m_sampler);
+    }
+    if (m_particlePipeline)
+    {
+        SDL_ReleaseGPUGraphicsPipeline(device, m_particlePipeline);
+    }
+    if (m_displayPipeline)
+    {
+        SDL_ReleaseGPUGraphicsPipeline(device, m_displayPipeline);
+    }
+}
 
+void Renderer::Draw(const Simulation::SimulationSnapshot& previous,
+                    const Simulation::SimulationSnapshot& latest,
+                    double alpha,
+                    SDL_GPUTexture* target)
+{
     SDL_GPUCommandBuffer* cmd = m_context->GetCurrentCommandBuffer();
-    SDL_GPUTexture* swapchainTarget = m_context->GetSwapchainTexture();
+    SDL_GPUTexture* colorTarget = target ? target : m_context->GetSwapchainTexture();
+
+    if (!cmd || !colorTarget)
+    {
+        return;
+    }
 
-    if (!cmd || !swapchainTarget)
+    PingPongBuffer* display = m_textures->GetBuffer(m_display);
+    if (!display)
     {
         return;
     }
 
+    const std::pmr::vector<std::byte> field = Interpolate(previous.Dye, latest.Dye, static_cast<float>(alpha));
+
+    if (!field.empty())
+    {
+        const Texture2D& upload = display->GetWrite();
+        m_context->GetUploadStream().StageTexture(
+            upload.Handle, upload.Width, upload.Height, std::span<const std::byte>(field));
+        display->Swap();
+    }
+
+    const uint32_t particleCount = UploadParticles(latest.Particles);
+    m_context->FlushUploads();
+
     SDL_GPUColorTargetInfo colorInfo{};
-    colorInfo.texture = swapchainTarget;
+    colorInfo.texture = colorTarget;
     colorInfo.clear_color = SDL_FColor{m_clearColor.R, m_clearColor.G, m_clearColor.B, m_clearColor.A};
     colorInfo.load_op = SDL_GPU_LOADOP_CLEAR;
     colorInfo.store_op = SDL_GPU_STOREOP_STORE;
 
     SDL_GPURenderPass* pass = SDL_BeginGPURenderPass(cmd, &colorInfo, 1, nullptr);
-    if (pass)
+    if (!pass)
     {
-        SDL_EndGPURenderPass(pass);
+        LOG_ERROR("Renderer: Failed to begin render pass: {} ", SDL_GetError());
+        return;
     }
-    else
+
+    const DisplayUniforms uniforms{.Background = m_clearColor, .Tint = m_tint, .Exposure = kDisplayExposure};
+    const SDL_GPUTextureSamplerBinding binding{.texture = display->GetRead().Handle, .sampler = m_sampler};
+
+    SDL_BindGPUGraphicsPipeline(pass, m_displayPipeline);
+    SDL_BindGPUFragmentSamplers(pass, 0, &binding, 1);
+    SDL_PushGPUFragmentUniformData(cmd, 0, &uniforms, sizeof(uniforms));
+    SDL_DrawGPUPrimitives(pass, kFullscreenTriangleVertices, 1, 0, 0);
+
+    DrawParticles(cmd, pass, particleCount);
+
+    SDL_EndGPURenderPass(pass);
+}
+
+uint32_t Renderer::UploadParticles(const Simulation::ParticleArrays& particles)
+{
+    const auto count = static_cast<uint32_t>(std::min<size_t>(particles.Size(), m_particleCapacity));
+    if (count == 0)
     {
-        LOG_ERROR("Renderer: Failed to begin render pass: {} ", SDL_GetError());
+        return 0;
     }
+
+    m_particleSlot ^= 1U;
+    SDL_GPUBuffer* buffer = m_particleBuffers[m_particleSlot]->GetHandle();
+    UploadStream& stream = m_context->GetUploadStream();
+    const uint32_t section = m_particleCapacity * static_cast<uint32_t>(sizeof(float));
+
+    const bool staged =
+        stream.StageBuffer(buffer, 0, std::as_bytes(std::span(particles.PositionX).first(count))) &&
+        stream.StageBuffer(buffer, section, std::as_bytes(std::span(particles.PositionY).first(count))) &&
+        stream.StageBuffer(buffer, 2 * section, std::as_bytes(std::span(particles.Age).first(count))) &&
+        stream.StageBuffer(buffer, 3 * section, std::as_bytes(std::span(particles.Color).first(count)));
+
+    return staged ? count : 0;
+}
+
+void Renderer::DrawParticles(SDL_GPUCommandBuffer* cmd, SDL_GPURenderPass* pass, uint32_t count) const
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    const ParticleUniforms uniforms{.GridWidth = m_fieldWidth,
+                                    .GridHeight = m_fieldHeight,
+                                    .Lifetime = m_particleLifetime,
+                                    .Capacity = m_particleCapacity,
+                                    .Intensity = kParticleIntensity};
+    SDL_GPUBuffer* buffer = m_particleBuffers[m_particleSlot]->GetHandle();
+
+    SDL_BindGPUGraphicsPipeline(pass, m_particlePipeline);
+    SDL_BindGPUVertexStorageBuffers(pass, 0, &buffer, 1);
+    SDL_PushGPUVertexUniformData(cmd, 0, &uniforms, sizeof(uniforms));
+    SDL_DrawGPUPrimitives(pass, count, 1, 0, 0);
+}
+
+std::pmr::vector<std::byte> Renderer::Interpolate(const Simulation::PackedField2D& previous,
+                                                  const Simulation::PackedField2D& latest,
+                                                  float alpha) const
+{
+    std::pmr::vector<std::byte> out(m_frameArena);
+    if (previous.GetCellCount() != m_displayCells || latest.GetCellCount() != m_displayCells)
+    {
+        return out;
+    }
+
+    const size_t texelBytes = m_halfDisplay ? sizeof(uint16_t) : sizeof(float);
+    out.resize(m_displayCells * texelBytes);
+
+    // fp16 snapshots are widened in L1-sized chunks, blended in fp32 and narrowed again on the way out, so the
+    // arrays streamed through memory stay at their stored width.
+    std::array<float, kBlendChunk> a{};
+    std::array<float, kBlendChunk> b{};
+    std::array<uint16_t, kBlendChunk> packed{};
+    const float t = std::clamp(alpha, 0.0F, 1.0F);
+
+    for (size_t begin = 0; begin < m_displayCells; begin += kBlendChunk)
+    {
+        const size_t count = std::min(kBlendChunk, m_displayCells - begin);
+        previous.Read(begin, std::span(a).first(count));
+        latest.Read(begin, std::span(b).first(count));
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            a[i] += t * (b[i] - a[i]);
+        }
+
+        std::byte* destination = out.data() + (begin * texelBytes);
+        if (m_halfDisplay)
+        {
+            Core::Simd::ConvertToHalf(a.data(), packed.data(), count);
+            std::memcpy(destination, packed.data(), count * sizeof(uint16_t));
+        }
+        else
+        {
+            std::memcpy(destination, a.data(), count * sizeof(float));
+        }
+    }
+    return out;
+}
+
+uint64_t Renderer::GetFrameUploadBytes(uint32_t fieldWidth, uint32_t fieldHeight, uint32_t particleCapacity)
+{
+    const size_t displayBytes = static_cast<size_t>(fieldWidth) * fieldHeight * sizeof(float);
+    return GetFixedUploadBytes(displayBytes) + (static_cast<uint64_t>(particleCapacity) * kParticleBytes);
 }
 
 void Renderer::SetClearColor(const Color& color)
@@ -57,4 +361,9 @@ void Renderer::SetClearColor(float r, float g, float b, float a)
 {
     m_clearColor = {r, g, b, a};
 }
+
+void Renderer::SetTint(const Color& color)
+{
+    m_tint = color;
+}
 } // namespace Graphics
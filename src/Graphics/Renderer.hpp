@@ -1,5 +1,32 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "../Simulation/FieldPrecision.hpp"
+#include "../Simulation/ParticleSystem.hpp"
+#include "TextureRegistry.hpp"
+
+struct SDL_GPUCommandBuffer;
+struct SDL_GPUGraphicsPipeline;
+struct SDL_GPURenderPass;
+struct SDL_GPUSampler;
+struct SDL_GPUTexture;
+
+namespace Core
+{
+class FrameArena;
+} // namespace Core
+
+namespace Simulation
+{
+struct SimulationSnapshot;
+} // namespace Simulation
+
 namespace Graphics
 {
 struct Color
@@ -14,26 +41,75 @@ struct Color
     constexpr Color(float r, float g, float b, float a = 1.0F) noexcept : R(r), G(g), B(b), A(a) {}
 };
 
+class GPUBuffer;
 class GPUContext;
+class ShaderLibrary;
 
 class Renderer
 {
 public:
-    explicit Renderer(GPUContext* context);
-    ~Renderer() = default;
+    Renderer(GPUContext* context,
+             ShaderLibrary* shaders,
+             TextureRegistry* textures,
+             Core::FrameArena* frameArena,
+             uint32_t fieldWidth,
+             uint32_t fieldHeight,
+             Simulation::FieldPrecision displayPrecision,
+             const Simulation::ParticleSettings& particles);
+    ~Renderer();
 
     Renderer(const Renderer&) = delete;
     Renderer& operator=(const Renderer&) = delete;
-    Renderer(Renderer&&) noexcept = default;
-    Renderer& operator=(Renderer&&) noexcept = default;
+    Renderer(Renderer&&) = delete;
+    Renderer& operator=(Renderer&&) = delete;
+
+    // Blends the two newest simulation dye fields by alpha and draws the latest tracers over them, into target
+    // or, if null, the swapchain.
+    void Draw(const Simulation::SimulationSnapshot& previous,
+              const Simulation::SimulationSnapshot& latest,
+              double alpha,
+              SDL_GPUTexture* target = nullptr);
 
-    void Draw(double alpha);
+    // Upload stream bytes a frame needs for the audio bands, a fieldWidth x fieldHeight display field at up to
+    // fp32 and particleCapacity tracers, alignment padding included. Size the GPU context's stream with it.
+    [[nodiscard]] static uint64_t GetFrameUploadBytes(uint32_t fieldWidth,
+                                                      uint32_t fieldHeight,
+                                                      uint32_t particleCapacity);
 
     void SetClearColor(const Color& color);
     void SetClearColor(float r, float g, float b, float a);
+    void SetTint(const Color& color);
 
 private:
+    // Blended field in frame-arena memory, as texels of the display format; empty if the snapshots do not match
+    // the display size.
+    [[nodiscard]] std::pmr::vector<std::byte> Interpolate(const Simulation::PackedField2D& previous,
+                                                          const Simulation::PackedField2D& latest,
+                                                          float alpha) const;
+
+    // Stages the tracers into the next particle buffer; returns how many will be drawn.
+    [[nodiscard]] uint32_t UploadParticles(const Simulation::ParticleArrays& particles);
+    void DrawParticles(SDL_GPUCommandBuffer* cmd, SDL_GPURenderPass* pass, uint32_t count) const;
+
     GPUContext* m_context;
+    TextureRegistry* m_textures;
+    Core::FrameArena* m_frameArena;
     Color m_clearColor;
+    Color m_tint;
+
+    SDL_GPUGraphicsPipeline* m_displayPipeline = nullptr;
+    SDL_GPUSampler* m_sampler = nullptr;
+    PingPongHandle m_display;
+    size_t m_displayCells;
+    bool m_halfDisplay = false; // R16_FLOAT display texture; R32_FLOAT if fp32 was asked for or fp16 is unsupported
+
+    // Tracers are drawn from the latest snapshot only: compaction reorders them, so there is nothing to blend.
+    SDL_GPUGraphicsPipeline* m_particlePipeline = nullptr;
+    std::array<std::unique_ptr<GPUBuffer>, 2> m_particleBuffers; // Alternating, like the display ping-pong
+    uint32_t m_particleSlot = 0;
+    uint32_t m_particleCapacity = 0;
+    float m_particleLifetime;
+    float m_fieldWidth;
+    float m_fieldHeight;
 };
 } // namespace Graphics
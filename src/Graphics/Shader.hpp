@@ -25,6 +25,21 @@ struct ShaderMetadata
     uint32_t ThreadCountZ = 0;
 };
 
+// Resource counts the SDL GPU API needs to create a shader, reflected from its SPIR-V. Graphics stages only use
+// the read-only storage counts and the uniforms; compute also fills the rest.
+struct ShaderResources
+{
+    uint32_t Samplers = 0;
+    uint32_t ReadOnlyStorageTextures = 0;
+    uint32_t ReadOnlyStorageBuffers = 0;
+    uint32_t ReadWriteStorageTextures = 0;
+    uint32_t ReadWriteStorageBuffers = 0;
+    uint32_t UniformBuffers = 0;
+    uint32_t ThreadCountX = 0;
+    uint32_t ThreadCountY = 0;
+    uint32_t ThreadCountZ = 0;
+};
+
 class Shader
 {
 public:
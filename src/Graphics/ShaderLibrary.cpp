@@ -4,15 +4,20 @@
 #include <SDL3_shadercross/SDL_shadercross.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <ios>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "../Core/JobSystem.hpp"
 #include "../Core/Logger.hpp"
+#include "EmbeddedShaders.hpp"
 #include "GPUContext.hpp"
 #include "Shader.hpp"
 
@@ -27,6 +32,18 @@ struct MetadataDestroyer
 
 using SdlGraphicsMetadataPtr = std::unique_ptr<SDL_ShaderCross_GraphicsShaderMetadata, MetadataDestroyer>;
 using SdlComputeMetadataPtr = std::unique_ptr<SDL_ShaderCross_ComputePipelineMetadata, MetadataDestroyer>;
+
+// The build-time copy of path, if one was embedded for this stage.
+const EmbeddedShader* FindEmbedded(const std::string& path, ShaderStage stage)
+{
+    const EmbeddedShader* embedded = FindEmbeddedShader(path);
+    if (embedded && embedded->Stage != stage)
+    {
+        LOG_WARN("ShaderLibrary: Embedded '{}' is for another stage, compiling from source", path);
+        return nullptr;
+    }
+    return embedded;
+}
 } // namespace
 
 void ShaderLibrary::BytecodeDestroyer::operator()(void* ptr) const
@@ -45,111 +62,254 @@ ShaderLibrary::ShaderLibrary(GPUContext* context) : m_context(context)
 
 ShaderLibrary::~ShaderLibrary()
 {
-    m_shaders.clear();
+    m_shaders = {};
+    m_names.clear();
     SDL_ShaderCross_Quit();
     LOG_INFO("ShaderLibrary: System shutdown");
 }
 
-Shader* ShaderLibrary::LoadGraphics(const std::string& name, const std::string& path, ShaderStage stage)
+ShaderHandle ShaderLibrary::LoadGraphics(const std::string& name, const std::string& path, ShaderStage stage)
 {
-    if (const auto it = m_shaders.find(name); it != m_shaders.end())
+    if (const auto it = m_names.find(name); it != m_names.end())
+    {
+        return it->second;
+    }
+
+    if (const EmbeddedShader* embedded = FindEmbedded(path, stage))
     {
-        return it->second.get();
+        return Create(name, path, stage, embedded->Bytecode, embedded->Resources);
     }
 
     const std::string source = ReadFile(path);
-    auto spirv = CompileToSPIRV(source, stage, path);
+    return CreateFromSpirv(name, path, stage, CompileToSPIRV(source, stage, path));
+}
 
-    const SdlGraphicsMetadataPtr metadata(
-        SDL_ShaderCross_ReflectGraphicsSPIRV(static_cast<Uint8*>(spirv.Bytecode.get()), spirv.Size, 0));
+ShaderHandle ShaderLibrary::LoadCompute(const std::string& name, const std::string& path)
+{
+    if (const auto it = m_names.find(name); it != m_names.end())
+    {
+        return it->second;
+    }
 
-    if (!metadata)
+    if (const EmbeddedShader* embedded = FindEmbedded(path, ShaderStage::Compute))
     {
-        LOG_ERROR("ShaderLibrary: Reflection failed for '{}'", path);
-        throw std::runtime_error("Shader Reflection Failed");
+        return Create(name, path, ShaderStage::Compute, embedded->Bytecode, embedded->Resources);
     }
 
-    const SDL_ShaderCross_SPIRV_Info spirvInfo{.bytecode = static_cast<const Uint8*>(spirv.Bytecode.get()),
-                                               .bytecode_size = spirv.Size,
-                                               .entrypoint = "main",
-                                               .shader_stage = (stage == ShaderStage::Vertex)
-                                                                   ? SDL_SHADERCROSS_SHADERSTAGE_VERTEX
-                                                                   : SDL_SHADERCROSS_SHADERSTAGE_FRAGMENT};
+    const std::string source = ReadFile(path);
+    return CreateFromSpirv(name, path, ShaderStage::Compute, CompileToSPIRV(source, ShaderStage::Compute, path));
+}
 
-    SDL_GPUShader* handle =
-        SDL_ShaderCross_CompileGraphicsShaderFromSPIRV(m_context->GetDevice(), &spirvInfo, &metadata->resource_info, 0);
+void ShaderLibrary::Unload(ShaderHandle handle)
+{
+    std::unique_ptr<Shader> shader;
+    if (m_shaders.Remove(handle, shader))
+    {
+        LOG_INFO("ShaderLibrary: Unloaded '{}'", shader->GetName());
+        m_names.erase(shader->GetName());
+    }
+}
 
-    if (!handle)
+std::vector<ShaderLibrary::SpirvResult> ShaderLibrary::Compile(std::span<const ShaderRequest> requests,
+                                                               Core::JobSystem& jobSystem)
+{
+    std::vector<SpirvResult> compiled(requests.size());
+
+    jobSystem.ParallelFor(static_cast<uint32_t>(requests.size()), 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const ShaderRequest& request = requests[i];
+            if (FindEmbedded(request.Path, request.Stage))
+            {
+                continue;
+            }
+
+            try
+            {
+                compiled[i] = CompileToSPIRV(ReadFile(request.Path), request.Stage, request.Path);
+            }
+            catch (const std::runtime_error&)
+            {
+                LOG_WARN("ShaderLibrary: Deferring '{}' to its first load", request.Name);
+            }
+        }
+    });
+
+    return compiled;
+}
+
+void ShaderLibrary::Preload(std::span<const ShaderRequest> requests, std::span<const SpirvResult> compiled)
+{
+    size_t embeddedCount = 0;
+    size_t compiledCount = 0;
+
+    for (size_t i = 0; i < requests.size(); ++i)
     {
-        LOG_ERROR("ShaderLibrary: Creation failed for '{}': {}", path, SDL_GetError());
-        throw std::runtime_error("Shader Creation Failed");
+        const ShaderRequest& request = requests[i];
+        if (m_names.contains(request.Name))
+        {
+            continue;
+        }
+
+        if (const EmbeddedShader* embedded = FindEmbedded(request.Path, request.Stage))
+        {
+            Create(request.Name, request.Path, request.Stage, embedded->Bytecode, embedded->Resources);
+            ++embeddedCount;
+        }
+        else if (i < compiled.size() && compiled[i].Bytecode)
+        {
+            CreateFromSpirv(request.Name, request.Path, request.Stage, compiled[i]);
+            ++compiledCount;
+        }
     }
 
-    auto shader = std::make_unique<Shader>(m_context->GetDevice(), handle, stage, name);
-    Shader* ptr = shader.get();
-    m_shaders[name] = std::move(shader);
+    LOG_INFO("ShaderLibrary: Preloaded {} shaders ({} embedded, {} compiled)",
+             embeddedCount + compiledCount,
+             embeddedCount,
+             compiledCount);
+}
 
-    LOG_INFO("ShaderLibrary: Loaded Graphics Shader '{}'", name);
-    return ptr;
+void ShaderLibrary::Preload(std::span<const ShaderRequest> requests, Core::JobSystem& jobSystem)
+{
+    Preload(requests, Compile(requests, jobSystem));
 }
 
-Shader* ShaderLibrary::LoadCompute(const std::string& name, const std::string& path)
+ShaderHandle ShaderLibrary::CreateFromSpirv(const std::string& name,
+                                            const std::string& path,
+                                            ShaderStage stage,
+                                            const SpirvResult& spirv)
 {
-    if (const auto it = m_shaders.find(name); it != m_shaders.end())
+    const std::span<const uint8_t> bytecode(static_cast<const uint8_t*>(spirv.Bytecode.get()), spirv.Size);
+    ShaderResources resources{};
+
+    if (stage == ShaderStage::Compute)
+    {
+        const SdlComputeMetadataPtr metadata(SDL_ShaderCross_ReflectComputeSPIRV(bytecode.data(), bytecode.size(), 0));
+        if (!metadata)
+        {
+            LOG_ERROR("ShaderLibrary: Reflection failed for Compute '{}'", path);
+            throw std::runtime_error("Compute Reflection Failed");
+        }
+
+        resources = ShaderResources{.Samplers = metadata->num_samplers,
+                                    .ReadOnlyStorageTextures = metadata->num_readonly_storage_textures,
+                                    .ReadOnlyStorageBuffers = metadata->num_readonly_storage_buffers,
+                                    .ReadWriteStorageTextures = metadata->num_readwrite_storage_textures,
+                                    .ReadWriteStorageBuffers = metadata->num_readwrite_storage_buffers,
+                                    .UniformBuffers = metadata->num_uniform_buffers,
+                                    .ThreadCountX = metadata->threadcount_x,
+                                    .ThreadCountY = metadata->threadcount_y,
+                                    .ThreadCountZ = metadata->threadcount_z};
+    }
+    else
     {
-        return it->second.get();
+        const SdlGraphicsMetadataPtr metadata(
+            SDL_ShaderCross_ReflectGraphicsSPIRV(bytecode.data(), bytecode.size(), 0));
+        if (!metadata)
+        {
+            LOG_ERROR("ShaderLibrary: Reflection failed for '{}'", path);
+            throw std::runtime_error("Shader Reflection Failed");
+        }
+
+        resources = ShaderResources{.Samplers = metadata->resource_info.num_samplers,
+                                    .ReadOnlyStorageTextures = metadata->resource_info.num_storage_textures,
+                                    .ReadOnlyStorageBuffers = metadata->resource_info.num_storage_buffers,
+                                    .UniformBuffers = metadata->resource_info.num_uniform_buffers};
     }
 
-    const std::string source = ReadFile(path);
-    auto spirv = CompileToSPIRV(source, ShaderStage::Compute, path);
+    return Create(name, path, stage, bytecode, resources);
+}
 
-    const SdlComputeMetadataPtr metadata(
-        SDL_ShaderCross_ReflectComputeSPIRV(static_cast<Uint8*>(spirv.Bytecode.get()), spirv.Size, 0));
+ShaderHandle ShaderLibrary::Create(const std::string& name,
+                                   const std::string& path,
+                                   ShaderStage stage,
+                                   std::span<const uint8_t> spirv,
+                                   const ShaderResources& resources)
+{
+    if (!m_context)
+    {
+        LOG_ERROR("ShaderLibrary: Cannot create '{}' before a GPU context is attached", name);
+        throw std::logic_error("Shader Library Has No Context");
+    }
 
-    if (!metadata)
+    SDL_ShaderCross_SPIRV_Info spirvInfo{.bytecode = spirv.data(), .bytecode_size = spirv.size(), .entrypoint = "main"};
+
+    if (stage == ShaderStage::Compute)
     {
-        LOG_ERROR("ShaderLibrary: Reflection failed for Compute '{}'", path);
-        throw std::runtime_error("Compute Reflection Failed");
+        spirvInfo.shader_stage = SDL_SHADERCROSS_SHADERSTAGE_COMPUTE;
+        const SDL_ShaderCross_ComputePipelineMetadata metadata{
+            .num_samplers = resources.Samplers,
+            .num_readonly_storage_textures = resources.ReadOnlyStorageTextures,
+            .num_readonly_storage_buffers = resources.ReadOnlyStorageBuffers,
+            .num_readwrite_storage_textures = resources.ReadWriteStorageTextures,
+            .num_readwrite_storage_buffers = resources.ReadWriteStorageBuffers,
+            .num_uniform_buffers = resources.UniformBuffers,
+            .threadcount_x = resources.ThreadCountX,
+            .threadcount_y = resources.ThreadCountY,
+            .threadcount_z = resources.ThreadCountZ};
+
+        SDL_GPUComputePipeline* pipeline =
+            SDL_ShaderCross_CompileComputePipelineFromSPIRV(m_context->GetDevice(), &spirvInfo, &metadata, 0);
+
+        if (!pipeline)
+        {
+            LOG_ERROR("ShaderLibrary: Pipeline creation failed for '{}': {}", path, SDL_GetError());
+            throw std::runtime_error("Compute Pipeline Creation Failed");
+        }
+
+        const ShaderMetadata meta{.ThreadCountX = resources.ThreadCountX,
+                                  .ThreadCountY = resources.ThreadCountY,
+                                  .ThreadCountZ = resources.ThreadCountZ};
+
+        const ShaderHandle shader =
+            Register(name, std::make_unique<Shader>(m_context->GetDevice(), pipeline, meta, name));
+
+        LOG_INFO("ShaderLibrary: Loaded Compute Shader '{}' [Threads: {}x{}x{}]",
+                 name,
+                 meta.ThreadCountX,
+                 meta.ThreadCountY,
+                 meta.ThreadCountZ);
+        return shader;
     }
 
-    const SDL_ShaderCross_SPIRV_Info spirvInfo{.bytecode = static_cast<const Uint8*>(spirv.Bytecode.get()),
-                                               .bytecode_size = spirv.Size,
-                                               .entrypoint = "main",
-                                               .shader_stage = SDL_SHADERCROSS_SHADERSTAGE_COMPUTE};
+    spirvInfo.shader_stage =
+        (stage == ShaderStage::Vertex) ? SDL_SHADERCROSS_SHADERSTAGE_VERTEX : SDL_SHADERCROSS_SHADERSTAGE_FRAGMENT;
+    const SDL_ShaderCross_GraphicsShaderResourceInfo resourceInfo{
+        .num_samplers = resources.Samplers,
+        .num_storage_textures = resources.ReadOnlyStorageTextures,
+        .num_storage_buffers = resources.ReadOnlyStorageBuffers,
+        .num_uniform_buffers = resources.UniformBuffers};
 
-    SDL_GPUComputePipeline* pipeline =
-        SDL_ShaderCross_CompileComputePipelineFromSPIRV(m_context->GetDevice(), &spirvInfo, metadata.get(), 0);
+    SDL_GPUShader* handle =
+        SDL_ShaderCross_CompileGraphicsShaderFromSPIRV(m_context->GetDevice(), &spirvInfo, &resourceInfo, 0);
 
-    if (!pipeline)
+    if (!handle)
     {
-        LOG_ERROR("ShaderLibrary: Pipeline creation failed for '{}': {}", path, SDL_GetError());
-        throw std::runtime_error("Compute Pipeline Creation Failed");
+        LOG_ERROR("ShaderLibrary: Creation failed for '{}': {}", path, SDL_GetError());
+        throw std::runtime_error("Shader Creation Failed");
     }
 
-    ShaderMetadata meta{.ThreadCountX = metadata->threadcount_x,
-                        .ThreadCountY = metadata->threadcount_y,
-                        .ThreadCountZ = metadata->threadcount_z};
+    const ShaderHandle shader = Register(name, std::make_unique<Shader>(m_context->GetDevice(), handle, stage, name));
 
-    auto shader = std::make_unique<Shader>(m_context->GetDevice(), pipeline, meta, name);
-    Shader* ptr = shader.get();
-    m_shaders[name] = std::move(shader);
+    LOG_INFO("ShaderLibrary: Loaded Graphics Shader '{}'", name);
+    return shader;
+}
 
-    LOG_INFO("ShaderLibrary: Loaded Compute Shader '{}' [Threads: {}x{}x{}]",
-             name,
-             meta.ThreadCountX,
-             meta.ThreadCountY,
-             meta.ThreadCountZ);
-    return ptr;
+ShaderHandle ShaderLibrary::Register(const std::string& name, std::unique_ptr<Shader> shader)
+{
+    const ShaderHandle handle = m_shaders.Insert(std::move(shader));
+    m_names[name] = handle;
+    return handle;
 }
 
-Shader* ShaderLibrary::Get(const std::string& name)
+ShaderHandle ShaderLibrary::Find(const std::string& name) const
 {
-    if (const auto it = m_shaders.find(name); it != m_shaders.end())
+    if (const auto it = m_names.find(name); it != m_names.end())
     {
-        return it->second.get();
+        return it->second;
     }
     LOG_WARN("ShaderLibrary: Shader '{}' not found", name);
-    return nullptr;
+    return {};
 }
 
 std::string ShaderLibrary::ReadFile(const std::string& path)
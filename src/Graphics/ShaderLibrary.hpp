@@ -1,19 +1,53 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "../Core/SlotArray.hpp"
 #include "Shader.hpp"
 
+namespace Core
+{
+class JobSystem;
+} // namespace Core
+
 namespace Graphics
 {
 class GPUContext;
 
+struct ShaderRequest
+{
+    std::string Name;
+    std::string Path;
+    ShaderStage Stage = ShaderStage::Vertex;
+};
+
+using ShaderHandle = Core::SlotHandle<Shader>;
+
+// Owns every shader. Loading returns a handle, which is what per-frame code resolves; names are kept for setup
+// and debugging.
 class ShaderLibrary
 {
+    struct BytecodeDestroyer
+    {
+        void operator()(void* ptr) const;
+    };
+
 public:
-    explicit ShaderLibrary(GPUContext* context);
+    // SPIR-V compiled from HLSL, not yet turned into a GPU object. Empty when there was nothing to compile.
+    struct SpirvResult
+    {
+        std::unique_ptr<void, BytecodeDestroyer> Bytecode;
+        size_t Size = 0;
+    };
+
+    // The context may be attached later, so compilation can start before the GPU device exists; nothing can be
+    // created until it is.
+    explicit ShaderLibrary(GPUContext* context = nullptr);
     ~ShaderLibrary();
 
     ShaderLibrary(const ShaderLibrary&) = delete;
@@ -21,29 +55,53 @@ class ShaderLibrary
     ShaderLibrary(ShaderLibrary&&) noexcept = default;
     ShaderLibrary& operator=(ShaderLibrary&&) noexcept = default;
 
-    Shader* LoadGraphics(const std::string& name, const std::string& path, ShaderStage stage);
-    Shader* LoadCompute(const std::string& name, const std::string& path);
+    // Returns the existing handle if the name is already loaded. Shaders embedded at build time are created
+    // from their SPIR-V; anything else is compiled from the HLSL at path, the development fallback.
+    ShaderHandle LoadGraphics(const std::string& name, const std::string& path, ShaderStage stage);
+    ShaderHandle LoadCompute(const std::string& name, const std::string& path);
+    void Unload(ShaderHandle handle);
 
-    [[nodiscard]] Shader* Get(const std::string& name);
+    void AttachContext(GPUContext* context) { m_context = context; }
 
-private:
-    [[nodiscard]] static std::string ReadFile(const std::string& path);
+    // Compiles every request that has no embedded SPIR-V, in parallel. Needs no device and may run on any thread
+    // once a library exists. Failures are logged and left empty; the matching Load call retries and reports them.
+    [[nodiscard]] static std::vector<SpirvResult> Compile(std::span<const ShaderRequest> requests,
+                                                          Core::JobSystem& jobSystem);
 
-    struct BytecodeDestroyer
-    {
-        void operator()(void* ptr) const;
-    };
+    // Creates the GPU objects for requests from their embedded SPIR-V or from compiled, as returned by Compile().
+    void Preload(std::span<const ShaderRequest> requests, std::span<const SpirvResult> compiled);
 
-    struct SpirvResult
+    // Compile() followed by Preload(); the caller must be the main thread.
+    void Preload(std::span<const ShaderRequest> requests, Core::JobSystem& jobSystem);
+
+    // Null once the shader has been unloaded.
+    [[nodiscard]] Shader* Get(ShaderHandle handle) const
     {
-        std::unique_ptr<void, BytecodeDestroyer> Bytecode;
-        size_t Size;
-    };
+        const std::unique_ptr<Shader>* shader = m_shaders.Get(handle);
+        return shader ? shader->get() : nullptr;
+    }
+
+    // Setup and debugging only: hashes the name.
+    [[nodiscard]] ShaderHandle Find(const std::string& name) const;
+
+private:
+    [[nodiscard]] static std::string ReadFile(const std::string& path);
 
     [[nodiscard]] static SpirvResult
     CompileToSPIRV(const std::string& source, ShaderStage stage, const std::string& path);
 
+    // Reflects the compiled SPIR-V, then Create().
+    ShaderHandle
+    CreateFromSpirv(const std::string& name, const std::string& path, ShaderStage stage, const SpirvResult& spirv);
+    ShaderHandle Create(const std::string& name,
+                        const std::string& path,
+                        ShaderStage stage,
+                        std::span<const uint8_t> spirv,
+                        const ShaderResources& resources);
+    ShaderHandle Register(const std::string& name, std::unique_ptr<Shader> shader);
+
     GPUContext* m_context;
-    std::unordered_map<std::string, std::unique_ptr<Shader>> m_shaders;
+    Core::SlotArray<std::unique_ptr<Shader>, Shader> m_shaders;
+    std::unordered_map<std::string, ShaderHandle> m_names;
 };
 } // namespace Graphics
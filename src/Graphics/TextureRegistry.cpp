@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 #include "../Core/Logger.hpp"
@@ -37,24 +38,12 @@ TextureRegistry::TextureRegistry(GPUContext* context) : m_context(context)
 
 TextureRegistry::~TextureRegistry()
 {
-    SDL_GPUDevice* device = m_context->GetDevice();
-
-    for (auto& [name, buffer] : m_buffers)
-    {
-        if (buffer.m_textureA.Handle)
-        {
-            SDL_ReleaseGPUTexture(device, buffer.m_textureA.Handle);
-        }
-        if (buffer.m_textureB.Handle)
-        {
-            SDL_ReleaseGPUTexture(device, buffer.m_textureB.Handle);
-        }
-    }
-    m_buffers.clear();
+    m_buffers.ForEach([this](PingPongBuffer& buffer) { Release(buffer); });
     LOG_INFO("TextureRegistry: Resources destroyed");
 }
 
-void TextureRegistry::CreatePingPong(const std::string& name, uint32_t width, uint32_t height, uint32_t preferredFormat)
+PingPongHandle
+TextureRegistry::CreatePingPong(const std::string& name, uint32_t width, uint32_t height, uint32_t preferredFormat)
 {
     SDL_GPUDevice* device = m_context->GetDevice();
 
@@ -95,13 +84,31 @@ void TextureRegistry::CreatePingPong(const std::string& name, uint32_t width, ui
     buffer.m_textureA = CreateTextureInternal(width, height, chosenFormat, nameA.c_str());
     buffer.m_textureB = CreateTextureInternal(width, height, chosenFormat, nameB.c_str());
 
-    m_buffers[name] = buffer;
+    if (const auto it = m_names.find(name); it != m_names.end())
+    {
+        LOG_WARN("TextureRegistry: Replacing PingPong '{}'", name);
+        Destroy(it->second);
+    }
+
+    const PingPongHandle handle = m_buffers.Insert(buffer);
+    m_names[name] = handle;
 
     LOG_INFO("TextureRegistry: Created PingPong '{}' [{}x{}, Fmt:{}]",
              name,
              width,
              height,
              std::to_underlying(chosenFormat));
+    return handle;
+}
+
+void TextureRegistry::Destroy(PingPongHandle handle)
+{
+    PingPongBuffer buffer;
+    if (m_buffers.Remove(handle, buffer))
+    {
+        Release(buffer);
+        std::erase_if(m_names, [handle](const auto& entry) { return entry.second == handle; });
+    }
 }
 
 Texture2D
@@ -134,20 +141,36 @@ TextureRegistry::CreateTextureInternal(uint32_t width, uint32_t height, uint32_t
     return Texture2D{.Handle = handle, .Width = width, .Height = height, .Format = format};
 }
 
-PingPongBuffer* TextureRegistry::GetBuffer(const std::string& name)
+void TextureRegistry::Swap(PingPongHandle handle)
 {
-    if (m_buffers.contains(name))
+    if (PingPongBuffer* buffer = m_buffers.Get(handle))
     {
-        return &m_buffers[name];
+        buffer->Swap();
     }
-    return nullptr;
 }
 
-void TextureRegistry::Swap(const std::string& name)
+PingPongHandle TextureRegistry::Find(const std::string& name) const
 {
-    if (m_buffers.contains(name))
+    if (const auto it = m_names.find(name); it != m_names.end())
+    {
+        return it->second;
+    }
+    LOG_WARN("TextureRegistry: PingPong '{}' not found", name);
+    return {};
+}
+
+void TextureRegistry::Release(PingPongBuffer& buffer)
+{
+    SDL_GPUDevice* device = m_context->GetDevice();
+
+    if (buffer.m_textureA.Handle)
+    {
+        SDL_ReleaseGPUTexture(device, buffer.m_textureA.Handle);
+    }
+    if (buffer.m_textureB.Handle)
     {
-        m_buffers[name].Swap();
+        SDL_ReleaseGPUTexture(device, buffer.m_textureB.Handle);
     }
+    buffer = PingPongBuffer{};
 }
 } // namespace Graphics
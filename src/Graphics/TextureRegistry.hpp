@@ -4,6 +4,8 @@
 #include <string>
 #include <unordered_map>
 
+#include "../Core/SlotArray.hpp"
+
 struct SDL_GPUTexture;
 
 namespace Graphics
@@ -34,6 +36,10 @@ class PingPongBuffer
     bool m_swapState = false;
 };
 
+using PingPongHandle = Core::SlotHandle<PingPongBuffer>;
+
+// Owns the ping-pong texture pairs. Creation returns a handle, which is what per-frame code resolves; names are
+// kept for setup and debugging.
 class TextureRegistry
 {
 public:
@@ -45,16 +51,24 @@ class TextureRegistry
     TextureRegistry(TextureRegistry&&) noexcept = default;
     TextureRegistry& operator=(TextureRegistry&&) noexcept = default;
 
-    void CreatePingPong(const std::string& name, uint32_t width, uint32_t height, uint32_t preferredFormat);
+    // Replaces any pair already registered under the name, whose handles then stop resolving.
+    PingPongHandle CreatePingPong(const std::string& name, uint32_t width, uint32_t height, uint32_t preferredFormat);
+    void Destroy(PingPongHandle handle);
+
+    // Null once the pair has been destroyed or replaced.
+    [[nodiscard]] PingPongBuffer* GetBuffer(PingPongHandle handle) { return m_buffers.Get(handle); }
 
-    [[nodiscard]] PingPongBuffer* GetBuffer(const std::string& name);
+    void Swap(PingPongHandle handle);
 
-    void Swap(const std::string& name);
+    // Setup and debugging only: hashes the name.
+    [[nodiscard]] PingPongHandle Find(const std::string& name) const;
 
 private:
     Texture2D CreateTextureInternal(uint32_t width, uint32_t height, uint32_t format, const char* debugName);
+    void Release(PingPongBuffer& buffer);
 
     GPUContext* m_context;
-    std::unordered_map<std::string, PingPongBuffer> m_buffers;
+    Core::SlotArray<PingPongBuffer, PingPongBuffer> m_buffers;
+    std::unordered_map<std::string, PingPongHandle> m_names;
 };
 } // namespace Graphics
@@ -0,0 +1,189 @@
+#include "UploadStream.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+#include "../Core/Logger.hpp"
+
+namespace Graphics
+{
+namespace
+{
+constexpr size_t kExpectedCopiesPerFrame = 32;
+
+uint32_t AlignUp(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+} // namespace
+
+UploadStream::UploadStream(SDL_GPUDevice* device, uint32_t capacity) : m_device(device), m_capacity(capacity)
+{
+    const SDL_PropertiesID props = SDL_CreateProperties();
+    SDL_SetStringProperty(props, SDL_PROP_GPU_TRANSFERBUFFER_CREATE_NAME_STRING, "UploadStream");
+
+    const SDL_GPUTransferBufferCreateInfo createInfo{
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD, .size = capacity, .props = props};
+
+    m_transferBuffer = SDL_CreateGPUTransferBuffer(m_device, &createInfo);
+
+    SDL_DestroyProperties(props);
+
+    if (!m_transferBuffer)
+    {
+        LOG_ERROR("UploadStream: Failed to create transfer buffer: {}", SDL_GetError());
+        throw std::runtime_error("Transfer Buffer Creation Failed");
+    }
+
+    m_pending.reserve(kExpectedCopiesPerFrame);
+
+    LOG_INFO("UploadStream: Created ({} KiB)", capacity / 1024);
+}
+
+UploadStream::~UploadStream()
+{
+    if (m_mapped)
+    {
+        SDL_UnmapGPUTransferBuffer(m_device, m_transferBuffer);
+    }
+    SDL_ReleaseGPUTransferBuffer(m_device, m_transferBuffer);
+}
+
+std::byte* UploadStream::Allocate(uint32_t size, uint32_t& outOffset)
+{
+    const uint32_t offset = AlignUp(m_cursor, kAlignment);
+
+    if (offset + size > m_capacity)
+    {
+        LOG_WARN("UploadStream: Out of staging space ({} + {} > {} bytes)", offset, size, m_capacity);
+        return nullptr;
+    }
+
+    if (!m_mapped)
+    {
+        // Cycling hands back fresh backing memory if the GPU still reads the previous frame's contents.
+        m_mapped = static_cast<std::byte*>(SDL_MapGPUTransferBuffer(m_device, m_transferBuffer, true));
+        if (!m_mapped)
+        {
+            LOG_ERROR("UploadStream: Failed to map transfer buffer: {}", SDL_GetError());
+            return nullptr;
+        }
+    }
+
+    m_cursor = offset + size;
+    m_highWaterMark = std::max(m_highWaterMark, m_cursor);
+    outOffset = offset;
+    return m_mapped + offset;
+}
+
+bool UploadStream::StageBuffer(SDL_GPUBuffer* destination,
+                               uint32_t destinationOffset,
+                               std::span<const std::byte> data)
+{
+    if (!destination)
+    {
+        return false;
+    }
+
+    const auto size = static_cast<uint32_t>(data.size());
+    uint32_t sourceOffset = 0;
+    std::byte* dst = Allocate(size, sourceOffset);
+
+    if (!dst)
+    {
+        return false;
+    }
+
+    std::memcpy(dst, data.data(), size);
+    m_pending.push_back(PendingCopy{.Buffer = destination,
+                                    .SourceOffset = sourceOffset,
+                                    .DestinationOffset = destinationOffset,
+                                    .Size = size});
+    return true;
+}
+
+bool UploadStream::StageTexture(SDL_GPUTexture* destination,
+                                uint32_t width,
+                                uint32_t height,
+                                std::span<const std::byte> data)
+{
+    if (!destination)
+    {
+        return false;
+    }
+
+    const auto size = static_cast<uint32_t>(data.size());
+    uint32_t sourceOffset = 0;
+    std::byte* dst = Allocate(size, sourceOffset);
+
+    if (!dst)
+    {
+        return false;
+    }
+
+    std::memcpy(dst, data.data(), size);
+    m_pending.push_back(PendingCopy{.Texture = destination,
+                                    .SourceOffset = sourceOffset,
+                                    .Size = size,
+                                    .Width = width,
+                                    .Height = height});
+    return true;
+}
+
+void UploadStream::Flush(SDL_GPUCommandBuffer* cmd)
+{
+    if (m_mapped)
+    {
+        SDL_UnmapGPUTransferBuffer(m_device, m_transferBuffer);
+        m_mapped = nullptr;
+    }
+
+    if (cmd && !m_pending.empty())
+    {
+        SDL_GPUCopyPass* pass = SDL_BeginGPUCopyPass(cmd);
+
+        for (const PendingCopy& copy : m_pending)
+        {
+            if (copy.Buffer)
+            {
+                const SDL_GPUTransferBufferLocation source{.transfer_buffer = m_transferBuffer,
+                                                           .offset = copy.SourceOffset};
+                const SDL_GPUBufferRegion region{
+                    .buffer = copy.Buffer, .offset = copy.DestinationOffset, .size = copy.Size};
+                SDL_UploadToGPUBuffer(pass, &source, &region, false);
+            }
+            else
+            {
+                const SDL_GPUTextureTransferInfo source{.transfer_buffer = m_transferBuffer,
+                                                        .offset = copy.SourceOffset,
+                                                        .pixels_per_row = copy.Width,
+                                                        .rows_per_layer = copy.Height};
+                const SDL_GPUTextureRegion region{
+                    .texture = copy.Texture, .w = copy.Width, .h = copy.Height, .d = 1};
+                SDL_UploadToGPUTexture(pass, &source, &region, false);
+            }
+        }
+
+        SDL_EndGPUCopyPass(pass);
+    }
+
+    m_pending.clear();
+    m_cursor = 0;
+}
+
+uint32_t UploadStream::GetCapacity() const
+{
+    return m_capacity;
+}
+
+uint32_t UploadStream::GetHighWaterMark() const
+{
+    return m_highWaterMark;
+}
+} // namespace Graphics
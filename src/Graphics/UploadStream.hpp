@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct SDL_GPUDevice;
+struct SDL_GPUBuffer;
+struct SDL_GPUTexture;
+struct SDL_GPUTransferBuffer;
+struct SDL_GPUCommandBuffer;
+
+namespace Graphics
+{
+// Per-frame CPU->GPU staging. Data is written straight into a persistently owned transfer buffer that is
+// re-mapped with cycling once per frame, and every staged region is copied in a single copy pass on Flush.
+class UploadStream
+{
+public:
+    static constexpr uint32_t kAlignment = 16; // Every staged region starts on this boundary
+
+    UploadStream(SDL_GPUDevice* device, uint32_t capacity);
+    ~UploadStream();
+
+    UploadStream(const UploadStream&) = delete;
+    UploadStream& operator=(const UploadStream&) = delete;
+    UploadStream(UploadStream&&) = delete;
+    UploadStream& operator=(UploadStream&&) = delete;
+
+    bool StageBuffer(SDL_GPUBuffer* destination, uint32_t destinationOffset, std::span<const std::byte> data);
+    bool StageTexture(SDL_GPUTexture* destination, uint32_t width, uint32_t height, std::span<const std::byte> data);
+
+    template <typename T>
+    bool StageBuffer(SDL_GPUBuffer* destination, std::span<const T> data)
+    {
+        return StageBuffer(destination, 0, std::as_bytes(data));
+    }
+
+    void Flush(SDL_GPUCommandBuffer* cmd);
+
+    [[nodiscard]] uint32_t GetCapacity() const;
+    [[nodiscard]] uint32_t GetHighWaterMark() const;
+
+private:
+    struct PendingCopy
+    {
+        SDL_GPUBuffer* Buffer = nullptr;
+        SDL_GPUTexture* Texture = nullptr;
+        uint32_t SourceOffset = 0;
+        uint32_t DestinationOffset = 0;
+        uint32_t Size = 0;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+    };
+
+    std::byte* Allocate(uint32_t size, uint32_t& outOffset);
+
+    SDL_GPUDevice* m_device;
+    SDL_GPUTransferBuffer* m_transferBuffer = nullptr;
+    std::byte* m_mapped = nullptr;
+    uint32_t m_capacity;
+    uint32_t m_cursor = 0;
+    uint32_t m_highWaterMark = 0;
+    std::vector<PendingCopy> m_pending;
+};
+} // namespace Graphics
@@ -0,0 +1,74 @@
+#include "VorticityPass.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+#include "../Core/Logger.hpp"
+#include "Shader.hpp"
+#include "ShaderLibrary.hpp"
+
+namespace Graphics
+{
+namespace
+{
+struct VorticityUniforms
+{
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    uint32_t BandCount = 0;
+    float TimeStep = 0.0F;
+};
+} // namespace
+
+VorticityPass::VorticityPass(ShaderLibrary* shaders)
+    : m_shaders(shaders), m_shader(shaders->LoadCompute("Vorticity", "shaders/Vorticity.comp.hlsl"))
+{
+    const Shader* shader = m_shaders->Get(m_shader);
+    if (!shader || shader->GetMetadata().ThreadCountX == 0 || shader->GetMetadata().ThreadCountY == 0)
+    {
+        LOG_ERROR("VorticityPass: Compute shader has no usable thread group size");
+        throw std::runtime_error("Vorticity Pass Creation Failed");
+    }
+}
+
+void VorticityPass::Dispatch(SDL_GPUCommandBuffer* cmd,
+                             const VorticityBuffers& buffers,
+                             uint32_t width,
+                             uint32_t height,
+                             uint32_t bandCount,
+                             float dt) const
+{
+    const Shader* shader = m_shaders->Get(m_shader);
+    if (!shader)
+    {
+        return;
+    }
+
+    const std::array<SDL_GPUStorageBufferReadWriteBinding, 2> outputs{
+        SDL_GPUStorageBufferReadWriteBinding{.buffer = buffers.VelocityXOut, .cycle = false},
+        SDL_GPUStorageBufferReadWriteBinding{.buffer = buffers.VelocityYOut, .cycle = false}};
+    const std::array<SDL_GPUBuffer*, 3> inputs{buffers.VelocityXIn, buffers.VelocityYIn, buffers.BandStrength};
+
+    SDL_GPUComputePass* pass = SDL_BeginGPUComputePass(cmd, nullptr, 0, outputs.data(), outputs.size());
+    if (!pass)
+    {
+        LOG_ERROR("VorticityPass: Failed to begin compute pass: {}", SDL_GetError());
+        return;
+    }
+
+    const VorticityUniforms uniforms{.Width = width, .Height = height, .BandCount = bandCount, .TimeStep = dt};
+    const ShaderMetadata& meta = shader->GetMetadata();
+
+    SDL_BindGPUComputePipeline(pass, shader->GetComputeHandle());
+    SDL_BindGPUComputeStorageBuffers(pass, 0, inputs.data(), inputs.size());
+    SDL_PushGPUComputeUniformData(cmd, 0, &uniforms, sizeof(uniforms));
+    SDL_DispatchGPUCompute(pass,
+                           (width + meta.ThreadCountX - 1) / meta.ThreadCountX,
+                           (height + meta.ThreadCountY - 1) / meta.ThreadCountY,
+                           1);
+    SDL_EndGPUComputePass(pass);
+}
+} // namespace Graphics
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ShaderLibrary.hpp"
+
+struct SDL_GPUBuffer;
+struct SDL_GPUCommandBuffer;
+
+namespace Graphics
+{
+struct VorticityBuffers
+{
+    SDL_GPUBuffer* VelocityXIn = nullptr;
+    SDL_GPUBuffer* VelocityYIn = nullptr;
+    SDL_GPUBuffer* BandStrength = nullptr; // One float per band
+    SDL_GPUBuffer* VelocityXOut = nullptr;
+    SDL_GPUBuffer* VelocityYOut = nullptr;
+};
+
+// GPU counterpart of the solver's fused curl + vorticity confinement pass, for velocity fields kept in
+// row-major float storage buffers. Curl stays in groupshared memory. The engine does not build it yet: the
+// solver's velocity lives on the CPU, and uploading it and reading it back every step would cost more than the
+// CPU pass saves, so it waits for a GPU velocity field rather than compiling a shader nothing dispatches.
+class VorticityPass
+{
+public:
+    explicit VorticityPass(ShaderLibrary* shaders);
+
+    void Dispatch(SDL_GPUCommandBuffer* cmd,
+                  const VorticityBuffers& buffers,
+                  uint32_t width,
+                  uint32_t height,
+                  uint32_t bandCount,
+                  float dt) const;
+
+private:
+    const ShaderLibrary* m_shaders;
+    ShaderHandle m_shader;
+};
+} // namespace Graphics
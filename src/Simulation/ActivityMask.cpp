@@ -0,0 +1,209 @@
+#include "ActivityMask.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+#include "../Core/JobSystem.hpp"
+#include "../Core/Logger.hpp"
+#include "Field2D.hpp"
+
+namespace Simulation
+{
+ActivityMask::ActivityMask(uint32_t width, uint32_t height, uint32_t tileSize, const ActivitySettings& settings)
+    : m_settings(settings),
+      m_width(width),
+      m_height(height),
+      m_tileSize(tileSize),
+      m_tilesX(tileSize > 0 ? (width + tileSize - 1) / tileSize : 0),
+      m_tilesY(tileSize > 0 ? (height + tileSize - 1) / tileSize : 0)
+{
+    if (width == 0 || height == 0 || tileSize == 0)
+    {
+        LOG_ERROR("ActivityMask: Invalid layout {}x{} with {} cell tiles", width, height, tileSize);
+        throw std::invalid_argument("ActivityMask: Invalid layout");
+    }
+
+    const size_t tileCount = static_cast<size_t>(m_tilesX) * m_tilesY;
+    m_peakSpeedSq.assign(tileCount, 0.0F);
+    m_peakDye.assign(tileCount, 0.0F);
+    m_quietSteps.assign(tileCount, 0);
+    m_awake.assign(tileCount, 1);
+    m_active.assign(tileCount, 1);
+    m_activeRuns.resize(tileCount);
+    m_quietRuns.resize(tileCount);
+    m_activeRunCounts.assign(m_tilesY, 0);
+    m_quietRunCounts.assign(m_tilesY, 0);
+
+    BuildRuns();
+}
+
+void ActivityMask::Update(const Field2D& velocityX,
+                          const Field2D& velocityY,
+                          const Field2D& dye,
+                          Core::JobSystem* jobSystem)
+{
+    if (jobSystem)
+    {
+        jobSystem->ParallelFor(m_tilesY, 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t tileY = begin; tileY < end; ++tileY)
+            {
+                MeasureTileRow(tileY, velocityX, velocityY, dye);
+            }
+        });
+    }
+    else
+    {
+        for (uint32_t tileY = 0; tileY < m_tilesY; ++tileY)
+        {
+            MeasureTileRow(tileY, velocityX, velocityY, dye);
+        }
+    }
+
+    for (size_t tile = 0; tile < m_awake.size(); ++tile)
+    {
+        const float wake = m_peakDye[tile] > m_settings.DyeThreshold ? m_settings.DyeWakeSpeed : m_settings.WakeSpeed;
+        const float sleep = wake * m_settings.SleepRatio;
+        const float peak = m_peakSpeedSq[tile];
+
+        if (peak > wake * wake)
+        {
+            m_awake[tile] = 1;
+            m_quietSteps[tile] = 0;
+        }
+        else if (peak < sleep * sleep)
+        {
+            if (++m_quietSteps[tile] >= m_settings.QuietSteps)
+            {
+                m_awake[tile] = 0;
+            }
+        }
+        else
+        {
+            m_quietSteps[tile] = 0;
+        }
+    }
+
+    std::ranges::fill(m_active, 0);
+    const auto reach = static_cast<int32_t>(m_settings.Dilation);
+
+    for (int32_t ty = 0; ty < static_cast<int32_t>(m_tilesY); ++ty)
+    {
+        for (int32_t tx = 0; tx < static_cast<int32_t>(m_tilesX); ++tx)
+        {
+            if (!m_awake[(static_cast<size_t>(ty) * m_tilesX) + tx])
+            {
+                continue;
+            }
+
+            const int32_t y0 = std::max(ty - reach, 0);
+            const int32_t y1 = std::min(ty + reach, static_cast<int32_t>(m_tilesY) - 1);
+            const int32_t x0 = std::max(tx - reach, 0);
+            const int32_t x1 = std::min(tx + reach, static_cast<int32_t>(m_tilesX) - 1);
+
+            for (int32_t y = y0; y <= y1; ++y)
+            {
+                std::fill_n(m_active.begin() + ((static_cast<ptrdiff_t>(y) * m_tilesX) + x0), x1 - x0 + 1, 1);
+            }
+        }
+    }
+
+    BuildRuns();
+}
+
+void ActivityMask::MeasureTileRow(uint32_t tileY,
+                                  const Field2D& velocityX,
+                                  const Field2D& velocityY,
+                                  const Field2D& dye)
+{
+    const std::span<const float> vx = velocityX.GetData();
+    const std::span<const float> vy = velocityY.GetData();
+    const std::span<const float> density = dye.GetData();
+    const size_t first = static_cast<size_t>(tileY) * m_tilesX;
+    const std::span<float> peaks = std::span(m_peakSpeedSq).subspan(first, m_tilesX);
+    const std::span<float> dyePeaks = std::span(m_peakDye).subspan(first, m_tilesX);
+    std::ranges::fill(peaks, 0.0F);
+    std::ranges::fill(dyePeaks, 0.0F);
+
+    const uint32_t rowEnd = std::min((tileY + 1) * m_tileSize, m_height);
+    for (uint32_t y = tileY * m_tileSize; y < rowEnd; ++y)
+    {
+        const size_t row = static_cast<size_t>(y) * m_width;
+
+        for (uint32_t tileX = 0; tileX < m_tilesX; ++tileX)
+        {
+            const uint32_t begin = tileX * m_tileSize;
+            const uint32_t end = std::min(begin + m_tileSize, m_width);
+
+            float peak = peaks[tileX];
+            float dyePeak = dyePeaks[tileX];
+            for (size_t i = row + begin; i < row + end; ++i)
+            {
+                peak = std::max(peak, (vx[i] * vx[i]) + (vy[i] * vy[i]));
+                dyePeak = std::max(dyePeak, density[i]);
+            }
+            peaks[tileX] = peak;
+            dyePeaks[tileX] = dyePeak;
+        }
+    }
+}
+
+void ActivityMask::BuildRuns()
+{
+    size_t activeCells = 0;
+
+    for (uint32_t tileY = 0; tileY < m_tilesY; ++tileY)
+    {
+        const size_t base = static_cast<size_t>(tileY) * m_tilesX;
+        uint32_t activeCount = 0;
+        uint32_t quietCount = 0;
+
+        uint32_t tileX = 0;
+        while (tileX < m_tilesX)
+        {
+            const uint8_t state = m_active[base + tileX];
+            const uint32_t first = tileX;
+            while (tileX < m_tilesX && m_active[base + tileX] == state)
+            {
+                ++tileX;
+            }
+
+            const CellRun run{.Begin = first * m_tileSize, .End = std::min(tileX * m_tileSize, m_width)};
+            if (state)
+            {
+                m_activeRuns[base + activeCount++] = run;
+                activeCells += static_cast<size_t>(run.End - run.Begin) *
+                               (std::min((tileY + 1) * m_tileSize, m_height) - (tileY * m_tileSize));
+            }
+            else
+            {
+                m_quietRuns[base + quietCount++] = run;
+            }
+        }
+
+        m_activeRunCounts[tileY] = activeCount;
+        m_quietRunCounts[tileY] = quietCount;
+    }
+
+    m_activeFraction = static_cast<float>(activeCells) / static_cast<float>(static_cast<size_t>(m_width) * m_height);
+}
+
+std::span<const CellRun> ActivityMask::GetRuns(uint32_t y, CellActivity activity) const
+{
+    const uint32_t tileY = y / m_tileSize;
+    const size_t base = static_cast<size_t>(tileY) * m_tilesX;
+
+    if (activity == CellActivity::Active)
+    {
+        return std::span(m_activeRuns).subspan(base, m_activeRunCounts[tileY]);
+    }
+    return std::span(m_quietRuns).subspan(base, m_quietRunCounts[tileY]);
+}
+
+float ActivityMask::GetActiveFraction() const
+{
+    return m_activeFraction;
+}
+} // namespace Simulation
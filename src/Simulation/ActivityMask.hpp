@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Core
+{
+class JobSystem;
+} // namespace Core
+
+namespace Simulation
+{
+class Field2D;
+
+// Speeds are in cells per second. Slow flow barely changes the velocity field, so a tile needs WakeSpeed to wake,
+// but dye is visibly carried at far lower speeds, so tiles holding dye wake at DyeWakeSpeed.
+struct ActivitySettings
+{
+    float WakeSpeed = 1.0F;
+    float DyeWakeSpeed = 0.05F;
+    float DyeThreshold = 0.01F; // Dye density below which a tile counts as empty
+    float SleepRatio = 0.5F;    // A tile counts as quiet below its wake speed times this
+    uint32_t QuietSteps = 30;   // Consecutive quiet steps before a tile sleeps
+    uint32_t Dilation = 1;      // Tiles around every awake tile that are processed as well
+};
+
+enum class CellActivity : std::uint8_t
+{
+    Active, // Processed by the sweeping kernels
+    Quiet   // Skipped; the solver only carries these cells over
+};
+
+// Columns [Begin, End) of one row.
+struct CellRun
+{
+    uint32_t Begin = 0;
+    uint32_t End = 0;
+};
+
+// Per-tile activity of the fluid grid, with hysteresis: a tile wakes as soon as any cell in it moves faster
+// than its wake speed, but sleeps only after QuietSteps steps below the lower threshold, so a decaying impulse
+// does not flicker. Awake tiles are dilated to cover whatever flows in from their neighbours, and the result is
+// kept as runs of active and quiet columns per tile row. Everything starts awake.
+class ActivityMask
+{
+public:
+    ActivityMask(uint32_t width, uint32_t height, uint32_t tileSize, const ActivitySettings& settings = {});
+
+    void Update(const Field2D& velocityX, const Field2D& velocityY, const Field2D& dye, Core::JobSystem* jobSystem);
+
+    [[nodiscard]] std::span<const CellRun> GetRuns(uint32_t y, CellActivity activity) const;
+
+    // Share of the grid's cells in active runs, in [0, 1].
+    [[nodiscard]] float GetActiveFraction() const;
+
+private:
+    void MeasureTileRow(uint32_t tileY, const Field2D& velocityX, const Field2D& velocityY, const Field2D& dye);
+    void BuildRuns();
+
+    ActivitySettings m_settings;
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_tileSize;
+    uint32_t m_tilesX;
+    uint32_t m_tilesY;
+
+    std::vector<float> m_peakSpeedSq; // Per tile, from the last Update
+    std::vector<float> m_peakDye;
+    std::vector<uint32_t> m_quietSteps;
+    std::vector<uint8_t> m_awake;
+    std::vector<uint8_t> m_active; // m_awake after dilation
+
+    // m_tilesX run slots per tile row and kind, which is more than alternating runs can ever need.
+    std::vector<CellRun> m_activeRuns;
+    std::vector<CellRun> m_quietRuns;
+    std::vector<uint32_t> m_activeRunCounts;
+    std::vector<uint32_t> m_quietRunCounts;
+    float m_activeFraction = 1.0F;
+};
+} // namespace Simulation
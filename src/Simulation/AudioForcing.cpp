@@ -0,0 +1,57 @@
+#include "AudioForcing.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "../Audio/AudioConfig.hpp"
+#include "../Audio/BandReducer.hpp"
+#include "FluidSolver.hpp"
+
+namespace Simulation
+{
+namespace
+{
+constexpr float kSwirlRatio = 0.35F;
+} // namespace
+
+AudioForcing::AudioForcing(const AudioForcingSettings& settings) : m_settings(settings) {}
+
+void AudioForcing::Emit(const Audio::BandArray& bands, std::pmr::vector<Splat>& outSplats) const
+{
+    outSplats.clear();
+    outSplats.reserve(bands.size());
+
+    for (size_t band = 0; band < bands.size(); ++band)
+    {
+        const float level = bands[band] - m_settings.Threshold;
+        if (level <= 0.0F)
+        {
+            continue;
+        }
+
+        const float x = (static_cast<float>(band) + 0.5F) / static_cast<float>(Audio::Config::kBandCount);
+        const float swirl = (band % 2 == 0) ? kSwirlRatio : -kSwirlRatio;
+        const float force = level * m_settings.ForceGain;
+
+        outSplats.push_back(Splat{.X = x,
+                                  .Y = m_settings.EmitterHeight,
+                                  .ForceX = force * swirl,
+                                  .ForceY = force,
+                                  .Radius = m_settings.Radius,
+                                  .Dye = level * m_settings.DyeGain});
+    }
+}
+
+Audio::BandArray AudioForcing::ComputeConfinement(const Audio::BandArray& bands) const
+{
+    Audio::BandArray strengths{};
+    for (size_t band = 0; band < bands.size(); ++band)
+    {
+        const float level = std::max(bands[band] - m_settings.Threshold, 0.0F);
+        strengths[band] = m_settings.ConfinementBase + (level * m_settings.ConfinementGain);
+    }
+    return strengths;
+}
+} // namespace Simulation
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory_resource>
+#include <vector>
+
+#include "../Audio/BandReducer.hpp"
+#include "FluidSolver.hpp"
+
+namespace Simulation
+{
+struct AudioForcingSettings
+{
+    float Threshold = 0.002F; // Band level below which an emitter stays silent
+    float ForceGain = 4000.0F;
+    float DyeGain = 60.0F;
+    float Radius = 0.015F;
+    float EmitterHeight = 0.08F;
+    float ConfinementBase = 0.5F;   // Vorticity confinement strength with the band silent
+    float ConfinementGain = 150.0F; // Added strength per unit of band level above the threshold
+};
+
+// Maps smoothed audio bands to splats: one emitter per band spread along the floor of the domain,
+// low bands on the left, pushing upward with alternating lateral swirl. Purely a function of the
+// bands, so recorded runs replay identically.
+class AudioForcing
+{
+public:
+    explicit AudioForcing(const AudioForcingSettings& settings = {});
+
+    void Emit(const Audio::BandArray& bands, std::pmr::vector<Splat>& outSplats) const;
+
+    // Vorticity confinement strength per band, for the band's slice of columns above its emitter.
+    [[nodiscard]] Audio::BandArray ComputeConfinement(const Audio::BandArray& bands) const;
+
+private:
+    AudioForcingSettings m_settings;
+};
+} // namespace Simulation
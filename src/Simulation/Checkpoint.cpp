@@ -0,0 +1,371 @@
+#include "Checkpoint.hpp"
+
+#include <lz4.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../Core/Clock.hpp"
+#include "../Core/Logger.hpp"
+#include "../Core/MappedFile.hpp"
+#include "FluidSolver.hpp"
+#include "ParticleSystem.hpp"
+
+namespace Simulation
+{
+namespace
+{
+constexpr uint32_t kMaxBlocks = 64; // Sanity bound on the table of a file from elsewhere
+constexpr double kMillisecondsPerSecond = 1000.0;
+constexpr size_t kBytesPerKiB = 1024;
+
+static_assert(std::is_trivially_copyable_v<CheckpointHeader> && std::is_trivially_copyable_v<CheckpointBlock>);
+static_assert(sizeof(CheckpointHeader) % alignof(CheckpointBlock) == 0);
+
+[[nodiscard]] uint64_t AlignUp(uint64_t value)
+{
+    return (value + CheckpointHeader::kBlockAlignment - 1) & ~(CheckpointHeader::kBlockAlignment - 1);
+}
+
+template <typename T>
+void Stage(std::vector<std::byte>& destination, std::span<const T> source)
+{
+    const std::span<const std::byte> bytes = std::as_bytes(source);
+    destination.assign(bytes.begin(), bytes.end()); // Reuses the capacity of earlier checkpoints
+}
+
+void WriteBytes(std::ofstream& file, std::span<const std::byte> bytes)
+{
+    file.write(reinterpret_cast<const char*>(bytes.data()), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+               static_cast<std::streamsize>(bytes.size()));
+}
+
+void PadTo(std::ofstream& file, uint64_t offset)
+{
+    static constexpr std::array<std::byte, CheckpointHeader::kBlockAlignment> kZeros{};
+    const auto position = static_cast<uint64_t>(file.tellp());
+    WriteBytes(file, std::span(kZeros).first(offset - position));
+}
+} // namespace
+
+CheckpointWriter::CheckpointWriter(CheckpointSettings settings,
+                                   const FluidSolver& solver,
+                                   const ParticleSystem* particles)
+    : m_settings(std::move(settings)),
+      m_thread([this](const std::stop_token& stopToken) { Run(stopToken); })
+{
+    const FluidSettings& grid = solver.GetSettings();
+    const size_t fieldBytes = sizeof(float) * grid.Width * grid.Height;
+    const size_t particleBytes = particles ? sizeof(float) * particles->GetSettings().Capacity : 0;
+
+    for (size_t i = 0; i < kBlockCount; ++i)
+    {
+        const bool particleBlock = i >= static_cast<size_t>(CheckpointBlockId::ParticlePositionX);
+        m_staged[i].reserve(particleBlock ? particleBytes : fieldBytes);
+    }
+
+    LOG_INFO("Checkpoint: Writing to '{}'{}", m_settings.Path, m_settings.Compress ? " (LZ4)" : "");
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+    Flush();
+
+    if (m_skipped > 0)
+    {
+        LOG_WARN("Checkpoint: Skipped {} checkpoints while a write was still running", m_skipped);
+    }
+}
+
+bool CheckpointWriter::Submit(uint64_t step, const FluidSolver& solver, const ParticleSystem* particles)
+{
+    {
+        const std::scoped_lock lock(m_mutex);
+        if (m_pending)
+        {
+            ++m_skipped;
+            return false;
+        }
+    }
+
+    const FluidSettings& settings = solver.GetSettings();
+    m_header = CheckpointHeader{.Width = settings.Width,
+                                .Height = settings.Height,
+                                .Step = step,
+                                .BlockCount = static_cast<uint32_t>(kBlockCount)};
+
+    const auto stage = [this](CheckpointBlockId id, const auto& source) {
+        Stage(m_staged[static_cast<size_t>(id)], std::span(source));
+    };
+
+    stage(CheckpointBlockId::VelocityX, solver.GetVelocityX().GetData());
+    stage(CheckpointBlockId::VelocityY, solver.GetVelocityY().GetData());
+    stage(CheckpointBlockId::Pressure, solver.GetPressure().GetData());
+    stage(CheckpointBlockId::Dye, solver.GetDye().GetData());
+
+    // Without a particle system the particle blocks are written empty.
+    static const ParticleArrays kNoParticles;
+    const ParticleArrays& tracers = particles ? particles->GetParticles() : kNoParticles;
+    stage(CheckpointBlockId::ParticlePositionX, tracers.PositionX);
+    stage(CheckpointBlockId::ParticlePositionY, tracers.PositionY);
+    stage(CheckpointBlockId::ParticleAge, tracers.Age);
+    stage(CheckpointBlockId::ParticleColor, tracers.Color);
+
+    {
+        const std::scoped_lock lock(m_mutex);
+        m_pending = true;
+    }
+    m_condition.notify_all();
+    return true;
+}
+
+void CheckpointWriter::Flush()
+{
+    std::unique_lock lock(m_mutex);
+    m_condition.wait(lock, [this] { return !m_pending; });
+}
+
+uint64_t CheckpointWriter::GetSkippedCount() const
+{
+    return m_skipped;
+}
+
+void CheckpointWriter::Run(const std::stop_token& stopToken)
+{
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            if (!m_condition.wait(lock, stopToken, [this] { return m_pending; }))
+            {
+                return;
+            }
+        }
+
+        Write();
+
+        {
+            const std::scoped_lock lock(m_mutex);
+            m_pending = false;
+        }
+        m_condition.notify_all();
+    }
+}
+
+void CheckpointWriter::Write()
+{
+    const Core::Clock clock;
+
+    std::array<CheckpointBlock, kBlockCount> blocks{};
+    std::array<std::span<const std::byte>, kBlockCount> payloads{};
+    uint64_t offset = AlignUp(sizeof(CheckpointHeader) + sizeof(blocks));
+
+    for (size_t i = 0; i < kBlockCount; ++i)
+    {
+        const std::vector<std::byte>& raw = m_staged[i];
+        payloads[i] = raw;
+        blocks[i] = CheckpointBlock{.Id = static_cast<CheckpointBlockId>(i),
+                                    .Codec = CheckpointCodec::Raw,
+                                    .Offset = offset,
+                                    .StoredBytes = raw.size(),
+                                    .RawBytes = raw.size()};
+
+        const bool fitsLZ4 = raw.size() <= static_cast<size_t>(LZ4_MAX_INPUT_SIZE);
+        if (m_settings.Compress && !raw.empty() && fitsLZ4)
+        {
+            std::vector<std::byte>& packed = m_compressed[i];
+            packed.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(raw.size()))));
+
+            const int packedBytes =
+                LZ4_compress_default(reinterpret_cast<const char*>(raw.data()), // NOLINT(*-reinterpret-cast)
+                                     reinterpret_cast<char*>(packed.data()),    // NOLINT(*-reinterpret-cast)
+                                     static_cast<int>(raw.size()),
+                                     static_cast<int>(packed.size()));
+
+            if (packedBytes > 0 && static_cast<size_t>(packedBytes) < raw.size())
+            {
+                payloads[i] = std::span<const std::byte>(packed).first(static_cast<size_t>(packedBytes));
+                blocks[i].Codec = CheckpointCodec::LZ4;
+                blocks[i].StoredBytes = payloads[i].size();
+            }
+        }
+
+        offset = AlignUp(offset + blocks[i].StoredBytes);
+    }
+
+    const std::string tempPath = m_settings.Path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            LOG_ERROR("Checkpoint: Failed to open '{}' for writing", tempPath);
+            return;
+        }
+
+        WriteBytes(file, std::as_bytes(std::span(&m_header, 1)));
+        WriteBytes(file, std::as_bytes(std::span(blocks)));
+        for (size_t i = 0; i < kBlockCount; ++i)
+        {
+            PadTo(file, blocks[i].Offset);
+            WriteBytes(file, payloads[i]);
+        }
+
+        file.close();
+        if (!file)
+        {
+            LOG_ERROR("Checkpoint: Failed to write '{}'", tempPath);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, m_settings.Path, error);
+    if (error)
+    {
+        LOG_ERROR("Checkpoint: Failed to replace '{}': {}", m_settings.Path, error.message());
+        return;
+    }
+
+    LOG_INFO("Checkpoint: Saved step {} ({} KiB, {:.1f} ms)",
+             m_header.Step,
+             offset / kBytesPerKiB,
+             clock.GetTotalSeconds() * kMillisecondsPerSecond);
+}
+
+CheckpointReader::CheckpointReader(const std::string& path) : m_file(path), m_header()
+{
+    const std::span<const std::byte> data = m_file.GetData();
+
+    if (data.size() < sizeof(CheckpointHeader))
+    {
+        LOG_ERROR("Checkpoint: '{}' is too small to hold a header", path);
+        throw std::runtime_error("Checkpoint File Invalid");
+    }
+    std::memcpy(&m_header, data.data(), sizeof(CheckpointHeader));
+
+    if (m_header.Magic != CheckpointHeader::kMagic || m_header.Version != CheckpointHeader::kVersion ||
+        m_header.BlockCount > kMaxBlocks)
+    {
+        LOG_ERROR("Checkpoint: '{}' is not a version {} checkpoint", path, CheckpointHeader::kVersion);
+        throw std::runtime_error("Checkpoint File Invalid");
+    }
+
+    const size_t tableBytes = sizeof(CheckpointBlock) * m_header.BlockCount;
+    if (data.size() < sizeof(CheckpointHeader) + tableBytes)
+    {
+        LOG_ERROR("Checkpoint: '{}' is truncated", path);
+        throw std::runtime_error("Checkpoint File Invalid");
+    }
+
+    m_blocks.resize(m_header.BlockCount);
+    std::memcpy(m_blocks.data(), data.data() + sizeof(CheckpointHeader), tableBytes);
+    m_inflated.resize(m_blocks.size());
+
+    for (const CheckpointBlock& block : m_blocks)
+    {
+        const bool inFile = block.Offset <= data.size() && block.StoredBytes <= data.size() - block.Offset;
+        const bool aligned = block.Offset % CheckpointHeader::kBlockAlignment == 0;
+        const bool consistent = block.Codec == CheckpointCodec::LZ4
+                                    ? block.RawBytes <= static_cast<uint64_t>(std::numeric_limits<int>::max())
+                                    : block.Codec == CheckpointCodec::Raw && block.StoredBytes == block.RawBytes;
+
+        if (!inFile || !aligned || !consistent)
+        {
+            LOG_ERROR("Checkpoint: '{}' has a corrupt block table", path);
+            throw std::runtime_error("Checkpoint File Invalid");
+        }
+    }
+
+    LOG_INFO("Checkpoint: Mapped '{}' (step {}, {}x{})", path, m_header.Step, m_header.Width, m_header.Height);
+}
+
+const CheckpointHeader& CheckpointReader::GetHeader() const
+{
+    return m_header;
+}
+
+void CheckpointReader::Restore(FluidSolver& solver, ParticleSystem* particles)
+{
+    const FluidSettings& settings = solver.GetSettings();
+    if (m_header.Width != settings.Width || m_header.Height != settings.Height)
+    {
+        LOG_ERROR("Checkpoint: Saved for a {}x{} grid, not {}x{}",
+                  m_header.Width,
+                  m_header.Height,
+                  settings.Width,
+                  settings.Height);
+        throw std::invalid_argument("Checkpoint Grid Mismatch");
+    }
+
+    solver.Restore(FluidState{.VelocityX = GetArray<float>(CheckpointBlockId::VelocityX),
+                              .VelocityY = GetArray<float>(CheckpointBlockId::VelocityY),
+                              .Pressure = GetArray<float>(CheckpointBlockId::Pressure),
+                              .Dye = GetArray<float>(CheckpointBlockId::Dye)});
+
+    if (particles)
+    {
+        particles->Restore(ParticleView{.PositionX = GetArray<float>(CheckpointBlockId::ParticlePositionX),
+                                        .PositionY = GetArray<float>(CheckpointBlockId::ParticlePositionY),
+                                        .Age = GetArray<float>(CheckpointBlockId::ParticleAge),
+                                        .Color = GetArray<uint32_t>(CheckpointBlockId::ParticleColor)});
+    }
+}
+
+std::span<const std::byte> CheckpointReader::GetBlock(CheckpointBlockId id)
+{
+    const auto found = std::ranges::find(m_blocks, id, &CheckpointBlock::Id);
+    if (found == m_blocks.end())
+    {
+        return {};
+    }
+
+    const CheckpointBlock& block = *found;
+    const std::span<const std::byte> stored = m_file.GetData().subspan(block.Offset, block.StoredBytes);
+    if (block.Codec == CheckpointCodec::Raw)
+    {
+        return stored;
+    }
+
+    std::vector<std::byte>& inflated = m_inflated[static_cast<size_t>(found - m_blocks.begin())];
+    if (inflated.size() != block.RawBytes)
+    {
+        inflated.resize(block.RawBytes);
+        const int bytes = LZ4_decompress_safe(reinterpret_cast<const char*>(stored.data()), // NOLINT(*-reinterpret-cast)
+                                              reinterpret_cast<char*>(inflated.data()),     // NOLINT(*-reinterpret-cast)
+                                              static_cast<int>(stored.size()),
+                                              static_cast<int>(inflated.size()));
+        if (bytes < 0 || static_cast<uint64_t>(bytes) != block.RawBytes)
+        {
+            LOG_ERROR("Checkpoint: Block {} failed to decompress", static_cast<uint32_t>(id));
+            inflated.clear();
+            throw std::runtime_error("Checkpoint Block Corrupt");
+        }
+    }
+    return inflated;
+}
+
+template <typename T>
+std::span<const T> CheckpointReader::GetArray(CheckpointBlockId id)
+{
+    // Raw blocks start on a page boundary and inflated ones come from operator new, so both are aligned for T.
+    const std::span<const std::byte> bytes = GetBlock(id);
+    return {reinterpret_cast<const T*>(bytes.data()), bytes.size() / sizeof(T)}; // NOLINT(*-reinterpret-cast)
+}
+} // namespace Simulation
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Core/MappedFile.hpp"
+
+namespace Simulation
+{
+class FluidSolver;
+class ParticleSystem;
+
+enum class CheckpointBlockId : uint32_t
+{
+    VelocityX,
+    VelocityY,
+    Pressure,
+    Dye,
+    ParticlePositionX,
+    ParticlePositionY,
+    ParticleAge,
+    ParticleColor,
+    Count
+};
+
+enum class CheckpointCodec : uint32_t
+{
+    Raw, // Stored as in memory; restored straight from the mapping
+    LZ4  // Inflated on first access
+};
+
+// File layout: this header, BlockCount CheckpointBlock entries, then every block's data starting on a
+// kBlockAlignment boundary. All values are little-endian, as written by the machine that made the file.
+struct CheckpointHeader
+{
+    static constexpr uint32_t kMagic = 0x4B434641; // "AFCK"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint64_t kBlockAlignment = 4096;
+
+    uint32_t Magic = kMagic;
+    uint32_t Version = kVersion;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    uint64_t Step = 0;
+    uint32_t BlockCount = 0;
+    uint32_t Reserved = 0;
+};
+
+struct CheckpointBlock
+{
+    CheckpointBlockId Id = CheckpointBlockId::Count;
+    CheckpointCodec Codec = CheckpointCodec::Raw;
+    uint64_t Offset = 0;      // From the start of the file
+    uint64_t StoredBytes = 0; // In the file
+    uint64_t RawBytes = 0;    // Once inflated
+};
+
+struct CheckpointSettings
+{
+    std::string Path;
+    bool Compress = true; // LZ4 per block; blocks that do not shrink are stored raw
+};
+
+// Periodic snapshots of the whole simulation state. Submit copies the fields on the calling thread, which
+// is a few memcpys into buffers sized up front, and a background thread compresses and writes them. Files are
+// written next to the target and renamed over it when complete, so a crash mid-write leaves the previous
+// checkpoint intact.
+class CheckpointWriter
+{
+public:
+    CheckpointWriter(CheckpointSettings settings, const FluidSolver& solver, const ParticleSystem* particles);
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+    CheckpointWriter(CheckpointWriter&&) noexcept = delete;
+    CheckpointWriter& operator=(CheckpointWriter&&) noexcept = delete;
+
+    // Call from one thread at a time. Returns false, skipping this checkpoint, while the previous one is still
+    // being written.
+    bool Submit(uint64_t step, const FluidSolver& solver, const ParticleSystem* particles);
+
+    // Blocks until the pending checkpoint, if any, is on disk.
+    void Flush();
+
+    [[nodiscard]] uint64_t GetSkippedCount() const;
+
+private:
+    static constexpr size_t kBlockCount = static_cast<size_t>(CheckpointBlockId::Count);
+
+    void Run(const std::stop_token& stopToken);
+    void Write();
+
+    CheckpointSettings m_settings;
+
+    // Owned by the writer thread while m_pending is set, by Submit otherwise.
+    CheckpointHeader m_header;
+    std::array<std::vector<std::byte>, kBlockCount> m_staged;
+    std::array<std::vector<std::byte>, kBlockCount> m_compressed;
+
+    std::mutex m_mutex;
+    std::condition_variable_any m_condition;
+    bool m_pending = false;
+    uint64_t m_skipped = 0;
+
+    std::jthread m_thread;
+};
+
+// Maps a checkpoint and hands out its blocks without reading the file up front: raw blocks are views into
+// the mapping, so a restore only touches the pages it copies.
+class CheckpointReader
+{
+public:
+    explicit CheckpointReader(const std::string& path);
+
+    [[nodiscard]] const CheckpointHeader& GetHeader() const;
+
+    // Throws std::invalid_argument if the checkpoint was made for a different grid size.
+    void Restore(FluidSolver& solver, ParticleSystem* particles);
+
+private:
+    // Empty if the file has no such block.
+    [[nodiscard]] std::span<const std::byte> GetBlock(CheckpointBlockId id);
+
+    template <typename T>
+    [[nodiscard]] std::span<const T> GetArray(CheckpointBlockId id);
+
+    Core::MappedFile m_file;
+    CheckpointHeader m_header;
+    std::vector<CheckpointBlock> m_blocks;
+    std::vector<std::vector<std::byte>> m_inflated; // Per block, filled on first access to LZ4 blocks
+};
+} // namespace Simulation
@@ -0,0 +1,377 @@
+#include "ConjugateGradient.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+#include "../Core/JobSystem.hpp"
+#include "../Core/Logger.hpp"
+#include "../Core/Simd.hpp"
+#include "ObstacleMask.hpp"
+
+namespace Simulation
+{
+namespace
+{
+constexpr uint32_t kBlockRows = 32;    // Rows per preconditioner block and per reduction partial
+constexpr double kModification = 0.97; // MIC(0) tau: how much dropped fill is moved onto the diagonal
+constexpr double kSafety = 0.25;       // MIC(0) sigma: diagonal floor as a fraction of A's
+constexpr double kMinTarget = 1.0e-20; // Squared residual that counts as solved when b is zero
+constexpr float kDiagonal = 4.0F;      // Clamped-neighbour stencil; a missing neighbour cancels a diagonal term
+
+// ((4 c - (l + r)) - (b + a)), the same operation order as the vector path.
+float Stencil(float centre, float left, float right, float below, float above)
+{
+    return ((kDiagonal * centre) - (left + right)) - (below + above);
+}
+} // namespace
+
+ConjugateGradient::ConjugateGradient(uint32_t width,
+                                     uint32_t height,
+                                     std::span<const uint8_t> flags,
+                                     Core::JobSystem* jobSystem)
+    : m_width(width),
+      m_height(height),
+      m_blockCount((height + kBlockRows - 1) / kBlockRows),
+      m_jobSystem(jobSystem),
+      m_flags(static_cast<size_t>(width) * height, 0),
+      m_plainRows(height, 0),
+      m_offsets(BuildNeighbourOffsets(width)),
+      m_fluidCells(width * height),
+      m_precondition(static_cast<size_t>(width) * height),
+      m_residual(m_precondition.size()),
+      m_search(m_precondition.size()),
+      m_product(m_precondition.size()),
+      m_conditioned(m_precondition.size()),
+      m_sums(m_blockCount)
+{
+    if (width < 2 || height < 2)
+    {
+        LOG_ERROR("ConjugateGradient: Grid {}x{} too small", width, height);
+        throw std::invalid_argument("ConjugateGradient: Grid too small");
+    }
+
+    UpdateFlags(flags, 0, height);
+}
+
+void ConjugateGradient::UpdateFlags(std::span<const uint8_t> flags, uint32_t rowBegin, uint32_t rowEnd)
+{
+    if (flags.size() != m_flags.size() || rowBegin >= rowEnd || rowEnd > m_height)
+    {
+        LOG_ERROR("ConjugateGradient: Flags for rows [{}, {}) do not fit the {}x{} grid",
+                  rowBegin,
+                  rowEnd,
+                  m_width,
+                  m_height);
+        throw std::invalid_argument("ConjugateGradient: Flag Size Mismatch");
+    }
+
+    const auto isSolid = [](uint8_t cell) { return (cell & CellFlags::kSolid) != 0; };
+    const auto solidsIn = [&](uint32_t row) {
+        const auto cells = std::span(m_flags).subspan(static_cast<size_t>(row) * m_width, m_width);
+        return static_cast<uint32_t>(std::ranges::count_if(cells, isSolid));
+    };
+
+    // Fluid cells are kept as a running count so that an edit costs only the rows it touched.
+    for (uint32_t y = rowBegin; y < rowEnd; ++y)
+    {
+        m_fluidCells += solidsIn(y);
+        std::ranges::copy(flags.subspan(static_cast<size_t>(y) * m_width, m_width),
+                          m_flags.begin() + (static_cast<ptrdiff_t>(y) * m_width));
+        m_fluidCells -= solidsIn(y);
+    }
+
+    const uint32_t plainBegin = rowBegin > 0 ? rowBegin - 1 : 0;
+    const uint32_t plainEnd = std::min(rowEnd + 1, m_height);
+    for (uint32_t y = plainBegin; y < plainEnd; ++y)
+    {
+        const uint32_t nearBegin = y > 0 ? y - 1 : 0;
+        const uint32_t nearEnd = std::min(y + 2, m_height);
+        bool plain = true;
+        for (uint32_t near = nearBegin; near < nearEnd && plain; ++near)
+        {
+            plain = solidsIn(near) == 0;
+        }
+        m_plainRows[y] = plain ? 1 : 0;
+    }
+
+    const uint32_t firstBlock = rowBegin / kBlockRows;
+    const uint32_t lastBlock = (rowEnd - 1) / kBlockRows;
+    for (uint32_t block = firstBlock; block <= lastBlock; ++block)
+    {
+        BuildPreconditioner(block * kBlockRows, std::min((block + 1) * kBlockRows, m_height));
+    }
+}
+
+template <typename Fn>
+ConjugateGradient::BlockSums ConjugateGradient::Reduce(const Fn& function)
+{
+    const auto run = [this, &function](uint32_t begin, uint32_t end) {
+        for (uint32_t block = begin; block < end; ++block)
+        {
+            m_sums[block] = function(block * kBlockRows, std::min((block + 1) * kBlockRows, m_height));
+        }
+    };
+
+    if (m_jobSystem)
+    {
+        m_jobSystem->ParallelFor(m_blockCount, 1, run);
+    }
+    else
+    {
+        run(0, m_blockCount);
+    }
+
+    BlockSums total;
+    for (const BlockSums& sums : m_sums)
+    {
+        total.First += sums.First;
+        total.Second += sums.Second;
+    }
+    return total;
+}
+
+SolveStats ConjugateGradient::Solve(std::span<const float> rhs,
+                                    std::span<float> pressure,
+                                    float tolerance,
+                                    uint32_t maxIterations)
+{
+    const size_t cells = m_precondition.size();
+    if (rhs.size() != cells || pressure.size() != cells)
+    {
+        LOG_ERROR("ConjugateGradient: Fields do not match the {}x{} grid", m_width, m_height);
+        throw std::invalid_argument("ConjugateGradient: Field Size Mismatch");
+    }
+
+    const auto rowsOf = [this](std::span<float> field, uint32_t rowBegin, uint32_t rowEnd) {
+        return field.subspan(static_cast<size_t>(rowBegin) * m_width, static_cast<size_t>(rowEnd - rowBegin) * m_width);
+    };
+
+    // Sum and sum of squares of b over the fluid give its mean and the norm of b without it.
+    const BlockSums moments = Reduce([&](uint32_t rowBegin, uint32_t rowEnd) {
+        BlockSums sums;
+        for (size_t i = static_cast<size_t>(rowBegin) * m_width; i < static_cast<size_t>(rowEnd) * m_width; ++i)
+        {
+            const double value = (m_flags[i] & CellFlags::kSolid) != 0 ? 0.0 : rhs[i];
+            sums.First += value;
+            sums.Second += value * value;
+        }
+        return sums;
+    });
+    const double mean = m_fluidCells > 0 ? moments.First / static_cast<double>(m_fluidCells) : 0.0;
+    const double rhsNorm = std::max(moments.Second - (mean * moments.First), 0.0);
+    const double target = std::max(static_cast<double>(tolerance) * tolerance * rhsNorm, kMinTarget);
+    const auto shift = static_cast<float>(mean);
+
+    // r = b - A p, z = M^-1 r, d = z. Solid rows of A are zero, so their residual stays zero throughout.
+    BlockSums sums = Reduce([&](uint32_t rowBegin, uint32_t rowEnd) {
+        Multiply(pressure, m_product, rowBegin, rowEnd);
+        const size_t end = static_cast<size_t>(rowEnd) * m_width;
+        for (size_t i = static_cast<size_t>(rowBegin) * m_width; i < end; ++i)
+        {
+            m_residual[i] = (m_flags[i] & CellFlags::kSolid) != 0 ? 0.0F : (rhs[i] - shift) - m_product[i];
+        }
+        Precondition(rowBegin, rowEnd);
+        std::ranges::copy(rowsOf(m_conditioned, rowBegin, rowEnd), rowsOf(m_search, rowBegin, rowEnd).begin());
+
+        const std::span<float> residual = rowsOf(m_residual, rowBegin, rowEnd);
+        const std::span<float> conditioned = rowsOf(m_conditioned, rowBegin, rowEnd);
+        return BlockSums{.First = Core::Simd::DotProduct(residual.data(), residual.data(), residual.size()),
+                         .Second = Core::Simd::DotProduct(residual.data(), conditioned.data(), residual.size())};
+    });
+
+    double residualNorm = sums.First;
+    double conditionedDot = sums.Second;
+    uint32_t iterations = 0;
+
+    while (residualNorm > target && iterations < maxIterations)
+    {
+        const BlockSums step = Reduce([&](uint32_t rowBegin, uint32_t rowEnd) {
+            Multiply(m_search, m_product, rowBegin, rowEnd);
+            const std::span<float> search = rowsOf(m_search, rowBegin, rowEnd);
+            const std::span<float> product = rowsOf(m_product, rowBegin, rowEnd);
+            return BlockSums{.First = Core::Simd::DotProduct(search.data(), product.data(), search.size())};
+        });
+        const double curvature = step.First;
+        if (curvature <= 0.0)
+        {
+            break; // Only the constant mode is left, which does not change the velocity.
+        }
+
+        const auto alpha = static_cast<float>(conditionedDot / curvature);
+        sums = Reduce([&](uint32_t rowBegin, uint32_t rowEnd) {
+            const size_t end = static_cast<size_t>(rowEnd) * m_width;
+            for (size_t i = static_cast<size_t>(rowBegin) * m_width; i < end; ++i)
+            {
+                pressure[i] += alpha * m_search[i];
+                m_residual[i] -= alpha * m_product[i];
+            }
+            Precondition(rowBegin, rowEnd);
+
+            const std::span<float> residual = rowsOf(m_residual, rowBegin, rowEnd);
+            const std::span<float> conditioned = rowsOf(m_conditioned, rowBegin, rowEnd);
+            return BlockSums{.First = Core::Simd::DotProduct(residual.data(), residual.data(), residual.size()),
+                             .Second = Core::Simd::DotProduct(residual.data(), conditioned.data(), residual.size())};
+        });
+        ++iterations;
+
+        residualNorm = sums.First;
+        if (residualNorm <= target)
+        {
+            break;
+        }
+
+        const auto beta = static_cast<float>(sums.Second / conditionedDot);
+        conditionedDot = sums.Second;
+        Reduce([&](uint32_t rowBegin, uint32_t rowEnd) {
+            const size_t end = static_cast<size_t>(rowEnd) * m_width;
+            for (size_t i = static_cast<size_t>(rowBegin) * m_width; i < end; ++i)
+            {
+                m_search[i] = m_conditioned[i] + (beta * m_search[i]);
+            }
+            return BlockSums{};
+        });
+    }
+
+    return SolveStats{.Iterations = iterations,
+                      .Residual = rhsNorm > 0.0 ? static_cast<float>(std::sqrt(residualNorm / rhsNorm)) : 0.0F};
+}
+
+void ConjugateGradient::BuildPreconditioner(uint32_t blockBegin, uint32_t blockEnd)
+{
+    for (uint32_t y = blockBegin; y < blockEnd; ++y)
+    {
+        for (uint32_t x = 0; x < m_width; ++x)
+        {
+            const size_t i = (static_cast<size_t>(y) * m_width) + x;
+            const uint8_t flags = m_flags[i];
+            const auto neighbours = static_cast<double>(std::popcount(static_cast<uint32_t>(flags >> 1U)));
+            if (neighbours == 0.0)
+            {
+                m_precondition[i] = 0.0F; // Solid, or fluid sealed in on all sides: not part of the system
+                continue;
+            }
+
+            // Off-diagonals are -1 towards every open neighbour, except across a block edge where the factor
+            // drops them.
+            double e = neighbours;
+            if ((flags & CellFlags::kOpenLeft) != 0)
+            {
+                const double left = static_cast<double>(m_precondition[i - 1]) * m_precondition[i - 1];
+                const bool fill = (m_flags[i - 1] & CellFlags::kOpenAbove) != 0 && y + 1 < blockEnd;
+                e -= left + (fill ? kModification * left : 0.0);
+            }
+            if ((flags & CellFlags::kOpenBelow) != 0 && y > blockBegin)
+            {
+                const double below = static_cast<double>(m_precondition[i - m_width]) * m_precondition[i - m_width];
+                const bool fill = (m_flags[i - m_width] & CellFlags::kOpenRight) != 0;
+                e -= below + (fill ? kModification * below : 0.0);
+            }
+            if (e < kSafety * neighbours)
+            {
+                e = neighbours;
+            }
+
+            m_precondition[i] = static_cast<float>(1.0 / std::sqrt(e));
+        }
+    }
+}
+
+void ConjugateGradient::Multiply(std::span<const float> input,
+                                 std::span<float> output,
+                                 uint32_t rowBegin,
+                                 uint32_t rowEnd) const
+{
+    const uint32_t last = m_width - 1;
+
+    for (uint32_t y = rowBegin; y < rowEnd; ++y)
+    {
+        const size_t rowStart = static_cast<size_t>(y) * m_width;
+        if (m_plainRows[y] == 0)
+        {
+            for (size_t i = rowStart; i < rowStart + m_width; ++i)
+            {
+                const auto& offsets = m_offsets[m_flags[i]];
+                const float* cell = input.data() + i;
+                output[i] = Stencil(cell[0], cell[offsets[0]], cell[offsets[1]], cell[offsets[2]], cell[offsets[3]]);
+            }
+            continue;
+        }
+
+        // A missing neighbour row is the row itself, exactly as the Jacobi solver clamps at walls.
+        const float* row = input.data() + rowStart;
+        const float* below = y > 0 ? row - m_width : row;
+        const float* above = y + 1 < m_height ? row + m_width : row;
+        float* out = output.data() + rowStart;
+
+        out[0] = Stencil(row[0], row[0], row[1], below[0], above[0]);
+        uint32_t x = 1;
+
+#if defined(AF_SIMD_AVX2)
+        const __m256 diagonal = _mm256_set1_ps(kDiagonal);
+        for (; x + Core::Simd::kFloatLanes <= last; x += Core::Simd::kFloatLanes)
+        {
+            const __m256 sides = _mm256_add_ps(_mm256_loadu_ps(row + x - 1), _mm256_loadu_ps(row + x + 1));
+            const __m256 vertical = _mm256_add_ps(_mm256_loadu_ps(below + x), _mm256_loadu_ps(above + x));
+            const __m256 centre = _mm256_mul_ps(diagonal, _mm256_loadu_ps(row + x));
+            _mm256_storeu_ps(out + x, _mm256_sub_ps(_mm256_sub_ps(centre, sides), vertical));
+        }
+#endif
+
+        for (; x < last; ++x)
+        {
+            out[x] = Stencil(row[x], row[x - 1], row[x + 1], below[x], above[x]);
+        }
+        out[last] = Stencil(row[last], row[last - 1], row[last], below[last], above[last]);
+    }
+}
+
+void ConjugateGradient::Precondition(uint32_t rowBegin, uint32_t rowEnd)
+{
+    // Solves L L^T z = r inside the block; the off-diagonals are all -1, so each step adds where it would subtract.
+    const float* factor = m_precondition.data();
+    const float* residual = m_residual.data();
+    const uint8_t* flags = m_flags.data();
+    float* z = m_conditioned.data();
+
+    for (uint32_t y = rowBegin; y < rowEnd; ++y)
+    {
+        const bool inner = y > rowBegin;
+        for (size_t i = static_cast<size_t>(y) * m_width; i < static_cast<size_t>(y + 1) * m_width; ++i)
+        {
+            float t = residual[i];
+            if ((flags[i] & CellFlags::kOpenLeft) != 0)
+            {
+                t += factor[i - 1] * z[i - 1];
+            }
+            if (inner && (flags[i] & CellFlags::kOpenBelow) != 0)
+            {
+                t += factor[i - m_width] * z[i - m_width];
+            }
+            z[i] = t * factor[i];
+        }
+    }
+
+    for (uint32_t y = rowEnd; y-- > rowBegin;)
+    {
+        const bool inner = y + 1 < rowEnd;
+        for (size_t i = static_cast<size_t>(y + 1) * m_width; i-- > static_cast<size_t>(y) * m_width;)
+        {
+            float t = z[i];
+            if ((flags[i] & CellFlags::kOpenRight) != 0)
+            {
+                t += factor[i] * z[i + 1];
+            }
+            if (inner && (flags[i] & CellFlags::kOpenAbove) != 0)
+            {
+                t += factor[i] * z[i + m_width];
+            }
+            z[i] = t * factor[i];
+        }
+    }
+}
+} // namespace Simulation
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ObstacleMask.hpp"
+
+namespace Core
+{
+class JobSystem;
+} // namespace Core
+
+namespace Simulation
+{
+struct SolveStats
+{
+    uint32_t Iterations = 0;
+    float Residual = 0.0F; // ||r|| / ||b|| when the solve stopped
+};
+
+// Preconditioned conjugate gradient for the pressure Poisson equation of a closed grid: the 5-point Laplacian
+// with Neumann walls, in the same clamped-neighbour form the Jacobi solver relaxes, so the two converge to the
+// same pressure. Walls and obstacles both come from the cell flags; solid cells are left out of the system.
+// Rows away from any obstacle take a branch-free SIMD stencil, the others look their neighbours up per cell.
+//
+// The preconditioner is MIC(0) (modified incomplete Cholesky) restricted to fixed blocks of rows: couplings
+// between blocks are dropped from the factor, which keeps it symmetric positive definite and lets each block
+// run its triangular solves on its own thread. Dot products are reduced per block in double and summed in
+// block order. Block boundaries depend only on the grid, so results match the serial path bit for bit at any
+// thread count.
+class ConjugateGradient
+{
+public:
+    ConjugateGradient(uint32_t width,
+                      uint32_t height,
+                      std::span<const uint8_t> flags,
+                      Core::JobSystem* jobSystem = nullptr);
+
+    // Takes new flags for rows [rowBegin, rowEnd) and refactors the preconditioner blocks they fall in.
+    void UpdateFlags(std::span<const uint8_t> flags, uint32_t rowBegin, uint32_t rowEnd);
+
+    // Solves A p = b in place, warm-starting from the pressure passed in. The constant mode of b over the fluid
+    // cells, which no pressure can produce with closed walls, is removed first; solid cells keep their pressure.
+    // Stops once ||r|| <= tolerance * ||b|| or after maxIterations.
+    SolveStats Solve(std::span<const float> rhs, std::span<float> pressure, float tolerance, uint32_t maxIterations);
+
+private:
+    struct BlockSums
+    {
+        double First = 0.0;
+        double Second = 0.0;
+    };
+
+    void BuildPreconditioner(uint32_t blockBegin, uint32_t blockEnd);
+    void Multiply(std::span<const float> input, std::span<float> output, uint32_t rowBegin, uint32_t rowEnd) const;
+    void Precondition(uint32_t rowBegin, uint32_t rowEnd);
+
+    // Runs function(rowBegin, rowEnd) for every block of rows, in parallel when a job system is attached, and
+    // returns the BlockSums they produced added in block order.
+    template <typename Fn>
+    BlockSums Reduce(const Fn& function);
+
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_blockCount;
+    Core::JobSystem* m_jobSystem;
+
+    std::vector<uint8_t> m_flags;
+    std::vector<uint8_t> m_plainRows;  // No solid cell in the row or next to it: the uniform stencil applies
+    NeighbourOffsets m_offsets;        // For the flagged rows
+    uint32_t m_fluidCells;
+    std::vector<float> m_precondition; // MIC(0) factor diagonal, 1 / sqrt(e) per fluid cell, 0 for solids
+    std::vector<float> m_residual;
+    std::vector<float> m_search;
+    std::vector<float> m_product;     // A times the search direction
+    std::vector<float> m_conditioned; // M^-1 times the residual
+    std::vector<BlockSums> m_sums;
+};
+} // namespace Simulation
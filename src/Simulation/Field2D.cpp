@@ -0,0 +1,252 @@
+#include "Field2D.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+#include "../Core/Simd.hpp"
+
+namespace Simulation
+{
+namespace
+{
+// Maps x into [0, size). The second test catches values a hair below zero that round up to size. NaN, and the NaN
+// an infinity wraps to, maps to 0: casting it to an index is undefined and lands far outside the grid.
+float WrapCoordinate(float x, float size)
+{
+    x -= size * std::floor(x / size);
+    if (std::isnan(x))
+    {
+        return 0.0F;
+    }
+    return x >= size ? x - size : x;
+}
+
+// Clamps x to [0, max], with NaN mapped to 0 as the AVX2 path's max does.
+float ClampCoordinate(float x, float max)
+{
+    return std::isnan(x) ? 0.0F : std::clamp(x, 0.0F, max);
+}
+} // namespace
+
+Field2D::Field2D(uint32_t width, uint32_t height, float value)
+    : m_width(width), m_height(height), m_data(static_cast<size_t>(width) * height, value)
+{
+}
+
+float Field2D::Sample(float x, float y) const
+{
+    uint32_t x0 = 0;
+    uint32_t y0 = 0;
+    uint32_t x1 = 0;
+    uint32_t y1 = 0;
+    float tx = 0.0F;
+    float ty = 0.0F;
+
+    if (m_edgeMode == EdgeMode::Wrap)
+    {
+        x = WrapCoordinate(x, static_cast<float>(m_width));
+        y = WrapCoordinate(y, static_cast<float>(m_height));
+        const float floorX = std::floor(x);
+        const float floorY = std::floor(y);
+        x0 = static_cast<uint32_t>(floorX);
+        y0 = static_cast<uint32_t>(floorY);
+        x1 = x0 + 1 == m_width ? 0 : x0 + 1;
+        y1 = y0 + 1 == m_height ? 0 : y0 + 1;
+        tx = x - floorX;
+        ty = y - floorY;
+    }
+    else
+    {
+        x = ClampCoordinate(x, static_cast<float>(m_width - 1));
+        y = ClampCoordinate(y, static_cast<float>(m_height - 1));
+        const float floorX = std::floor(x);
+        const float floorY = std::floor(y);
+        x0 = static_cast<uint32_t>(floorX);
+        y0 = static_cast<uint32_t>(floorY);
+        x1 = std::min(x0 + 1, m_width - 1);
+        y1 = std::min(y0 + 1, m_height - 1);
+        tx = x - floorX;
+        ty = y - floorY;
+    }
+
+    const float bottom = At(x0, y0) + (tx * (At(x1, y0) - At(x0, y0)));
+    const float top = At(x0, y1) + (tx * (At(x1, y1) - At(x0, y1)));
+    return bottom + (ty * (top - bottom));
+}
+
+void Field2D::SampleBatch(std::span<const float> xs, std::span<const float> ys, std::span<float> out) const
+{
+    if (m_edgeMode == EdgeMode::Wrap)
+    {
+        SampleBatchImpl<false, true>(xs.data(), ys.data(), out.data(), nullptr, nullptr, out.size());
+    }
+    else
+    {
+        SampleBatchImpl<false, false>(xs.data(), ys.data(), out.data(), nullptr, nullptr, out.size());
+    }
+}
+
+void Field2D::SampleBatch(std::span<const float> xs,
+                          std::span<const float> ys,
+                          std::span<float> out,
+                          std::span<float> lower,
+                          std::span<float> upper) const
+{
+    if (m_edgeMode == EdgeMode::Wrap)
+    {
+        SampleBatchImpl<true, true>(xs.data(), ys.data(), out.data(), lower.data(), upper.data(), out.size());
+    }
+    else
+    {
+        SampleBatchImpl<true, false>(xs.data(), ys.data(), out.data(), lower.data(), upper.data(), out.size());
+    }
+}
+
+template <bool WithBounds, bool Wrap>
+void Field2D::SampleBatchImpl(
+    const float* xs, const float* ys, float* out, float* lower, float* upper, size_t count) const
+{
+    size_t i = 0;
+
+#if defined(AF_SIMD_AVX2)
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 limitX = _mm256_set1_ps(static_cast<float>(m_width - 1));
+    const __m256 limitY = _mm256_set1_ps(static_cast<float>(m_height - 1));
+    const __m256i lastColumn = _mm256_set1_epi32(static_cast<int>(m_width - 1));
+    const __m256i lastRow = _mm256_set1_epi32(static_cast<int>(m_height - 1));
+    const __m256i stride = _mm256_set1_epi32(static_cast<int>(m_width));
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256 sizeX = _mm256_set1_ps(static_cast<float>(m_width));
+    const __m256 sizeY = _mm256_set1_ps(static_cast<float>(m_height));
+    const __m256i rows = _mm256_set1_epi32(static_cast<int>(m_height));
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(xs + i);
+        __m256 y = _mm256_loadu_ps(ys + i);
+        if constexpr (Wrap)
+        {
+            x = _mm256_sub_ps(x, _mm256_mul_ps(sizeX, _mm256_floor_ps(_mm256_div_ps(x, sizeX))));
+            y = _mm256_sub_ps(y, _mm256_mul_ps(sizeY, _mm256_floor_ps(_mm256_div_ps(y, sizeY))));
+            x = _mm256_sub_ps(x, _mm256_and_ps(_mm256_cmp_ps(x, sizeX, _CMP_GE_OQ), sizeX));
+            y = _mm256_sub_ps(y, _mm256_and_ps(_mm256_cmp_ps(y, sizeY, _CMP_GE_OQ), sizeY));
+            // NaN lanes (including wrapped infinities) would convert to INT_MIN and gather far out of bounds.
+            x = _mm256_and_ps(x, _mm256_cmp_ps(x, x, _CMP_ORD_Q));
+            y = _mm256_and_ps(y, _mm256_cmp_ps(y, y, _CMP_ORD_Q));
+        }
+        else
+        {
+            // max returns its second operand for NaN, so NaN lanes clamp to 0.
+            x = _mm256_min_ps(_mm256_max_ps(x, zero), limitX);
+            y = _mm256_min_ps(_mm256_max_ps(y, zero), limitY);
+        }
+        const __m256 floorX = _mm256_floor_ps(x);
+        const __m256 floorY = _mm256_floor_ps(y);
+
+        const __m256i x0 = _mm256_cvttps_epi32(floorX);
+        const __m256i y0 = _mm256_cvttps_epi32(floorY);
+        __m256i x1 = _mm256_add_epi32(x0, one);
+        __m256i y1 = _mm256_add_epi32(y0, one);
+        if constexpr (Wrap)
+        {
+            x1 = _mm256_andnot_si256(_mm256_cmpeq_epi32(x1, stride), x1);
+            y1 = _mm256_andnot_si256(_mm256_cmpeq_epi32(y1, rows), y1);
+        }
+        else
+        {
+            x1 = _mm256_min_epi32(x1, lastColumn);
+            y1 = _mm256_min_epi32(y1, lastRow);
+        }
+        const __m256i row0 = _mm256_mullo_epi32(y0, stride);
+        const __m256i row1 = _mm256_mullo_epi32(y1, stride);
+
+        const float* data = m_data.data();
+        const __m256 v00 = _mm256_i32gather_ps(data, _mm256_add_epi32(row0, x0), 4);
+        const __m256 v10 = _mm256_i32gather_ps(data, _mm256_add_epi32(row0, x1), 4);
+        const __m256 v01 = _mm256_i32gather_ps(data, _mm256_add_epi32(row1, x0), 4);
+        const __m256 v11 = _mm256_i32gather_ps(data, _mm256_add_epi32(row1, x1), 4);
+
+        const __m256 tx = _mm256_sub_ps(x, floorX);
+        const __m256 ty = _mm256_sub_ps(y, floorY);
+        const __m256 bottom = _mm256_add_ps(v00, _mm256_mul_ps(tx, _mm256_sub_ps(v10, v00)));
+        const __m256 top = _mm256_add_ps(v01, _mm256_mul_ps(tx, _mm256_sub_ps(v11, v01)));
+        _mm256_storeu_ps(out + i, _mm256_add_ps(bottom, _mm256_mul_ps(ty, _mm256_sub_ps(top, bottom))));
+
+        if constexpr (WithBounds)
+        {
+            _mm256_storeu_ps(lower + i, _mm256_min_ps(_mm256_min_ps(v00, v10), _mm256_min_ps(v01, v11)));
+            _mm256_storeu_ps(upper + i, _mm256_max_ps(_mm256_max_ps(v00, v10), _mm256_max_ps(v01, v11)));
+        }
+    }
+#endif
+
+    const float maxX = static_cast<float>(m_width - 1);
+    const float maxY = static_cast<float>(m_height - 1);
+
+    for (; i < count; ++i)
+    {
+        const float x = Wrap ? WrapCoordinate(xs[i], static_cast<float>(m_width)) : ClampCoordinate(xs[i], maxX);
+        const float y = Wrap ? WrapCoordinate(ys[i], static_cast<float>(m_height)) : ClampCoordinate(ys[i], maxY);
+        const float floorX = std::floor(x);
+        const float floorY = std::floor(y);
+        const auto x0 = static_cast<uint32_t>(floorX);
+        const auto y0 = static_cast<uint32_t>(floorY);
+        const uint32_t x1 = Wrap ? (x0 + 1 == m_width ? 0 : x0 + 1) : std::min(x0 + 1, m_width - 1);
+        const uint32_t y1 = Wrap ? (y0 + 1 == m_height ? 0 : y0 + 1) : std::min(y0 + 1, m_height - 1);
+
+        const float v00 = At(x0, y0);
+        const float v10 = At(x1, y0);
+        const float v01 = At(x0, y1);
+        const float v11 = At(x1, y1);
+
+        const float tx = x - floorX;
+        const float ty = y - floorY;
+        const float bottom = v00 + (tx * (v10 - v00));
+        const float top = v01 + (tx * (v11 - v01));
+        out[i] = bottom + (ty * (top - bottom));
+
+        if constexpr (WithBounds)
+        {
+            lower[i] = std::min({v00, v10, v01, v11});
+            upper[i] = std::max({v00, v10, v01, v11});
+        }
+    }
+}
+
+void Field2D::Fill(float value)
+{
+    std::ranges::fill(m_data, value);
+}
+
+void Field2D::SetEdgeMode(EdgeMode mode)
+{
+    m_edgeMode = mode;
+}
+
+EdgeMode Field2D::GetEdgeMode() const
+{
+    return m_edgeMode;
+}
+
+std::span<float> Field2D::GetData()
+{
+    return m_data;
+}
+
+std::span<const float> Field2D::GetData() const
+{
+    return m_data;
+}
+
+uint32_t Field2D::GetWidth() const
+{
+    return m_width;
+}
+
+uint32_t Field2D::GetHeight() const
+{
+    return m_height;
+}
+} // namespace Simulation
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Simulation
+{
+// How samples outside the grid resolve: held at the edge cells, or wrapped around for periodic domains.
+enum class EdgeMode : uint8_t
+{
+    Clamp,
+    Wrap
+};
+
+class Field2D
+{
+public:
+    Field2D() = default;
+    Field2D(uint32_t width, uint32_t height, float value = 0.0F);
+
+    [[nodiscard]] float& At(uint32_t x, uint32_t y) { return m_data[Index(x, y)]; }
+
+    [[nodiscard]] float At(uint32_t x, uint32_t y) const { return m_data[Index(x, y)]; }
+
+    [[nodiscard]] size_t Index(uint32_t x, uint32_t y) const
+    {
+        return (static_cast<size_t>(y) * m_width) + x;
+    }
+
+    // Bilinear sample at cell-centre coordinates, clamped to or wrapped around the grid per the edge mode.
+    [[nodiscard]] float Sample(float x, float y) const;
+
+    // Sample() for every (xs[i], ys[i]), eight at a time with AVX2 gathers. The bounds overload also returns
+    // the smallest and largest of the four cells each sample blended, for advection limiters.
+    void SampleBatch(std::span<const float> xs, std::span<const float> ys, std::span<float> out) const;
+    void SampleBatch(std::span<const float> xs,
+                     std::span<const float> ys,
+                     std::span<float> out,
+                     std::span<float> lower,
+                     std::span<float> upper) const;
+
+    void Fill(float value);
+
+    void SetEdgeMode(EdgeMode mode);
+    [[nodiscard]] EdgeMode GetEdgeMode() const;
+
+    [[nodiscard]] std::span<float> GetData();
+    [[nodiscard]] std::span<const float> GetData() const;
+
+    [[nodiscard]] uint32_t GetWidth() const;
+    [[nodiscard]] uint32_t GetHeight() const;
+
+private:
+    template <bool WithBounds, bool Wrap>
+    void SampleBatchImpl(const float* xs, const float* ys, float* out, float* lower, float* upper, size_t count) const;
+
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    EdgeMode m_edgeMode = EdgeMode::Clamp;
+    std::vector<float> m_data;
+};
+} // namespace Simulation
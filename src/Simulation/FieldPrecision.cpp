@@ -0,0 +1,108 @@
+#include "FieldPrecision.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "../Core/Simd.hpp"
+
+namespace Simulation
+{
+namespace
+{
+constexpr size_t kMeasureChunk = 256;
+constexpr float kRelativeFloor = 1.0F / 1024.0F;
+} // namespace
+
+void PackedField2D::Assign(const Field2D& source, FieldPrecision precision)
+{
+    const std::span<const float> data = source.GetData();
+    m_width = source.GetWidth();
+    m_height = source.GetHeight();
+    m_precision = precision;
+
+    if (precision == FieldPrecision::Half)
+    {
+        m_half.resize(data.size());
+        Core::Simd::ConvertToHalf(data.data(), m_half.data(), data.size());
+    }
+    else
+    {
+        m_full.assign(data.begin(), data.end());
+    }
+}
+
+void PackedField2D::Read(size_t begin, std::span<float> out) const
+{
+    if (m_precision == FieldPrecision::Half)
+    {
+        Core::Simd::ConvertFromHalf(m_half.data() + begin, out.data(), out.size());
+    }
+    else
+    {
+        std::copy_n(m_full.begin() + static_cast<ptrdiff_t>(begin), out.size(), out.begin());
+    }
+}
+
+FieldPrecision PackedField2D::GetPrecision() const
+{
+    return m_precision;
+}
+
+size_t PackedField2D::GetCellCount() const
+{
+    return static_cast<size_t>(m_width) * m_height;
+}
+
+uint32_t PackedField2D::GetWidth() const
+{
+    return m_width;
+}
+
+uint32_t PackedField2D::GetHeight() const
+{
+    return m_height;
+}
+
+PrecisionReport MeasurePrecision(const Field2D& source, const PackedField2D& packed)
+{
+    const std::span<const float> data = source.GetData();
+    PrecisionReport report{};
+    if (data.empty() || packed.GetCellCount() != data.size())
+    {
+        return report;
+    }
+
+    for (const float value : data)
+    {
+        report.Peak = std::max(report.Peak, std::fabs(value));
+    }
+    const float floor = report.Peak * kRelativeFloor;
+
+    double squares = 0.0;
+    std::array<float, kMeasureChunk> unpacked{};
+    for (size_t begin = 0; begin < data.size(); begin += kMeasureChunk)
+    {
+        const size_t count = std::min(kMeasureChunk, data.size() - begin);
+        packed.Read(begin, std::span(unpacked).first(count));
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float expected = data[begin + i];
+            const float error = std::fabs(unpacked[i] - expected);
+            report.MaxAbsoluteError = std::max(report.MaxAbsoluteError, error);
+            if (std::fabs(expected) >= floor && expected != 0.0F)
+            {
+                report.MaxRelativeError = std::max(report.MaxRelativeError, error / std::fabs(expected));
+            }
+            squares += static_cast<double>(error) * error;
+        }
+    }
+
+    report.RmsError = static_cast<float>(std::sqrt(squares / static_cast<double>(data.size())));
+    return report;
+}
+} // namespace Simulation
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Field2D.hpp"
+
+namespace Simulation
+{
+enum class FieldPrecision : uint8_t
+{
+    Full, // fp32
+    Half  // IEEE fp16: 11 significant bits, about 3 decimal digits
+};
+
+// Storage precision for the copies of each field that leave the solver. The solver's own state stays fp32:
+// velocity and pressure feed back into every step, where fp16 rounding would compound, and the Jacobi and PCG
+// convergence tests sit below fp16 resolution. The solver's dye stays fp32 too. Its advection is under a tenth of
+// a step, most of that traffic is the fp32 scratch fields the error-corrected schemes need anyway, and a step's
+// dissipation (about 0.6%) is only a few fp16 rounding steps. Dye that has left the solver is only ever looked at,
+// so its snapshots, the render-side blend and the display texture drop to fp16 and move half the bytes.
+struct FieldPrecisionPolicy
+{
+    FieldPrecision Dye = FieldPrecision::Half;
+};
+
+// A copy of a Field2D at a chosen precision. Reassigning reuses the storage once it has grown to the grid.
+class PackedField2D
+{
+public:
+    void Assign(const Field2D& source, FieldPrecision precision);
+
+    // Unpacks cells [begin, begin + out.size()) to fp32.
+    void Read(size_t begin, std::span<float> out) const;
+
+    [[nodiscard]] FieldPrecision GetPrecision() const;
+    [[nodiscard]] size_t GetCellCount() const;
+    [[nodiscard]] uint32_t GetWidth() const;
+    [[nodiscard]] uint32_t GetHeight() const;
+
+private:
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    FieldPrecision m_precision = FieldPrecision::Full;
+    std::vector<float> m_full;
+    std::vector<uint16_t> m_half;
+};
+
+// How far a packed copy strays from its source, for choosing a policy.
+struct PrecisionReport
+{
+    float MaxAbsoluteError = 0.0F;
+    float MaxRelativeError = 0.0F; // Over cells at least 1/1024 of the field's peak; smaller ones are noise
+    float RmsError = 0.0F;
+    float Peak = 0.0F; // Largest magnitude in the source
+};
+
+[[nodiscard]] PrecisionReport MeasurePrecision(const Field2D& source, const PackedField2D& packed);
+} // namespace Simulation
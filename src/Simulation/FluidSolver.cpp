@@ -0,0 +1,1081 @@
+#include "FluidSolver.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "../Core/JobSystem.hpp"
+#include "../Core/Logger.hpp"
+#include "../Core/Simd.hpp"
+#include "ActivityMask.hpp"
+#include "Field2D.hpp"
+#include "ObstacleMask.hpp"
+
+namespace Simulation
+{
+namespace
+{
+constexpr float kSplatExtent = 3.0F; // Gaussian support in radii
+constexpr uint32_t kMinGridSize = 8;
+constexpr uint32_t kRowsPerJob = 8;
+constexpr uint32_t kSampleBlock = 64; // Backtrace positions computed per SampleBatch call
+constexpr uint32_t kTileSize = 64;
+constexpr uint32_t kTileHalo = 4;
+constexpr uint32_t kIterationsPerRound = kTileHalo - 1; // Leaves a one-cell valid ring for the gradient
+constexpr uint32_t kTileWindow = kTileSize + (2 * kTileHalo);
+constexpr uint32_t kActivityTile = 32;
+constexpr uint32_t kConfinementRows = kActivityTile; // Row band per rolling curl buffer, aligned with the mask
+constexpr uint32_t kCurlRowSlots = 3;
+constexpr uint32_t kObstacleTile = 32;
+constexpr uint32_t kObstacleReach = kTileHalo + 1; // Solids this far outside a tile change flags in its window
+constexpr float kGradientEpsilon = 1.0e-5F; // Keeps the normalized curl gradient finite in flat regions
+
+// Inclusive cell range a splat touches along one axis. Periodic windows may run past either edge and are
+// wrapped per cell, but never span more than the domain so that no cell is hit twice.
+struct SplatWindow
+{
+    int64_t Begin;
+    int64_t End;
+};
+
+SplatWindow GetSplatWindow(float centre, float extent, uint32_t size, bool wrap)
+{
+    if (!wrap)
+    {
+        const auto limit = static_cast<float>(size - 1);
+        return {.Begin = static_cast<int64_t>(std::clamp(centre - extent, 0.0F, limit)),
+                .End = static_cast<int64_t>(std::clamp(centre + extent, 0.0F, limit))};
+    }
+
+    const auto begin = static_cast<int64_t>(std::floor(centre - extent));
+    return {.Begin = begin, .End = std::min(static_cast<int64_t>(std::floor(centre + extent)), begin + size - 1)};
+}
+
+uint32_t WrapIndex(int64_t index, uint32_t size)
+{
+    const int64_t remainder = index % size;
+    return static_cast<uint32_t>(remainder < 0 ? remainder + size : remainder);
+}
+
+// Row-major index, in a domain of the given width, of window cell (x, y) of a projection tile.
+size_t GlobalIndex(const TileView& tile, uint32_t width, int32_t x, int32_t y)
+{
+    const auto gx = static_cast<size_t>(static_cast<int32_t>(tile.X0) + x);
+    const auto gy = static_cast<size_t>(static_cast<int32_t>(tile.Y0) + y);
+    return (gy * width) + gx;
+}
+
+struct ConfinementRow
+{
+    const float* CurlBelow;
+    const float* Curl;
+    const float* CurlAbove;
+    const float* VelocityX;
+    const float* VelocityY;
+    const float* Strength;
+    float* OutX;
+    float* OutY;
+};
+
+// Confinement force f = strength * (N x w) with N the normalized gradient of |curl|, added over dt to columns
+// [begin, end); Curl[begin - 1] and Curl[end] must be readable. Both paths use the same operation order, so
+// results do not depend on where a run boundary falls.
+void ConfineSpan(const ConfinementRow& row, uint32_t begin, uint32_t end, float dt)
+{
+    uint32_t x = begin;
+
+#if defined(AF_SIMD_AVX2)
+    const __m256 half = _mm256_set1_ps(0.5F);
+    const __m256 epsilon = _mm256_set1_ps(kGradientEpsilon);
+    const __m256 step = _mm256_set1_ps(dt);
+    const __m256 signMask = _mm256_set1_ps(-0.0F);
+
+    for (; x + Core::Simd::kFloatLanes <= end; x += Core::Simd::kFloatLanes)
+    {
+        const __m256 left = _mm256_andnot_ps(signMask, _mm256_loadu_ps(row.Curl + x - 1));
+        const __m256 right = _mm256_andnot_ps(signMask, _mm256_loadu_ps(row.Curl + x + 1));
+        const __m256 below = _mm256_andnot_ps(signMask, _mm256_loadu_ps(row.CurlBelow + x));
+        const __m256 above = _mm256_andnot_ps(signMask, _mm256_loadu_ps(row.CurlAbove + x));
+        const __m256 curl = _mm256_loadu_ps(row.Curl + x);
+
+        const __m256 gx = _mm256_mul_ps(half, _mm256_sub_ps(right, left));
+        const __m256 gy = _mm256_mul_ps(half, _mm256_sub_ps(above, below));
+        const __m256 length =
+            _mm256_add_ps(_mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(gx, gx), _mm256_mul_ps(gy, gy))), epsilon);
+        const __m256 scale =
+            _mm256_div_ps(_mm256_mul_ps(_mm256_mul_ps(step, _mm256_loadu_ps(row.Strength + x)), curl), length);
+
+        _mm256_storeu_ps(row.OutX + x, _mm256_add_ps(_mm256_loadu_ps(row.VelocityX + x), _mm256_mul_ps(scale, gy)));
+        _mm256_storeu_ps(row.OutY + x, _mm256_sub_ps(_mm256_loadu_ps(row.VelocityY + x), _mm256_mul_ps(scale, gx)));
+    }
+#endif
+
+    for (; x < end; ++x)
+    {
+        const float gx = 0.5F * (std::fabs(row.Curl[x + 1]) - std::fabs(row.Curl[x - 1]));
+        const float gy = 0.5F * (std::fabs(row.CurlAbove[x]) - std::fabs(row.CurlBelow[x]));
+        const float length = std::sqrt((gx * gx) + (gy * gy)) + kGradientEpsilon;
+        const float scale = ((dt * row.Strength[x]) * row.Curl[x]) / length;
+
+        row.OutX[x] = row.VelocityX[x] + (scale * gy);
+        row.OutY[x] = row.VelocityY[x] - (scale * gx);
+    }
+}
+} // namespace
+
+FluidSolver::FluidSolver(const FluidSettings& settings, Core::JobSystem* jobSystem)
+    : m_settings(settings),
+      m_jobSystem(jobSystem),
+      m_velocityX(settings.Width, settings.Height),
+      m_velocityY(settings.Width, settings.Height),
+      m_pressure(settings.Width, settings.Height),
+      m_dye(settings.Width, settings.Height),
+      m_scratchA(settings.Width, settings.Height),
+      m_scratchB(settings.Width, settings.Height),
+      m_advectForward(settings.Width, settings.Height),
+      m_advectReverse(settings.Width, settings.Height),
+      m_advectLower(settings.Width, settings.Height),
+      m_advectUpper(settings.Width, settings.Height),
+      m_tiledPressure(settings.Width, settings.Height, kTileSize, kTileHalo),
+      m_tiledDivergence(settings.Width, settings.Height, kTileSize, kTileHalo),
+      m_activity(settings.Width, settings.Height, kActivityTile, settings.Activity),
+      m_obstacles(settings.Width, settings.Height, kObstacleTile),
+      m_obstacleTiles(m_tiledPressure.GetTileCount(), 0),
+      m_tileOffsets(BuildNeighbourOffsets(kTileWindow)),
+      m_gridOffsets(BuildNeighbourOffsets(settings.Width)),
+      m_confinementColumns(settings.Width, 0.0F),
+      m_curlRows(static_cast<size_t>((settings.Height + kConfinementRows - 1) / kConfinementRows) * kCurlRowSlots *
+                 (settings.Width + 2))
+{
+    if (settings.Width < kMinGridSize || settings.Height < kMinGridSize)
+    {
+        throw std::invalid_argument("FluidSolver: Grid too small");
+    }
+
+    if (settings.Boundary == DomainBoundary::Periodic)
+    {
+        m_spectral.emplace(settings.Width, settings.Height, jobSystem);
+        for (Field2D* field : {&m_velocityX,
+                               &m_velocityY,
+                               &m_pressure,
+                               &m_dye,
+                               &m_scratchA,
+                               &m_scratchB,
+                               &m_advectForward,
+                               &m_advectReverse,
+                               &m_advectLower,
+                               &m_advectUpper})
+        {
+            field->SetEdgeMode(EdgeMode::Wrap);
+        }
+    }
+    else if (settings.Pressure == PressureSolver::ConjugateGradient)
+    {
+        m_conjugateGradient.emplace(settings.Width, settings.Height, m_obstacles.GetFlags(), jobSystem);
+    }
+
+    LOG_INFO("FluidSolver: Initialized {}x{} grid ({} pressure iterations, {} threads)",
+             settings.Width,
+             settings.Height,
+             settings.PressureIterations,
+             jobSystem ? jobSystem->GetThreadCount() : 1);
+}
+
+template <typename Fn>
+void FluidSolver::ForEachRowBand(const Fn& function) const
+{
+    if (m_jobSystem)
+    {
+        m_jobSystem->ParallelFor(m_settings.Height, kRowsPerJob, function);
+    }
+    else
+    {
+        function(0U, m_settings.Height);
+    }
+}
+
+template <typename Fn>
+void FluidSolver::ForEachTile(const Fn& function) const
+{
+    const uint32_t tileCount = m_tiledPressure.GetTileCount();
+
+    if (m_jobSystem)
+    {
+        m_jobSystem->ParallelFor(tileCount, 1, [&function](uint32_t begin, uint32_t end) {
+            for (uint32_t tile = begin; tile < end; ++tile)
+            {
+                function(tile);
+            }
+        });
+    }
+    else
+    {
+        for (uint32_t tile = 0; tile < tileCount; ++tile)
+        {
+            function(tile);
+        }
+    }
+}
+
+template <typename Fn>
+void FluidSolver::ForEachRun(CellActivity activity, const Fn& function) const
+{
+    ForEachRowBand([&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y)
+        {
+            for (const CellRun& run : m_activity.GetRuns(y, activity))
+            {
+                function(y, run.Begin, run.End);
+            }
+        }
+    });
+}
+
+void FluidSolver::Step(float dt, std::span<const Splat> splats, float quality, std::span<const float> confinement)
+{
+    ApplySplats(splats);
+
+    // Measured after the splats so that an impulse into a sleeping region is advected in the same step.
+    if (m_settings.TrackActivity)
+    {
+        m_activity.Update(m_velocityX, m_velocityY, m_dye, m_jobSystem);
+    }
+
+    if (!confinement.empty())
+    {
+        ConfineVorticity(dt, confinement);
+    }
+
+    Advect(m_velocityX, m_scratchA, dt, m_settings.VelocityDissipation);
+    Advect(m_velocityY, m_scratchB, dt, m_settings.VelocityDissipation);
+    std::swap(m_velocityX, m_scratchA);
+    std::swap(m_velocityY, m_scratchB);
+    EnforceWalls();
+
+    const auto scaled = static_cast<uint32_t>(std::lround(static_cast<float>(m_settings.PressureIterations) *
+                                                          std::clamp(quality, 0.0F, 1.0F)));
+    if (m_activity.GetActiveFraction() > 0.0F && m_spectral)
+    {
+        m_spectral->Project(m_velocityX, m_velocityY, m_pressure);
+        m_lastPressureIterations = 0;
+    }
+    else if (m_activity.GetActiveFraction() > 0.0F && m_conjugateGradient)
+    {
+        ProjectConjugateGradient(std::max(scaled, m_settings.MinPressureIterations));
+    }
+    else if (m_activity.GetActiveFraction() > 0.0F)
+    {
+        Project(std::max(scaled, m_settings.MinPressureIterations));
+    }
+    else
+    {
+        // Nothing anywhere moves fast enough to wake a tile, so there is no divergence worth removing.
+        m_lastPressureIterations = 0;
+        m_lastPressureResidual = 0.0F;
+    }
+
+    Advect(m_dye, m_scratchA, dt, m_settings.DyeDissipation);
+    std::swap(m_dye, m_scratchA);
+    ClearSolids(m_dye);
+}
+
+void FluidSolver::PaintObstacles(const std::function<float(float, float)>& distance, bool solid)
+{
+    if (m_spectral)
+    {
+        LOG_WARN("FluidSolver: Obstacles need a closed domain; ignoring them");
+        return;
+    }
+
+    m_obstacles.Paint(distance, solid);
+    ApplyObstacleChanges();
+}
+
+void FluidSolver::PaintObstacleImage(const std::string& path, bool solid)
+{
+    if (m_spectral)
+    {
+        LOG_WARN("FluidSolver: Obstacles need a closed domain; ignoring '{}'", path);
+        return;
+    }
+
+    m_obstacles.PaintImage(path, solid);
+    ApplyObstacleChanges();
+}
+
+void FluidSolver::Restore(const FluidState& state)
+{
+    const size_t cells = static_cast<size_t>(m_settings.Width) * m_settings.Height;
+    if (state.VelocityX.size() != cells || state.VelocityY.size() != cells || state.Pressure.size() != cells ||
+        state.Dye.size() != cells)
+    {
+        LOG_ERROR("FluidSolver: Restored state does not match the {}x{} grid", m_settings.Width, m_settings.Height);
+        throw std::invalid_argument("FluidSolver: State Size Mismatch");
+    }
+
+    std::ranges::copy(state.VelocityX, m_velocityX.GetData().begin());
+    std::ranges::copy(state.VelocityY, m_velocityY.GetData().begin());
+    std::ranges::copy(state.Pressure, m_pressure.GetData().begin());
+    std::ranges::copy(state.Dye, m_dye.GetData().begin());
+    m_tiledPressure.CopyFrom(m_pressure);
+    m_activity = ActivityMask(m_settings.Width, m_settings.Height, kActivityTile, m_settings.Activity);
+}
+
+void FluidSolver::ApplySplats(std::span<const Splat> splats)
+{
+    const auto width = static_cast<float>(m_settings.Width);
+    const auto height = static_cast<float>(m_settings.Height);
+    const bool wrap = m_spectral.has_value();
+
+    for (const Splat& splat : splats)
+    {
+        const float cx = splat.X * width;
+        const float cy = splat.Y * height;
+        const float radius = std::max(splat.Radius * width, 1.0F);
+        const float invRadiusSq = 1.0F / (radius * radius);
+        const float extent = radius * kSplatExtent;
+
+        const SplatWindow columns = GetSplatWindow(cx, extent, m_settings.Width, wrap);
+        const SplatWindow rows = GetSplatWindow(cy, extent, m_settings.Height, wrap);
+
+        for (int64_t y = rows.Begin; y <= rows.End; ++y)
+        {
+            const uint32_t cellY = WrapIndex(y, m_settings.Height);
+            for (int64_t x = columns.Begin; x <= columns.End; ++x)
+            {
+                const uint32_t cellX = WrapIndex(x, m_settings.Width);
+                const float dx = static_cast<float>(x) - cx;
+                const float dy = static_cast<float>(y) - cy;
+                const float falloff = std::exp(-((dx * dx) + (dy * dy)) * invRadiusSq);
+
+                m_velocityX.At(cellX, cellY) += splat.ForceX * falloff;
+                m_velocityY.At(cellX, cellY) += splat.ForceY * falloff;
+                m_dye.At(cellX, cellY) += splat.Dye * falloff;
+            }
+        }
+    }
+}
+
+void FluidSolver::ConfineVorticity(float dt, std::span<const float> bandStrengths)
+{
+    const uint32_t width = m_settings.Width;
+    const auto bandCount = static_cast<uint32_t>(bandStrengths.size());
+    for (uint32_t x = 0; x < width; ++x)
+    {
+        m_confinementColumns[x] = bandStrengths[static_cast<size_t>(x) * bandCount / width];
+    }
+
+    const uint32_t bands = (m_settings.Height + kConfinementRows - 1) / kConfinementRows;
+    if (m_jobSystem)
+    {
+        m_jobSystem->ParallelFor(bands, 1, [this, dt](uint32_t begin, uint32_t end) {
+            for (uint32_t band = begin; band < end; ++band)
+            {
+                ConfineRowBand(band, dt);
+            }
+        });
+    }
+    else
+    {
+        for (uint32_t band = 0; band < bands; ++band)
+        {
+            ConfineRowBand(band, dt);
+        }
+    }
+
+    std::swap(m_velocityX, m_scratchA);
+    std::swap(m_velocityY, m_scratchB);
+}
+
+void FluidSolver::ConfineRowBand(uint32_t band, float dt)
+{
+    const uint32_t width = m_settings.Width;
+    const uint32_t height = m_settings.Height;
+    const std::span<const float> vx = m_velocityX.GetData();
+    const std::span<const float> vy = m_velocityY.GetData();
+    const std::span<float> outX = m_scratchA.GetData();
+    const std::span<float> outY = m_scratchB.GetData();
+
+    // Rolling buffer of curl rows, each padded by a cell on either side so a periodic row can carry its wrapped
+    // neighbours. Rows are keyed by y + height + offset rather than the wrapped row, so the three rows around any
+    // y land in distinct slots even where they wrap. The two rows bordering the band are computed again by the
+    // neighbouring band, which keeps bands independent.
+    const bool periodic = m_settings.Boundary == DomainBoundary::Periodic;
+    const size_t stride = static_cast<size_t>(width) + 2;
+    const std::span<float> slots =
+        std::span(m_curlRows).subspan(static_cast<size_t>(band) * kCurlRowSlots * stride, kCurlRowSlots * stride);
+    std::array<uint32_t, kCurlRowSlots> cached{};
+    cached.fill(std::numeric_limits<uint32_t>::max());
+
+    const auto curlRow = [&](uint32_t key) -> const float* {
+        const uint32_t slot = key % kCurlRowSlots;
+        float* curl = slots.data() + (static_cast<size_t>(slot) * stride) + 1;
+        if (cached[slot] == key)
+        {
+            return curl;
+        }
+        cached[slot] = key;
+
+        const uint32_t y = key % height;
+        if (!periodic && (y == 0 || y == height - 1))
+        {
+            std::fill_n(curl - 1, stride, 0.0F);
+            return curl;
+        }
+
+        const float* below = vx.data() + (static_cast<size_t>((y + height - 1) % height) * width);
+        const float* above = vx.data() + (static_cast<size_t>((y + 1) % height) * width);
+        const float* across = vy.data() + (static_cast<size_t>(y) * width);
+        for (uint32_t x = 1; x + 1 < width; ++x)
+        {
+            curl[x] = 0.5F * ((across[x + 1] - across[x - 1]) - (above[x] - below[x]));
+        }
+
+        if (periodic)
+        {
+            curl[0] = 0.5F * ((across[1] - across[width - 1]) - (above[0] - below[0]));
+            curl[width - 1] = 0.5F * ((across[0] - across[width - 2]) - (above[width - 1] - below[width - 1]));
+            curl[-1] = curl[width - 1];
+            curl[width] = curl[0];
+        }
+        else
+        {
+            curl[0] = 0.0F;
+            curl[width - 1] = 0.0F;
+        }
+        return curl;
+    };
+
+    const uint32_t rowEnd = std::min((band + 1) * kConfinementRows, height);
+    for (uint32_t y = band * kConfinementRows; y < rowEnd; ++y)
+    {
+        const size_t row = static_cast<size_t>(y) * width;
+
+        for (const CellRun& run : m_activity.GetRuns(y, CellActivity::Quiet))
+        {
+            std::copy(vx.begin() + row + run.Begin, vx.begin() + row + run.End, outX.begin() + row + run.Begin);
+            std::copy(vy.begin() + row + run.Begin, vy.begin() + row + run.End, outY.begin() + row + run.Begin);
+        }
+
+        const std::span<const CellRun> active = m_activity.GetRuns(y, CellActivity::Active);
+        if (active.empty())
+        {
+            continue;
+        }
+
+        // A periodic domain has no walls: its edge rows and columns are confined against their wrapped neighbours.
+        const bool interiorRow = periodic || (y > 0 && y + 1 < height);
+        const uint32_t key = y + height;
+        const ConfinementRow rows{.CurlBelow = interiorRow ? curlRow(key - 1) : nullptr,
+                                  .Curl = interiorRow ? curlRow(key) : nullptr,
+                                  .CurlAbove = interiorRow ? curlRow(key + 1) : nullptr,
+                                  .VelocityX = vx.data() + row,
+                                  .VelocityY = vy.data() + row,
+                                  .Strength = m_confinementColumns.data(),
+                                  .OutX = outX.data() + row,
+                                  .OutY = outY.data() + row};
+
+        for (const CellRun& run : active)
+        {
+            // Wall cells pass through unchanged; EnforceWalls owns them.
+            const uint32_t firstColumn = periodic ? 0 : 1;
+            const uint32_t lastColumn = periodic ? width : width - 1;
+            const uint32_t begin = interiorRow ? std::max(run.Begin, firstColumn) : run.End;
+            const uint32_t end = interiorRow ? std::min(run.End, lastColumn) : run.End;
+            std::copy(rows.VelocityX + run.Begin, rows.VelocityX + begin, rows.OutX + run.Begin);
+            std::copy(rows.VelocityY + run.Begin, rows.VelocityY + begin, rows.OutY + run.Begin);
+            std::copy(rows.VelocityX + end, rows.VelocityX + run.End, rows.OutX + end);
+            std::copy(rows.VelocityY + end, rows.VelocityY + run.End, rows.OutY + end);
+
+            if (begin < end)
+            {
+                ConfineSpan(rows, begin, end, dt);
+            }
+        }
+    }
+}
+
+void FluidSolver::Advect(const Field2D& source, Field2D& destination, float dt, float dissipation)
+{
+    const float decay = 1.0F / (1.0F + (dt * dissipation));
+
+    switch (m_settings.Advection)
+    {
+        case AdvectionScheme::SemiLagrangian:
+            AdvectPass(source, destination, dt, nullptr, nullptr);
+            FinishAdvection(destination, decay, false);
+            break;
+        case AdvectionScheme::MacCormack:
+            // forward + (source - reverse) / 2. The reverse trace may sample quiet cells of the forward field.
+            AdvectPass(source, m_advectForward, dt, &m_advectLower, &m_advectUpper);
+            CopyQuiet(source, m_advectForward, 1.0F);
+            AdvectPass(m_advectForward, m_advectReverse, -dt, nullptr, nullptr);
+            Correct(m_advectForward, source, m_advectReverse, destination);
+            FinishAdvection(destination, decay, m_settings.LimitAdvection);
+            break;
+        case AdvectionScheme::BFECC:
+            // Advect the source pre-compensated by half the round-trip error.
+            AdvectPass(source, m_advectForward, dt, &m_advectLower, &m_advectUpper);
+            CopyQuiet(source, m_advectForward, 1.0F);
+            AdvectPass(m_advectForward, m_advectReverse, -dt, nullptr, nullptr);
+            Correct(source, source, m_advectReverse, m_advectForward);
+            AdvectPass(m_advectForward, destination, dt, nullptr, nullptr);
+            FinishAdvection(destination, decay, m_settings.LimitAdvection);
+            break;
+        default:
+            std::unreachable();
+    }
+
+    CopyQuiet(source, destination, decay);
+}
+
+void FluidSolver::AdvectPass(
+    const Field2D& source, Field2D& destination, float dt, Field2D* lower, Field2D* upper) const
+{
+    const std::span<const float> velocityX = m_velocityX.GetData();
+    const std::span<const float> velocityY = m_velocityY.GetData();
+
+    ForEachRowBand([&](uint32_t rowBegin, uint32_t rowEnd) {
+        std::array<float, kSampleBlock> xs{};
+        std::array<float, kSampleBlock> ys{};
+
+        for (uint32_t y = rowBegin; y < rowEnd; ++y)
+        {
+            for (const CellRun& run : m_activity.GetRuns(y, CellActivity::Active))
+            {
+                for (uint32_t x0 = run.Begin; x0 < run.End; x0 += kSampleBlock)
+                {
+                    const uint32_t count = std::min(kSampleBlock, run.End - x0);
+                    const size_t row = source.Index(x0, y);
+
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        xs[i] = static_cast<float>(x0 + i) - (dt * velocityX[row + i]);
+                        ys[i] = static_cast<float>(y) - (dt * velocityY[row + i]);
+                    }
+
+                    const std::span<const float> backX = std::span(xs).first(count);
+                    const std::span<const float> backY = std::span(ys).first(count);
+                    const std::span<float> out = destination.GetData().subspan(row, count);
+
+                    if (lower && upper)
+                    {
+                        source.SampleBatch(backX,
+                                           backY,
+                                           out,
+                                           lower->GetData().subspan(row, count),
+                                           upper->GetData().subspan(row, count));
+                    }
+                    else
+                    {
+                        source.SampleBatch(backX, backY, out);
+                    }
+                }
+            }
+        }
+    });
+}
+
+void FluidSolver::Correct(const Field2D& base,
+                          const Field2D& source,
+                          const Field2D& reverse,
+                          Field2D& destination) const
+{
+    const std::span<const float> b = base.GetData();
+    const std::span<const float> s = source.GetData();
+    const std::span<const float> r = reverse.GetData();
+    const std::span<float> out = destination.GetData();
+    const uint32_t width = m_settings.Width;
+
+    ForEachRun(CellActivity::Active, [&](uint32_t y, uint32_t begin, uint32_t end) {
+        const size_t row = static_cast<size_t>(y) * width;
+        for (size_t i = row + begin; i < row + end; ++i)
+        {
+            out[i] = b[i] + (0.5F * (s[i] - r[i]));
+        }
+    });
+}
+
+void FluidSolver::FinishAdvection(Field2D& destination, float decay, bool limit) const
+{
+    const std::span<float> out = destination.GetData();
+    const std::span<const float> lower = m_advectLower.GetData();
+    const std::span<const float> upper = m_advectUpper.GetData();
+    const uint32_t width = m_settings.Width;
+
+    ForEachRun(CellActivity::Active, [&](uint32_t y, uint32_t begin, uint32_t end) {
+        const size_t row = static_cast<size_t>(y) * width;
+        for (size_t i = row + begin; i < row + end; ++i)
+        {
+            // The corrected value may overshoot the cells it came from; clamping keeps the scheme monotone.
+            const float value = limit ? std::clamp(out[i], lower[i], upper[i]) : out[i];
+            out[i] = value * decay;
+        }
+    });
+}
+
+void FluidSolver::CopyQuiet(const Field2D& source, Field2D& destination, float scale) const
+{
+    if (m_activity.GetActiveFraction() >= 1.0F)
+    {
+        return;
+    }
+
+    const std::span<const float> in = source.GetData();
+    const std::span<float> out = destination.GetData();
+    const uint32_t width = m_settings.Width;
+
+    ForEachRun(CellActivity::Quiet, [&](uint32_t y, uint32_t begin, uint32_t end) {
+        const size_t row = static_cast<size_t>(y) * width;
+        for (size_t i = row + begin; i < row + end; ++i)
+        {
+            out[i] = in[i] * scale;
+        }
+    });
+}
+
+void FluidSolver::Project(uint32_t iterations)
+{
+    ForEachTile([this](uint32_t tile) { ComputeTileDivergence(tile); });
+
+    // Warm start from the previous step's pressure, kept in m_tiledPressure.
+    uint32_t remaining = iterations;
+    bool lastRound = false;
+
+    while (!lastRound)
+    {
+        const uint32_t count = std::min(remaining, kIterationsPerRound);
+        remaining -= count;
+        lastRound = remaining == 0;
+
+        ForEachTile([this](uint32_t tile) { m_tiledPressure.ExchangeHalo(tile); });
+        ForEachTile([this, count, lastRound](uint32_t tile) { RelaxTile(tile, count, lastRound); });
+    }
+
+    EnforceWalls();
+    m_lastPressureIterations = iterations;
+}
+
+void FluidSolver::ProjectConjugateGradient(uint32_t maxIterations)
+{
+    const uint32_t width = m_settings.Width;
+    const uint32_t height = m_settings.Height;
+
+    const std::span<const uint8_t> flags = m_obstacles.GetFlags();
+
+    // m_scratchA holds nothing between velocity and dye advection, so it carries -divergence, the solver's b.
+    // Rows near a solid look their neighbours up through the flags, matching the operator the solver inverts:
+    // closed neighbours point back at the cell and solid cells are not part of the system.
+    ForEachRowBand([&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y)
+        {
+            if (IsRowNearObstacles(y))
+            {
+                const float* vx = &m_velocityX.At(0, y);
+                const float* vy = &m_velocityY.At(0, y);
+                const uint8_t* flagRow = flags.data() + m_scratchA.Index(0, y);
+                for (uint32_t x = 0; x < width; ++x)
+                {
+                    const auto& offsets = m_gridOffsets[flagRow[x]];
+                    const bool solid = (flagRow[x] & CellFlags::kSolid) != 0;
+                    m_scratchA.At(x, y) = solid ? 0.0F
+                                                : -0.5F * ((vx[x + offsets[1]] - vx[x + offsets[0]]) +
+                                                           (vy[x + offsets[3]] - vy[x + offsets[2]]));
+                }
+                continue;
+            }
+
+            const uint32_t below = y > 0 ? y - 1 : 0;
+            const uint32_t above = std::min(y + 1, height - 1);
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                const float right = m_velocityX.At(std::min(x + 1, width - 1), y);
+                const float left = m_velocityX.At(x > 0 ? x - 1 : 0, y);
+                const float top = m_velocityY.At(x, above);
+                const float bottom = m_velocityY.At(x, below);
+                m_scratchA.At(x, y) = -0.5F * ((right - left) + (top - bottom));
+            }
+        }
+    });
+
+    // m_pressure still holds the last step's solution: the warm start.
+    const SolveStats stats = m_conjugateGradient->Solve(
+        m_scratchA.GetData(), m_pressure.GetData(), m_settings.PressureTolerance, maxIterations);
+
+    ForEachRowBand([&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y)
+        {
+            if (IsRowNearObstacles(y))
+            {
+                const float* p = &m_pressure.At(0, y);
+                const uint8_t* flagRow = flags.data() + m_pressure.Index(0, y);
+                for (uint32_t x = 0; x < width; ++x)
+                {
+                    if ((flagRow[x] & CellFlags::kSolid) != 0)
+                    {
+                        continue; // EnforceWalls zeroes solid velocity
+                    }
+                    const auto& offsets = m_gridOffsets[flagRow[x]];
+                    m_velocityX.At(x, y) -= 0.5F * (p[x + offsets[1]] - p[x + offsets[0]]);
+                    m_velocityY.At(x, y) -= 0.5F * (p[x + offsets[3]] - p[x + offsets[2]]);
+                }
+                continue;
+            }
+
+            const uint32_t below = y > 0 ? y - 1 : 0;
+            const uint32_t above = std::min(y + 1, height - 1);
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                const float gradX = m_pressure.At(std::min(x + 1, width - 1), y) - m_pressure.At(x > 0 ? x - 1 : 0, y);
+                const float gradY = m_pressure.At(x, above) - m_pressure.At(x, below);
+                m_velocityX.At(x, y) -= 0.5F * gradX;
+                m_velocityY.At(x, y) -= 0.5F * gradY;
+            }
+        }
+    });
+
+    EnforceWalls();
+    m_lastPressureIterations = stats.Iterations;
+    m_lastPressureResidual = stats.Residual;
+}
+
+bool FluidSolver::IsRowNearObstacles(uint32_t y) const
+{
+    // A projection tile is flagged when a solid lies within reach of it, which covers its rows' neighbours.
+    const uint32_t tilesX = (m_settings.Width + kTileSize - 1) / kTileSize;
+    const auto tileRow = std::span(m_obstacleTiles).subspan(static_cast<size_t>(y / kTileSize) * tilesX, tilesX);
+    return std::ranges::any_of(tileRow, [](uint8_t flagged) { return flagged != 0; });
+}
+
+void FluidSolver::ComputeTileDivergence(uint32_t tileIndex)
+{
+    // Filled across the whole window straight from the velocity field, so it never needs an exchange.
+    const TileView tile = m_tiledDivergence.GetTile(tileIndex);
+    const bool obstacles = m_obstacleTiles[tileIndex] != 0;
+    const auto halo = static_cast<int32_t>(kTileHalo);
+    const auto maxX = static_cast<int32_t>(m_settings.Width - 1);
+    const auto maxY = static_cast<int32_t>(m_settings.Height - 1);
+
+    for (int32_t wy = -halo; wy < static_cast<int32_t>(tile.Height) + halo; ++wy)
+    {
+        const int32_t gy = static_cast<int32_t>(tile.Y0) + wy;
+        if (gy < 0 || gy > maxY)
+        {
+            continue;
+        }
+        const auto y = static_cast<uint32_t>(gy);
+
+        for (int32_t wx = -halo; wx < static_cast<int32_t>(tile.Width) + halo; ++wx)
+        {
+            const int32_t gx = static_cast<int32_t>(tile.X0) + wx;
+            if (gx < 0 || gx > maxX)
+            {
+                continue;
+            }
+            const auto x = static_cast<uint32_t>(gx);
+
+            if (obstacles)
+            {
+                // Same flag lookups as RelaxTile, so the right-hand side matches the operator it relaxes.
+                const size_t index = m_velocityX.Index(x, y);
+                const uint8_t flags = m_obstacles.GetFlags()[index];
+                if ((flags & CellFlags::kSolid) != 0)
+                {
+                    tile.At(wx, wy) = 0.0F;
+                    continue;
+                }
+                const auto& offsets = m_gridOffsets[flags];
+                const float* vx = m_velocityX.GetData().data() + index;
+                const float* vy = m_velocityY.GetData().data() + index;
+                tile.At(wx, wy) = 0.5F * ((vx[offsets[1]] - vx[offsets[0]]) + (vy[offsets[3]] - vy[offsets[2]]));
+                continue;
+            }
+
+            const float right = m_velocityX.At(std::min(x + 1, m_settings.Width - 1), y);
+            const float left = m_velocityX.At(x > 0 ? x - 1 : 0, y);
+            const float top = m_velocityY.At(x, std::min(y + 1, m_settings.Height - 1));
+            const float bottom = m_velocityY.At(x, y > 0 ? y - 1 : 0);
+            tile.At(wx, wy) = 0.5F * ((right - left) + (top - bottom));
+        }
+    }
+}
+
+void FluidSolver::RelaxTile(uint32_t tileIndex, uint32_t iterations, bool applyGradient)
+{
+    const TileView pressure = m_tiledPressure.GetTile(tileIndex);
+    const TileView divergence = m_tiledDivergence.GetTile(tileIndex);
+    const bool obstacles = m_obstacleTiles[tileIndex] != 0;
+    const std::span<const uint8_t> flags = m_obstacles.GetFlags();
+    const auto halo = static_cast<int32_t>(kTileHalo);
+    const auto width = static_cast<int32_t>(pressure.Width);
+    const auto height = static_cast<int32_t>(pressure.Height);
+
+    // Window cells inside the domain. Where the window stops at a wall, neighbours clamp exactly as the
+    // Neumann boundary does; where it stops at a halo edge, the stale band grows inwards one cell per
+    // iteration and never reaches the interior.
+    const int32_t xMin = std::max(-halo, -static_cast<int32_t>(pressure.X0));
+    const int32_t yMin = std::max(-halo, -static_cast<int32_t>(pressure.Y0));
+    const int32_t xMax = std::min(width + halo, static_cast<int32_t>(m_settings.Width - pressure.X0)) - 1;
+    const int32_t yMax = std::min(height + halo, static_cast<int32_t>(m_settings.Height - pressure.Y0)) - 1;
+    const bool wallLeft = xMin > -halo;
+    const bool wallBottom = yMin > -halo;
+    const bool wallRight = xMax < width + halo - 1;
+    const bool wallTop = yMax < height + halo - 1;
+
+    std::array<float, static_cast<size_t>(kTileWindow) * kTileWindow> scratch; // NOLINT(cppcoreguidelines-pro-type-member-init)
+    TileView current = pressure;
+    TileView next = pressure;
+    next.Data = scratch.data();
+
+    for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+    {
+        const auto margin = static_cast<int32_t>(iteration + 1);
+        const int32_t x0 = xMin + (wallLeft ? 0 : margin);
+        const int32_t x1 = xMax - (wallRight ? 0 : margin);
+        const int32_t y0 = yMin + (wallBottom ? 0 : margin);
+        const int32_t y1 = yMax - (wallTop ? 0 : margin);
+
+        if (obstacles)
+        {
+            // Walls and solids alike: a closed neighbour's offset points back at the cell.
+            for (int32_t y = y0; y <= y1; ++y)
+            {
+                const uint8_t* flagRow = flags.data() + GlobalIndex(pressure, m_settings.Width, 0, y);
+                const float* row = &current.At(0, y);
+                const float* rhs = &divergence.At(0, y);
+                float* out = &next.At(0, y);
+
+                for (int32_t x = x0; x <= x1; ++x)
+                {
+                    const auto& offsets = m_tileOffsets[flagRow[x]];
+                    const float* cell = row + x;
+                    const float sum = cell[offsets[0]] + cell[offsets[1]] + cell[offsets[2]] + cell[offsets[3]];
+                    out[x] = (sum - rhs[x]) * 0.25F; // NOLINT
+                }
+            }
+            std::swap(current, next);
+            continue;
+        }
+
+        for (int32_t y = y0; y <= y1; ++y)
+        {
+            // Row pointers at x = 0; clamping only matters in the first and last window column.
+            const float* row = &current.At(0, y);
+            const float* below = &current.At(0, y > yMin ? y - 1 : yMin);
+            const float* above = &current.At(0, std::min(y + 1, yMax));
+            const float* rhs = &divergence.At(0, y);
+            float* out = &next.At(0, y);
+
+            for (int32_t x = x0; x <= x1; ++x)
+            {
+                const int32_t left = x > xMin ? x - 1 : xMin;
+                const int32_t right = std::min(x + 1, xMax);
+                if (left != x - 1 || right != x + 1)
+                {
+                    out[x] = (row[left] + row[right] + below[x] + above[x] - rhs[x]) * 0.25F; // NOLINT
+                    continue;
+                }
+
+                // Interior run: plain neighbours, vectorizes.
+                const int32_t runEnd = std::min(x1, xMax - 1);
+                for (; x <= runEnd; ++x)
+                {
+                    out[x] = (row[x - 1] + row[x + 1] + below[x] + above[x] - rhs[x]) * 0.25F; // NOLINT
+                }
+                --x;
+            }
+        }
+        std::swap(current, next);
+    }
+
+    if (current.Data != pressure.Data)
+    {
+        for (int32_t y = 0; y < height; ++y)
+        {
+            std::copy_n(&current.At(0, y), width, &pressure.At(0, y));
+        }
+    }
+
+    if (!applyGradient)
+    {
+        return;
+    }
+
+    for (int32_t y = 0; y < height; ++y)
+    {
+        for (int32_t x = 0; x < width; ++x)
+        {
+            float gradX = 0.0F;
+            float gradY = 0.0F;
+            if (obstacles)
+            {
+                const auto& offsets = m_tileOffsets[flags[GlobalIndex(pressure, m_settings.Width, x, y)]];
+                const float* cell = &current.At(x, y);
+                gradX = cell[offsets[1]] - cell[offsets[0]];
+                gradY = cell[offsets[3]] - cell[offsets[2]];
+            }
+            else
+            {
+                gradX = current.At(std::min(x + 1, xMax), y) - current.At(x > xMin ? x - 1 : xMin, y);
+                gradY = current.At(x, std::min(y + 1, yMax)) - current.At(x, y > yMin ? y - 1 : yMin);
+            }
+
+            const uint32_t gx = pressure.X0 + static_cast<uint32_t>(x);
+            const uint32_t gy = pressure.Y0 + static_cast<uint32_t>(y);
+            m_velocityX.At(gx, gy) -= 0.5F * gradX;
+            m_velocityY.At(gx, gy) -= 0.5F * gradY;
+        }
+    }
+
+    m_tiledPressure.CopyTileTo(tileIndex, m_pressure);
+}
+
+void FluidSolver::EnforceWalls()
+{
+    if (m_spectral)
+    {
+        return;
+    }
+
+    const uint32_t maxX = m_settings.Width - 1;
+    const uint32_t maxY = m_settings.Height - 1;
+
+    for (uint32_t y = 0; y <= maxY; ++y)
+    {
+        m_velocityX.At(0, y) = 0.0F;
+        m_velocityX.At(maxX, y) = 0.0F;
+    }
+
+    for (uint32_t x = 0; x <= maxX; ++x)
+    {
+        m_velocityY.At(x, 0) = 0.0F;
+        m_velocityY.At(x, maxY) = 0.0F;
+    }
+
+    ClearSolids(m_velocityX);
+    ClearSolids(m_velocityY);
+}
+
+void FluidSolver::ClearSolids(Field2D& field)
+{
+    if (!m_obstacles.HasSolids())
+    {
+        return;
+    }
+
+    for (uint32_t tileIndex = 0; tileIndex < m_tiledPressure.GetTileCount(); ++tileIndex)
+    {
+        if (m_obstacleTiles[tileIndex] == 0)
+        {
+            continue;
+        }
+
+        const TileView tile = m_tiledPressure.GetTile(tileIndex);
+        for (uint32_t y = tile.Y0; y < tile.Y0 + tile.Height; ++y)
+        {
+            for (uint32_t x = tile.X0; x < tile.X0 + tile.Width; ++x)
+            {
+                if (m_obstacles.IsSolid(x, y))
+                {
+                    field.At(x, y) = 0.0F;
+                }
+            }
+        }
+    }
+}
+
+void FluidSolver::ApplyObstacleChanges()
+{
+    const CellRect changed = m_obstacles.Rebuild();
+    if (changed.IsEmpty())
+    {
+        return;
+    }
+
+    if (m_conjugateGradient)
+    {
+        m_conjugateGradient->UpdateFlags(m_obstacles.GetFlags(), changed.Y0, changed.Y1);
+    }
+
+    // Only tiles whose reach overlaps the change can have gained or lost a nearby solid.
+    for (uint32_t tileIndex = 0; tileIndex < m_tiledPressure.GetTileCount(); ++tileIndex)
+    {
+        const TileView tile = m_tiledPressure.GetTile(tileIndex);
+        const uint32_t x0 = tile.X0 > kObstacleReach ? tile.X0 - kObstacleReach : 0;
+        const uint32_t y0 = tile.Y0 > kObstacleReach ? tile.Y0 - kObstacleReach : 0;
+        const uint32_t x1 = std::min(tile.X0 + tile.Width + kObstacleReach, m_settings.Width);
+        const uint32_t y1 = std::min(tile.Y0 + tile.Height + kObstacleReach, m_settings.Height);
+        if (x1 <= changed.X0 || changed.X1 <= x0 || y1 <= changed.Y0 || changed.Y1 <= y0)
+        {
+            continue;
+        }
+
+        bool solid = false;
+        for (uint32_t y = y0; y < y1 && !solid; ++y)
+        {
+            for (uint32_t x = x0; x < x1 && !solid; ++x)
+            {
+                solid = m_obstacles.IsSolid(x, y);
+            }
+        }
+        m_obstacleTiles[tileIndex] = solid ? 1 : 0;
+    }
+
+    ClearSolids(m_velocityX);
+    ClearSolids(m_velocityY);
+    ClearSolids(m_dye);
+}
+
+const Field2D& FluidSolver::GetVelocityX() const
+{
+    return m_velocityX;
+}
+
+const Field2D& FluidSolver::GetVelocityY() const
+{
+    return m_velocityY;
+}
+
+const Field2D& FluidSolver::GetPressure() const
+{
+    return m_pressure;
+}
+
+const Field2D& FluidSolver::GetDye() const
+{
+    return m_dye;
+}
+
+const ObstacleMask& FluidSolver::GetObstacles() const
+{
+    return m_obstacles;
+}
+
+const FluidSettings& FluidSolver::GetSettings() const
+{
+    return m_settings;
+}
+
+uint32_t FluidSolver::GetLastPressureIterations() const
+{
+    return m_lastPressureIterations;
+}
+
+float FluidSolver::GetLastPressureResidual() const
+{
+    return m_lastPressureResidual;
+}
+
+float FluidSolver::GetActiveFraction() const
+{
+    return m_activity.GetActiveFraction();
+}
+} // namespace Simulation
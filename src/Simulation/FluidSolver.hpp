@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "ActivityMask.hpp"
+#include "ConjugateGradient.hpp"
+#include "Field2D.hpp"
+#include "ObstacleMask.hpp"
+#include "SpectralProjection.hpp"
+#include "TiledField2D.hpp"
+
+namespace Core
+{
+class JobSystem;
+} // namespace Core
+
+namespace Simulation
+{
+enum class AdvectionScheme : std::uint8_t
+{
+    SemiLagrangian, // One backtrace; cheapest, most diffusive
+    MacCormack,     // Forward and reverse trace, error-corrected; two samples per cell
+    BFECC           // Back-and-forth error compensation; three samples per cell
+};
+
+enum class PressureSolver : std::uint8_t
+{
+    Jacobi,           // Fixed iteration count on halo tiles; cheap per iteration, slow to converge
+    ConjugateGradient // MIC(0)-preconditioned CG to a residual tolerance; far fewer iterations
+};
+
+enum class DomainBoundary : std::uint8_t
+{
+    Closed,  // Solid walls on every edge; tiled Jacobi projection
+    Periodic // Every edge wraps to the opposite one; exact FFT projection
+};
+
+struct FluidSettings
+{
+    uint32_t Width = 128;
+    uint32_t Height = 128;
+    uint32_t PressureIterations = 40; // Jacobi's count, or the conjugate gradient's cap
+    uint32_t MinPressureIterations = 8;
+    PressureSolver Pressure = PressureSolver::Jacobi;
+    float PressureTolerance = 1.0e-3F; // Conjugate gradient stops at this residual relative to the divergence
+    float VelocityDissipation = 0.2F; // Fraction lost per second
+    float DyeDissipation = 0.35F;
+    AdvectionScheme Advection = AdvectionScheme::MacCormack;
+    DomainBoundary Boundary = DomainBoundary::Closed;
+    bool LimitAdvection = true; // Clamp corrected values to the cells they were interpolated from
+    bool TrackActivity = true;  // Skip advection in tiles that have been still for a while
+    ActivitySettings Activity;
+};
+
+// Positions and radius are normalized to the domain; force is in cells per second.
+struct Splat
+{
+    float X = 0.5F;
+    float Y = 0.5F;
+    float ForceX = 0.0F;
+    float ForceY = 0.0F;
+    float Radius = 0.02F;
+    float Dye = 0.0F;
+};
+
+// Row-major views of the state a solver carries between steps, Width * Height values each.
+struct FluidState
+{
+    std::span<const float> VelocityX;
+    std::span<const float> VelocityY;
+    std::span<const float> Pressure; // The projection's warm start
+    std::span<const float> Dye;
+};
+
+// Stable-fluids solver on a collocated grid: splat forcing, semi-Lagrangian or error-corrected advection
+// and a Jacobi pressure projection with closed walls. With a job system every grid pass is split into row bands; each cell
+// is still written by exactly one thread from the same inputs, so results match the serial path bit for bit.
+//
+// Vorticity confinement is a single fused pass: curl lives in a three-row rolling buffer per row band and the
+// force is applied as soon as a row's neighbours are known, so curl never goes through a full-size field. Its
+// strength comes per audio band, each band owning an equal slice of the columns, like the emitters.
+//
+// With activity tracking, advection only sweeps tiles that are moving (plus a dilation band); still tiles keep
+// their values, decayed, which is what advecting by a near-zero velocity would give. The projection stays
+// global.
+//
+// The projection works on tiles with a halo: after each halo exchange a tile runs several Jacobi iterations
+// inside its own block (the valid region shrinking by one cell per iteration), and the last round applies
+// the pressure gradient from the same block. This is the same arithmetic as a global Jacobi sweep, with a
+// fraction of the memory traffic. The conjugate gradient backend solves the same equations to a tolerance
+// instead, warm-started from the previous pressure; quality then scales its iteration cap.
+//
+// Obstacles are solid cells with zero velocity, kept as per-cell flags that both pressure solvers look up. A
+// projection tile only takes the flagged path when a solid cell is within reach of its window, and painting
+// obstacles rebuilds the flags, tile paths and preconditioner blocks it touched and nothing else.
+//
+// A periodic domain has no walls: sampling and splats wrap around, and the projection is the exact spectral
+// one, so the iteration settings and the quality scale do not apply.
+class FluidSolver
+{
+public:
+    explicit FluidSolver(const FluidSettings& settings, Core::JobSystem* jobSystem = nullptr);
+    ~FluidSolver() = default;
+
+    FluidSolver(const FluidSolver&) = delete;
+    FluidSolver& operator=(const FluidSolver&) = delete;
+    FluidSolver(FluidSolver&&) noexcept = default;
+    FluidSolver& operator=(FluidSolver&&) noexcept = default;
+
+    // quality in (0, 1] scales the pressure iteration count; the scheduler lowers it to catch up. confinement
+    // holds one vorticity confinement strength per band; empty skips the pass.
+    void Step(float dt, std::span<const Splat> splats, float quality = 1.0F, std::span<const float> confinement = {});
+
+    // Adds (or removes) obstacles where distance(u, v) < 0, or under an image's opaque pixels; see ObstacleMask.
+    // Closed domains only.
+    void PaintObstacles(const std::function<float(float, float)>& distance, bool solid = true);
+    void PaintObstacleImage(const std::string& path, bool solid = true);
+
+    // Replaces the fields, e.g. from a checkpoint. Activity tracking starts over with every tile awake.
+    void Restore(const FluidState& state);
+
+    [[nodiscard]] const Field2D& GetVelocityX() const;
+    [[nodiscard]] const Field2D& GetVelocityY() const;
+    [[nodiscard]] const Field2D& GetPressure() const;
+    [[nodiscard]] const Field2D& GetDye() const;
+    [[nodiscard]] const ObstacleMask& GetObstacles() const;
+
+    [[nodiscard]] const FluidSettings& GetSettings() const;
+    [[nodiscard]] uint32_t GetLastPressureIterations() const;
+    [[nodiscard]] float GetLastPressureResidual() const; // Relative; 0 for solvers that do not measure it
+    [[nodiscard]] float GetActiveFraction() const;
+
+private:
+    void ApplySplats(std::span<const Splat> splats);
+    void ConfineVorticity(float dt, std::span<const float> bandStrengths);
+    void ConfineRowBand(uint32_t band, float dt);
+    void Advect(const Field2D& source, Field2D& destination, float dt, float dissipation);
+    void AdvectPass(const Field2D& source, Field2D& destination, float dt, Field2D* lower, Field2D* upper) const;
+    void Correct(const Field2D& base, const Field2D& source, const Field2D& reverse, Field2D& destination) const;
+    void FinishAdvection(Field2D& destination, float decay, bool limit) const;
+    void CopyQuiet(const Field2D& source, Field2D& destination, float scale) const;
+    void Project(uint32_t iterations);
+    void ProjectConjugateGradient(uint32_t maxIterations);
+    [[nodiscard]] bool IsRowNearObstacles(uint32_t y) const;
+    void ComputeTileDivergence(uint32_t tileIndex);
+    void RelaxTile(uint32_t tileIndex, uint32_t iterations, bool applyGradient);
+    void EnforceWalls();
+    void ClearSolids(Field2D& field);
+    void ApplyObstacleChanges();
+
+    // Runs function(rowBegin, rowEnd) over all rows, in parallel when a job system is attached.
+    template <typename Fn>
+    void ForEachRowBand(const Fn& function) const;
+
+    // Runs function(tileIndex) for every projection tile, in parallel when a job system is attached.
+    template <typename Fn>
+    void ForEachTile(const Fn& function) const;
+
+    // Runs function(y, columnBegin, columnEnd) over every run of the given activity, row bands in parallel.
+    template <typename Fn>
+    void ForEachRun(CellActivity activity, const Fn& function) const;
+
+    FluidSettings m_settings;
+    Core::JobSystem* m_jobSystem;
+
+    Field2D m_velocityX;
+    Field2D m_velocityY;
+    Field2D m_pressure; // Row-major copy of m_tiledPressure for readers
+    Field2D m_dye;
+
+    Field2D m_scratchA;
+    Field2D m_scratchB;
+
+    Field2D m_advectForward;
+    Field2D m_advectReverse;
+    Field2D m_advectLower;
+    Field2D m_advectUpper;
+
+    TiledField2D m_tiledPressure; // Persists between steps as the warm start
+    TiledField2D m_tiledDivergence;
+
+    ActivityMask m_activity;
+
+    ObstacleMask m_obstacles;
+    std::vector<uint8_t> m_obstacleTiles; // Per projection tile: a solid cell within reach of its window
+    NeighbourOffsets m_tileOffsets;       // Neighbour offsets inside a projection tile window
+    NeighbourOffsets m_gridOffsets;       // Neighbour offsets in the row-major fields
+
+    std::optional<SpectralProjection> m_spectral;       // Periodic domains only
+    std::optional<ConjugateGradient> m_conjugateGradient; // Closed domains with the conjugate gradient backend
+
+    std::vector<float> m_confinementColumns; // Per-column strength for the current step
+    std::vector<float> m_curlRows;           // Three rolling, padded curl rows per confinement row band
+
+    uint32_t m_lastPressureIterations = 0;
+    float m_lastPressureResidual = 0.0F;
+};
+} // namespace Simulation
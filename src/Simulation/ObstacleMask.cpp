@@ -0,0 +1,423 @@
+#include "ObstacleMask.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include "../Core/Logger.hpp"
+
+namespace Simulation
+{
+namespace
+{
+constexpr int kImageChannels = 4;
+constexpr uint8_t kOpaque = 128;
+constexpr uint32_t kUnlabelled = ~0U;
+constexpr uint32_t kLargeRegion = ~0U - 1;
+constexpr size_t kPocketBudgetScale = 4; // Cells a local flood may visit per cell in or beside the dirty tiles
+} // namespace
+
+NeighbourOffsets BuildNeighbourOffsets(size_t stride)
+{
+    const auto row = static_cast<ptrdiff_t>(stride);
+    NeighbourOffsets offsets{};
+    for (uint32_t flags = 0; flags < CellFlags::kCombinations; ++flags)
+    {
+        offsets[flags] = {(flags & CellFlags::kOpenLeft) != 0 ? -1 : 0,
+                          (flags & CellFlags::kOpenRight) != 0 ? 1 : 0,
+                          (flags & CellFlags::kOpenBelow) != 0 ? -row : 0,
+                          (flags & CellFlags::kOpenAbove) != 0 ? row : 0};
+    }
+    return offsets;
+}
+
+ObstacleMask::ObstacleMask(uint32_t width, uint32_t height, uint32_t tileSize)
+    : m_width(width),
+      m_height(height),
+      m_tileSize(tileSize),
+      m_tilesX((width + tileSize - 1) / tileSize),
+      m_tilesY((height + tileSize - 1) / tileSize),
+      m_flags(static_cast<size_t>(width) * height),
+      m_dirtyTiles(static_cast<size_t>(m_tilesX) * m_tilesY, 0)
+{
+    if (width == 0 || height == 0 || tileSize == 0)
+    {
+        LOG_ERROR("ObstacleMask: Invalid {}x{} grid with {} cell tiles", width, height, tileSize);
+        throw std::invalid_argument("ObstacleMask: Invalid dimensions");
+    }
+
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            UpdateNeighbours(x, y);
+        }
+    }
+}
+
+void ObstacleMask::Paint(const std::function<float(float, float)>& distance, bool solid)
+{
+    const float invWidth = 1.0F / static_cast<float>(m_width);
+    const float invHeight = 1.0F / static_cast<float>(m_height);
+
+    for (uint32_t y = 0; y < m_height; ++y)
+    {
+        const float v = (static_cast<float>(y) + 0.5F) * invHeight;
+        for (uint32_t x = 0; x < m_width; ++x)
+        {
+            if (distance((static_cast<float>(x) + 0.5F) * invWidth, v) < 0.0F)
+            {
+                SetSolid(x, y, solid);
+            }
+        }
+    }
+}
+
+void ObstacleMask::PaintImage(const std::string& path, bool solid)
+{
+    int imageWidth = 0;
+    int imageHeight = 0;
+    int channels = 0;
+    const std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> pixels(
+        stbi_load(path.c_str(), &imageWidth, &imageHeight, &channels, kImageChannels), &stbi_image_free);
+    if (!pixels)
+    {
+        LOG_ERROR("ObstacleMask: Failed to load '{}': {}", path, stbi_failure_reason());
+        throw std::runtime_error("Obstacle Image Load Failed");
+    }
+
+    // Nearest pixel to each cell centre. Image rows run top to bottom but grid row 0 is the floor, so rows flip.
+    const bool hasAlpha = channels == 2 || channels == 4;
+    const auto nearest = [](uint32_t cell, uint32_t cells, int pixels) {
+        return static_cast<size_t>((((2ULL * cell) + 1) * static_cast<uint64_t>(pixels)) / (2ULL * cells));
+    };
+
+    for (uint32_t y = 0; y < m_height; ++y)
+    {
+        const size_t row = nearest(m_height - 1 - y, m_height, imageHeight) * static_cast<size_t>(imageWidth);
+        for (uint32_t x = 0; x < m_width; ++x)
+        {
+            const stbi_uc* pixel = pixels.get() + ((row + nearest(x, m_width, imageWidth)) * kImageChannels);
+            const uint32_t coverage =
+                hasAlpha ? pixel[3] : ((pixel[0] * 77U) + (pixel[1] * 150U) + (pixel[2] * 29U)) >> 8U;
+            if (coverage >= kOpaque)
+            {
+                SetSolid(x, y, solid);
+            }
+        }
+    }
+
+    LOG_INFO("ObstacleMask: Painted '{}' ({}x{}) over the {}x{} grid",
+             path,
+             imageWidth,
+             imageHeight,
+             m_width,
+             m_height);
+}
+
+void ObstacleMask::Clear()
+{
+    for (uint32_t y = 0; y < m_height; ++y)
+    {
+        for (uint32_t x = 0; x < m_width; ++x)
+        {
+            SetSolid(x, y, false);
+        }
+    }
+}
+
+CellRect ObstacleMask::Rebuild()
+{
+    if (std::ranges::find(m_dirtyTiles, uint8_t{1}) != m_dirtyTiles.end())
+    {
+        FillEnclosedPockets();
+    }
+
+    CellRect changed{.X0 = m_width, .Y0 = m_height, .X1 = 0, .Y1 = 0};
+
+    for (uint32_t tileY = 0; tileY < m_tilesY; ++tileY)
+    {
+        for (uint32_t tileX = 0; tileX < m_tilesX; ++tileX)
+        {
+            uint8_t& dirty = m_dirtyTiles[(static_cast<size_t>(tileY) * m_tilesX) + tileX];
+            if (dirty == 0)
+            {
+                continue;
+            }
+            dirty = 0;
+
+            // A changed cell also changes the open bits of its neighbours, one cell into the next tiles.
+            const uint32_t x0 = tileX * m_tileSize > 0 ? (tileX * m_tileSize) - 1 : 0;
+            const uint32_t y0 = tileY * m_tileSize > 0 ? (tileY * m_tileSize) - 1 : 0;
+            const uint32_t x1 = std::min(((tileX + 1) * m_tileSize) + 1, m_width);
+            const uint32_t y1 = std::min(((tileY + 1) * m_tileSize) + 1, m_height);
+
+            for (uint32_t y = y0; y < y1; ++y)
+            {
+                for (uint32_t x = x0; x < x1; ++x)
+                {
+                    UpdateNeighbours(x, y);
+                }
+            }
+
+            changed = CellRect{.X0 = std::min(changed.X0, x0),
+                               .Y0 = std::min(changed.Y0, y0),
+                               .X1 = std::max(changed.X1, x1),
+                               .Y1 = std::max(changed.Y1, y1)};
+        }
+    }
+
+    return changed.IsEmpty() ? CellRect{} : changed;
+}
+
+std::span<const uint8_t> ObstacleMask::GetFlags() const
+{
+    return m_flags;
+}
+
+bool ObstacleMask::IsSolid(uint32_t x, uint32_t y) const
+{
+    return (m_flags[(static_cast<size_t>(y) * m_width) + x] & CellFlags::kSolid) != 0;
+}
+
+bool ObstacleMask::HasSolids() const
+{
+    return m_solidCount > 0;
+}
+
+uint32_t ObstacleMask::GetWidth() const
+{
+    return m_width;
+}
+
+uint32_t ObstacleMask::GetHeight() const
+{
+    return m_height;
+}
+
+void ObstacleMask::SetSolid(uint32_t x, uint32_t y, bool solid)
+{
+    uint8_t& flags = m_flags[(static_cast<size_t>(y) * m_width) + x];
+    if (((flags & CellFlags::kSolid) != 0) == solid)
+    {
+        return;
+    }
+
+    flags = static_cast<uint8_t>(solid ? flags | CellFlags::kSolid : flags & ~CellFlags::kSolid);
+    m_solidCount = solid ? m_solidCount + 1 : m_solidCount - 1;
+    m_dirtyTiles[(static_cast<size_t>(y / m_tileSize) * m_tilesX) + (x / m_tileSize)] = 1;
+}
+
+void ObstacleMask::FillEnclosedPockets()
+{
+    if (m_solidCount == 0)
+    {
+        return;
+    }
+
+    // Every region of fluid but the largest becomes solid. The pressure in a sealed pocket is only defined up to
+    // its own constant, which the solvers have no way to pin down.
+    if (m_labels.empty())
+    {
+        m_labels.assign(m_flags.size(), kUnlabelled);
+    }
+    if (!FillPockets(true))
+    {
+        FillPockets(false);
+    }
+}
+
+bool ObstacleMask::FillPockets(bool nearDirtyTiles)
+{
+    // Each rebuild leaves the fluid as one region, so every region there is now, bar possibly that old region left
+    // untouched, has a cell in or beside a dirty tile. Flooding from those cells with a budget finds the pockets
+    // without visiting the rest of the grid: a region over budget must be the largest when it is the only one, and
+    // every region under it is a pocket. Two regions over budget may be the halves of a split, and a found region
+    // larger than an untouched one means the old region is the pocket; both need the whole grid labelled.
+    std::vector<CellRect> seeds;
+    size_t budget = std::numeric_limits<size_t>::max();
+    if (nearDirtyTiles)
+    {
+        size_t seedCells = 0;
+        for (uint32_t tileY = 0; tileY < m_tilesY; ++tileY)
+        {
+            for (uint32_t tileX = 0; tileX < m_tilesX; ++tileX)
+            {
+                if (m_dirtyTiles[(static_cast<size_t>(tileY) * m_tilesX) + tileX] == 0)
+                {
+                    continue;
+                }
+                const CellRect rect{.X0 = tileX * m_tileSize > 0 ? (tileX * m_tileSize) - 1 : 0,
+                                    .Y0 = tileY * m_tileSize > 0 ? (tileY * m_tileSize) - 1 : 0,
+                                    .X1 = std::min(((tileX + 1) * m_tileSize) + 1, m_width),
+                                    .Y1 = std::min(((tileY + 1) * m_tileSize) + 1, m_height)};
+                seedCells += static_cast<size_t>(rect.X1 - rect.X0) * (rect.Y1 - rect.Y0);
+                seeds.push_back(rect);
+            }
+        }
+        budget = seedCells * kPocketBudgetScale;
+    }
+    else
+    {
+        seeds.push_back(CellRect{.X0 = 0, .Y0 = 0, .X1 = m_width, .Y1 = m_height});
+    }
+
+    m_visited.clear();
+    m_regions.clear();
+    bool foundLarge = false;
+    bool gaveUp = false;
+
+    for (const CellRect& rect : seeds)
+    {
+        for (uint32_t y = rect.Y0; y < rect.Y1 && !gaveUp; ++y)
+        {
+            for (uint32_t x = rect.X0; x < rect.X1 && !gaveUp; ++x)
+            {
+                const size_t seed = (static_cast<size_t>(y) * m_width) + x;
+                if ((m_flags[seed] & CellFlags::kSolid) != 0 || m_labels[seed] != kUnlabelled)
+                {
+                    continue;
+                }
+
+                const size_t begin = m_visited.size();
+                const FloodResult result = Flood(seed, static_cast<uint32_t>(m_regions.size()), budget);
+                if (result == FloodResult::Complete)
+                {
+                    m_regions.push_back(Region{.Begin = begin, .End = m_visited.size()});
+                    continue;
+                }
+
+                gaveUp = result == FloodResult::OverBudget && foundLarge;
+                foundLarge = true;
+                for (size_t i = begin; i < m_visited.size(); ++i)
+                {
+                    m_labels[m_visited[i]] = kLargeRegion;
+                }
+            }
+        }
+    }
+
+    if (!gaveUp && !foundLarge && !m_regions.empty())
+    {
+        // Only cells a change opened can form regions the old one does not reach, and those fit in the budget.
+        const size_t untouched = m_flags.size() - m_solidCount - m_visited.size();
+        const auto largest = std::ranges::max_element(
+            m_regions, {}, [](const Region& region) { return region.End - region.Begin; });
+        if (largest->End - largest->Begin > untouched)
+        {
+            gaveUp = untouched > 0;
+            m_regions.erase(largest);
+        }
+    }
+
+    uint32_t filled = 0;
+    if (!gaveUp)
+    {
+        for (const Region& region : m_regions)
+        {
+            for (size_t i = region.Begin; i < region.End; ++i)
+            {
+                const size_t cell = m_visited[i];
+                SetSolid(static_cast<uint32_t>(cell % m_width), static_cast<uint32_t>(cell / m_width), true);
+                ++filled;
+            }
+        }
+    }
+
+    for (const size_t cell : m_visited)
+    {
+        m_labels[cell] = kUnlabelled;
+    }
+
+    if (filled > 0)
+    {
+        LOG_INFO("ObstacleMask: Filled {} cells in {} enclosed pockets", filled, m_regions.size());
+    }
+    return !gaveUp;
+}
+
+ObstacleMask::FloodResult ObstacleMask::Flood(size_t seed, uint32_t label, size_t budget)
+{
+    const size_t begin = m_visited.size();
+    FloodResult result = FloodResult::Complete;
+
+    m_labels[seed] = label;
+    m_visited.push_back(seed);
+    m_pending.push_back(seed);
+    while (!m_pending.empty() && result == FloodResult::Complete)
+    {
+        const size_t i = m_pending.back();
+        m_pending.pop_back();
+
+        const auto x = static_cast<uint32_t>(i % m_width);
+        const auto y = static_cast<uint32_t>(i / m_width);
+        const auto visit = [&](size_t neighbour) {
+            if ((m_flags[neighbour] & CellFlags::kSolid) != 0)
+            {
+                return;
+            }
+            if (m_labels[neighbour] == kUnlabelled)
+            {
+                m_labels[neighbour] = label;
+                m_visited.push_back(neighbour);
+                m_pending.push_back(neighbour);
+            }
+            else if (m_labels[neighbour] == kLargeRegion)
+            {
+                result = FloodResult::JoinedLarge;
+            }
+        };
+        if (x > 0)
+        {
+            visit(i - 1);
+        }
+        if (x + 1 < m_width)
+        {
+            visit(i + 1);
+        }
+        if (y > 0)
+        {
+            visit(i - m_width);
+        }
+        if (y + 1 < m_height)
+        {
+            visit(i + m_width);
+        }
+
+        if (result == FloodResult::Complete && m_visited.size() - begin > budget)
+        {
+            result = FloodResult::OverBudget;
+        }
+    }
+
+    m_pending.clear();
+    return result;
+}
+
+void ObstacleMask::UpdateNeighbours(uint32_t x, uint32_t y)
+{
+    const size_t i = (static_cast<size_t>(y) * m_width) + x;
+    uint8_t flags = m_flags[i] & CellFlags::kSolid;
+
+    // Solid cells keep no open bits: nothing flows through them.
+    if (flags == 0)
+    {
+        const auto open = [this](size_t neighbour) { return (m_flags[neighbour] & CellFlags::kSolid) == 0; };
+        flags |= (x > 0 && open(i - 1)) ? CellFlags::kOpenLeft : 0;
+        flags |= (x + 1 < m_width && open(i + 1)) ? CellFlags::kOpenRight : 0;
+        flags |= (y > 0 && open(i - m_width)) ? CellFlags::kOpenBelow : 0;
+        flags |= (y + 1 < m_height && open(i + m_width)) ? CellFlags::kOpenAbove : 0;
+    }
+
+    m_flags[i] = flags;
+}
+} // namespace Simulation
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Simulation
+{
+// Per-cell flag bits. A neighbour is open when it is fluid and inside the domain, so the domain walls are
+// encoded the same way as obstacles.
+namespace CellFlags
+{
+inline constexpr uint8_t kSolid = 1U << 0;
+inline constexpr uint8_t kOpenLeft = 1U << 1;
+inline constexpr uint8_t kOpenRight = 1U << 2;
+inline constexpr uint8_t kOpenBelow = 1U << 3;
+inline constexpr uint8_t kOpenAbove = 1U << 4;
+inline constexpr uint32_t kCombinations = 1U << 5;
+} // namespace CellFlags
+
+// Per flags value, the offsets from a cell to its left, right, below and above neighbours in a row-major array
+// with the given stride. Closed neighbours point back at the cell itself, which is the clamped form of the
+// Neumann boundary the pressure solvers use at walls.
+using NeighbourOffsets = std::array<std::array<ptrdiff_t, 4>, CellFlags::kCombinations>;
+[[nodiscard]] NeighbourOffsets BuildNeighbourOffsets(size_t stride);
+
+// Cells [X0, X1) x [Y0, Y1).
+struct CellRect
+{
+    uint32_t X0 = 0;
+    uint32_t Y0 = 0;
+    uint32_t X1 = 0;
+    uint32_t Y1 = 0;
+
+    [[nodiscard]] bool IsEmpty() const { return X0 >= X1 || Y0 >= Y1; }
+};
+
+// Solid cells of the fluid grid, kept as one flag byte per cell: solid, plus which of the four neighbours are
+// open. Geometry (an image or a signed distance function) is evaluated once when painted; the solver's
+// kernels only ever look up the flags. Painting marks the tiles whose cells changed, and Rebuild() refreshes
+// the neighbour bits of those tiles and the ring of cells around them, leaving the rest of the grid alone.
+// Fluid sealed off from the largest open region is filled in as solid when the mask is rebuilt.
+class ObstacleMask
+{
+public:
+    ObstacleMask(uint32_t width, uint32_t height, uint32_t tileSize);
+
+    // Sets (or clears) every cell whose centre has distance(u, v) < 0, with u and v in [0, 1] across the grid.
+    void Paint(const std::function<float(float, float)>& distance, bool solid = true);
+
+    // Sets (or clears) the cells covered by the image's opaque pixels: alpha, or luminance for images without
+    // one, of at least half. The image is stretched over the grid.
+    void PaintImage(const std::string& path, bool solid = true);
+
+    void Clear();
+
+    // Recomputes the flags around every tile painted since the last call and returns the cells it rewrote,
+    // which is empty if nothing changed.
+    CellRect Rebuild();
+
+    [[nodiscard]] std::span<const uint8_t> GetFlags() const;
+    [[nodiscard]] bool IsSolid(uint32_t x, uint32_t y) const;
+    [[nodiscard]] bool HasSolids() const;
+
+    [[nodiscard]] uint32_t GetWidth() const;
+    [[nodiscard]] uint32_t GetHeight() const;
+
+private:
+    enum class FloodResult : std::uint8_t
+    {
+        Complete,   // The whole region is labelled
+        OverBudget, // Stopped after budget cells
+        JoinedLarge // Reached a region already found to be over budget
+    };
+
+    // Cells [Begin, End) of m_visited.
+    struct Region
+    {
+        size_t Begin = 0;
+        size_t End = 0;
+    };
+
+    void SetSolid(uint32_t x, uint32_t y, bool solid);
+    void FillEnclosedPockets();
+    bool FillPockets(bool nearDirtyTiles);
+    FloodResult Flood(size_t seed, uint32_t label, size_t budget);
+    void UpdateNeighbours(uint32_t x, uint32_t y);
+
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_tileSize;
+    uint32_t m_tilesX;
+    uint32_t m_tilesY;
+
+    std::vector<uint8_t> m_flags;
+    std::vector<uint8_t> m_dirtyTiles;
+    uint32_t m_solidCount = 0;
+
+    // Pocket filling scratch, kept between rebuilds. Labels are all unlabelled outside FillPockets.
+    std::vector<uint32_t> m_labels;
+    std::vector<size_t> m_pending;
+    std::vector<size_t> m_visited;
+    std::vector<Region> m_regions;
+};
+} // namespace Simulation
@@ -0,0 +1,250 @@
+#include "ParticleSystem.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+#include "../Audio/AudioConfig.hpp"
+#include "../Audio/BandReducer.hpp"
+#include "../Core/JobSystem.hpp"
+#include "../Core/Logger.hpp"
+#include "Field2D.hpp"
+
+namespace Simulation
+{
+namespace
+{
+constexpr uint32_t kSampleBlock = 256;        // Particles advanced per SampleBatch call
+constexpr uint32_t kParticlesPerJob = 16384;  // Keeps job overhead small against the gathers
+constexpr uint32_t kRandomSeed = 0x9E3779B9U; // Any non-zero value; fixed so runs replay identically
+constexpr float kHueRange = 0.8F;             // Low bands red through high bands violet
+constexpr float kSaturation = 0.75F;
+constexpr float kChannelScale = 255.0F;
+constexpr float kInverseRandomRange = 1.0F / 8388608.0F; // 2^-23
+
+[[nodiscard]] uint32_t PackColor(float r, float g, float b)
+{
+    const auto channel = [](float value) {
+        return static_cast<uint32_t>(std::lround(std::clamp(value, 0.0F, 1.0F) * kChannelScale));
+    };
+    return channel(r) | (channel(g) << 8U) | (channel(b) << 16U) | (0xFFU << 24U);
+}
+
+// HSV with full value to packed RGBA8.
+[[nodiscard]] uint32_t HueColor(float hue, float saturation)
+{
+    const auto channel = [hue, saturation](float n) {
+        const float k = std::fmod(n + (hue * 6.0F), 6.0F);
+        return 1.0F - (saturation * std::clamp(std::min(k, 4.0F - k), 0.0F, 1.0F));
+    };
+    return PackColor(channel(5.0F), channel(3.0F), channel(1.0F));
+}
+} // namespace
+
+ParticleSystem::ParticleSystem(uint32_t gridWidth,
+                               uint32_t gridHeight,
+                               const ParticleSettings& settings,
+                               Core::JobSystem* jobSystem)
+    : m_settings(settings),
+      m_jobSystem(jobSystem),
+      m_width(static_cast<float>(gridWidth)),
+      m_height(static_cast<float>(gridHeight)),
+      m_randomState(kRandomSeed)
+{
+    // Reserved once: emission stops at capacity rather than growing the arrays inside the step.
+    m_particles.PositionX.reserve(m_settings.Capacity);
+    m_particles.PositionY.reserve(m_settings.Capacity);
+    m_particles.Age.reserve(m_settings.Capacity);
+    m_particles.Color.reserve(m_settings.Capacity);
+
+    for (size_t band = 0; band < m_bandColors.size(); ++band)
+    {
+        const float position = static_cast<float>(band) / static_cast<float>(m_bandColors.size());
+        m_bandColors[band] = HueColor(position * kHueRange, kSaturation);
+    }
+
+    LOG_INFO("ParticleSystem: {} tracers max, {:.1f} s lifetime", m_settings.Capacity, m_settings.Lifetime);
+}
+
+void ParticleSystem::Step(float dt, const Audio::BandArray& bands, const Field2D& velocityX, const Field2D& velocityY)
+{
+    Advect(dt, velocityX, velocityY);
+    Compact();
+    Emit(dt, bands);
+}
+
+void ParticleSystem::Restore(const ParticleView& particles)
+{
+    const size_t count = particles.PositionX.size();
+    if (particles.PositionY.size() != count || particles.Age.size() != count || particles.Color.size() != count)
+    {
+        LOG_ERROR("ParticleSystem: Restored arrays differ in length");
+        throw std::invalid_argument("ParticleSystem: Mismatched Particle Arrays");
+    }
+
+    const size_t kept = std::min(count, static_cast<size_t>(m_settings.Capacity));
+    m_particles.PositionX.assign(particles.PositionX.begin(), particles.PositionX.begin() + kept);
+    m_particles.PositionY.assign(particles.PositionY.begin(), particles.PositionY.begin() + kept);
+    m_particles.Age.assign(particles.Age.begin(), particles.Age.begin() + kept);
+    m_particles.Color.assign(particles.Color.begin(), particles.Color.begin() + kept);
+    m_emitCarry.fill(0.0F);
+}
+
+void ParticleSystem::Emit(float dt, const Audio::BandArray& bands)
+{
+    const float emitterY = m_settings.EmitterHeight * m_height;
+    const float spread = m_settings.EmitterSpread * m_width;
+
+    for (size_t band = 0; band < bands.size(); ++band)
+    {
+        const float level = bands[band] - m_settings.Threshold;
+        if (level <= 0.0F)
+        {
+            m_emitCarry[band] = 0.0F;
+            continue;
+        }
+
+        m_emitCarry[band] += level * m_settings.EmitGain * dt;
+        const float whole = std::floor(m_emitCarry[band]);
+        m_emitCarry[band] -= whole;
+
+        const size_t room = m_settings.Capacity - m_particles.Size();
+        const size_t count = std::min(static_cast<size_t>(whole), room);
+
+        const float emitterX = ((static_cast<float>(band) + 0.5F) / static_cast<float>(Audio::Config::kBandCount)) *
+                               m_width;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            m_particles.PositionX.push_back(std::clamp(emitterX + (spread * NextJitter()), 0.0F, m_width - 1.0F));
+            m_particles.PositionY.push_back(std::clamp(emitterY + (spread * NextJitter()), 0.0F, m_height - 1.0F));
+            m_particles.Age.push_back(0.0F);
+            m_particles.Color.push_back(m_bandColors[band]);
+        }
+    }
+}
+
+void ParticleSystem::Advect(float dt, const Field2D& velocityX, const Field2D& velocityY)
+{
+    const auto count = static_cast<uint32_t>(m_particles.Size());
+
+    if (m_jobSystem)
+    {
+        m_jobSystem->ParallelFor(count, kParticlesPerJob, [&](uint32_t begin, uint32_t end) {
+            AdvectRange(begin, end, dt, velocityX, velocityY);
+        });
+    }
+    else
+    {
+        AdvectRange(0, count, dt, velocityX, velocityY);
+    }
+}
+
+void ParticleSystem::AdvectRange(
+    uint32_t begin, uint32_t end, float dt, const Field2D& velocityX, const Field2D& velocityY)
+{
+    std::array<float, kSampleBlock> midX{};
+    std::array<float, kSampleBlock> midY{};
+    std::array<float, kSampleBlock> stepX{};
+    std::array<float, kSampleBlock> stepY{};
+
+    const float halfDt = 0.5F * dt;
+    const float maxX = m_width - 1.0F;
+    const float maxY = m_height - 1.0F;
+    const bool wrap = velocityX.GetEdgeMode() == EdgeMode::Wrap; // Periodic domain: leave one edge, enter the other
+
+    const auto place = [wrap](float position, float size, float limit) {
+        if (!wrap)
+        {
+            return std::clamp(position, 0.0F, limit);
+        }
+        position -= size * std::floor(position / size);
+        return position >= size ? position - size : position;
+    };
+
+    for (uint32_t base = begin; base < end; base += kSampleBlock)
+    {
+        const uint32_t count = std::min(kSampleBlock, end - base);
+        const std::span<float> x = std::span(m_particles.PositionX).subspan(base, count);
+        const std::span<float> y = std::span(m_particles.PositionY).subspan(base, count);
+        const std::span<float> age = std::span(m_particles.Age).subspan(base, count);
+        const std::span<float> vx = std::span(stepX).first(count);
+        const std::span<float> vy = std::span(stepY).first(count);
+
+        // Midpoint method: velocity at the start, then at the half step, applied over the full step.
+        velocityX.SampleBatch(x, y, vx);
+        velocityY.SampleBatch(x, y, vy);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            midX[i] = x[i] + (halfDt * vx[i]);
+            midY[i] = y[i] + (halfDt * vy[i]);
+        }
+
+        const std::span<const float> mx = std::span(midX).first(count);
+        const std::span<const float> my = std::span(midY).first(count);
+        velocityX.SampleBatch(mx, my, vx);
+        velocityY.SampleBatch(mx, my, vy);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            x[i] = place(x[i] + (dt * vx[i]), m_width, maxX);
+            y[i] = place(y[i] + (dt * vy[i]), m_height, maxY);
+            age[i] += dt;
+        }
+    }
+}
+
+void ParticleSystem::Compact()
+{
+    ParticleArrays& p = m_particles;
+    const size_t count = p.Size();
+    size_t kept = 0;
+
+    // Stable, so the arrays stay in emission order and the oldest tracers remain at the front.
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (p.Age[i] >= m_settings.Lifetime)
+        {
+            continue;
+        }
+
+        if (kept != i)
+        {
+            p.PositionX[kept] = p.PositionX[i];
+            p.PositionY[kept] = p.PositionY[i];
+            p.Age[kept] = p.Age[i];
+            p.Color[kept] = p.Color[i];
+        }
+        ++kept;
+    }
+
+    p.PositionX.resize(kept);
+    p.PositionY.resize(kept);
+    p.Age.resize(kept);
+    p.Color.resize(kept);
+}
+
+float ParticleSystem::NextJitter()
+{
+    // xorshift32; the top 24 bits map to [-1, 1).
+    m_randomState ^= m_randomState << 13U;
+    m_randomState ^= m_randomState >> 17U;
+    m_randomState ^= m_randomState << 5U;
+    return (static_cast<float>(m_randomState >> 8U) * kInverseRandomRange) - 1.0F;
+}
+
+const ParticleArrays& ParticleSystem::GetParticles() const
+{
+    return m_particles;
+}
+
+const ParticleSettings& ParticleSystem::GetSettings() const
+{
+    return m_settings;
+}
+} // namespace Simulation
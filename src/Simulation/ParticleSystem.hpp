@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "../Audio/AudioConfig.hpp"
+#include "../Audio/BandReducer.hpp"
+
+namespace Core
+{
+class JobSystem;
+} // namespace Core
+
+namespace Simulation
+{
+class Field2D;
+
+struct ParticleSettings
+{
+    uint32_t Capacity = 1U << 18;
+    float Lifetime = 8.0F;       // Seconds before a tracer is retired
+    float Threshold = 0.002F;    // Band level below which an emitter stays silent
+    float EmitGain = 5.0e4F;     // Particles per second per unit of band level above the threshold
+    float EmitterHeight = 0.08F; // Normalized, matching the audio forcing splats
+    float EmitterSpread = 0.01F; // Jitter radius around each emitter, normalized to the domain width
+};
+
+// Structure-of-arrays tracer storage. Every array is contiguous and indexed alike, so the renderer can upload
+// them as they are.
+struct ParticleArrays
+{
+    std::vector<float> PositionX; // Cell-centre grid coordinates, as Field2D::Sample takes them
+    std::vector<float> PositionY;
+    std::vector<float> Age;      // Seconds since emission
+    std::vector<uint32_t> Color; // RGBA8, red in the low byte
+
+    [[nodiscard]] size_t Size() const { return PositionX.size(); }
+};
+
+// Read-only counterpart of ParticleArrays, e.g. pointing into a mapped checkpoint.
+struct ParticleView
+{
+    std::span<const float> PositionX;
+    std::span<const float> PositionY;
+    std::span<const float> Age;
+    std::span<const uint32_t> Color;
+};
+
+// Passive tracers carried by the fluid: one emitter per audio band at the same spots the forcing splats
+// land, midpoint (RK2) advection through the velocity grid with batched SampleBatch lookups, and stable
+// compaction of expired particles. Emission jitter comes from a seeded generator, so replays match.
+class ParticleSystem
+{
+public:
+    ParticleSystem(uint32_t gridWidth,
+                   uint32_t gridHeight,
+                   const ParticleSettings& settings = {},
+                   Core::JobSystem* jobSystem = nullptr);
+
+    void Step(float dt, const Audio::BandArray& bands, const Field2D& velocityX, const Field2D& velocityY);
+
+    // Replaces the live tracers, truncated to the capacity.
+    void Restore(const ParticleView& particles);
+
+    [[nodiscard]] const ParticleArrays& GetParticles() const;
+    [[nodiscard]] const ParticleSettings& GetSettings() const;
+
+private:
+    void Emit(float dt, const Audio::BandArray& bands);
+    void Advect(float dt, const Field2D& velocityX, const Field2D& velocityY);
+    void AdvectRange(uint32_t begin, uint32_t end, float dt, const Field2D& velocityX, const Field2D& velocityY);
+    void Compact();
+
+    [[nodiscard]] float NextJitter();
+
+    ParticleSettings m_settings;
+    Core::JobSystem* m_jobSystem;
+    float m_width;
+    float m_height;
+
+    ParticleArrays m_particles;
+    std::array<float, Audio::Config::kBandCount> m_emitCarry{}; // Fractional particles owed to each emitter
+    std::array<uint32_t, Audio::Config::kBandCount> m_bandColors{};
+    uint32_t m_randomState;
+};
+} // namespace Simulation
@@ -0,0 +1,119 @@
+#include "ScalingBenchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "../Audio/AudioConfig.hpp"
+#include "../Audio/BandReducer.hpp"
+#include "../Core/Clock.hpp"
+#include "../Core/Config.hpp"
+#include "../Core/JobSystem.hpp"
+#include "../Core/Logger.hpp"
+#include "AudioForcing.hpp"
+#include "FluidSolver.hpp"
+
+namespace Simulation
+{
+namespace
+{
+constexpr double kMillisecondsPerSecond = 1000.0;
+constexpr float kBandLevel = 0.01F;
+constexpr float kBandPhaseStep = 0.4F;
+constexpr float kStepPhaseStep = 0.05F;
+
+// Deterministic stand-in for music: every band pulses with its own phase so emitters switch on and off.
+Audio::BandArray SyntheticBands(uint32_t step)
+{
+    Audio::BandArray bands{};
+    for (size_t band = 0; band < bands.size(); ++band)
+    {
+        const float phase = (static_cast<float>(band) * kBandPhaseStep) + (static_cast<float>(step) * kStepPhaseStep);
+        bands[band] = kBandLevel * std::max(std::sin(phase), 0.0F);
+    }
+    return bands;
+}
+
+// Returns milliseconds per measured step; outDye receives the final dye field.
+double RunWorkload(const ScalingBenchmarkSettings& settings, Core::JobSystem* jobSystem, Field2D& outDye)
+{
+    FluidSolver solver(settings.Fluid, jobSystem);
+    const AudioForcing forcing;
+    std::pmr::vector<Splat> splats;
+
+    const auto dt = static_cast<float>(Core::Config::kPhysicsTimeStep);
+    const uint32_t totalSteps = settings.WarmupSteps + settings.MeasuredSteps;
+
+    double start = 0.0;
+    const Core::Clock clock;
+
+    for (uint32_t step = 0; step < totalSteps; ++step)
+    {
+        if (step == settings.WarmupSteps)
+        {
+            start = clock.GetTotalSeconds();
+        }
+
+        const Audio::BandArray bands = SyntheticBands(step);
+        forcing.Emit(bands, splats);
+        solver.Step(dt, splats, 1.0F, forcing.ComputeConfinement(bands));
+    }
+
+    outDye = solver.GetDye();
+    return (clock.GetTotalSeconds() - start) * kMillisecondsPerSecond / std::max(settings.MeasuredSteps, 1U);
+}
+} // namespace
+
+std::vector<ScalingResult> RunScalingBenchmark(const ScalingBenchmarkSettings& settings)
+{
+    const uint32_t maxThreads =
+        settings.MaxThreads > 0 ? settings.MaxThreads : std::max(std::thread::hardware_concurrency(), 1U);
+
+    LOG_INFO("Benchmark: {}x{} grid, {} steps, 1..{} threads",
+             settings.Fluid.Width,
+             settings.Fluid.Height,
+             settings.MeasuredSteps,
+             maxThreads);
+
+    std::vector<ScalingResult> results;
+    results.reserve(maxThreads);
+
+    Field2D serialDye(settings.Fluid.Width, settings.Fluid.Height);
+    Field2D dye(settings.Fluid.Width, settings.Fluid.Height);
+
+    for (uint32_t threads = 1; threads <= maxThreads; ++threads)
+    {
+        // One thread runs the plain serial path so the baseline carries no scheduling overhead.
+        std::unique_ptr<Core::JobSystem> jobSystem;
+        if (threads > 1)
+        {
+            jobSystem = std::make_unique<Core::JobSystem>(threads - 1);
+        }
+
+        Field2D& target = threads == 1 ? serialDye : dye;
+        const double milliseconds = RunWorkload(settings, jobSystem.get(), target);
+
+        ScalingResult result{.Threads = threads, .MillisecondsPerStep = milliseconds};
+        if (threads > 1)
+        {
+            result.Speedup = results.front().MillisecondsPerStep / milliseconds;
+            result.MatchesSerial = std::ranges::equal(dye.GetData(), serialDye.GetData());
+        }
+        results.push_back(result);
+
+        LOG_INFO("Benchmark: {:>2} threads {:8.3f} ms/step  x{:.2f}{}",
+                 result.Threads,
+                 result.MillisecondsPerStep,
+                 result.Speedup,
+                 result.MatchesSerial ? "" : "  (differs from serial!)");
+    }
+
+    return results;
+}
+} // namespace Simulation
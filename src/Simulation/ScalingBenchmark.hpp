@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "FluidSolver.hpp"
+
+namespace Simulation
+{
+struct ScalingBenchmarkSettings
+{
+    FluidSettings Fluid;
+    uint32_t WarmupSteps = 10;
+    uint32_t MeasuredSteps = 200;
+    uint32_t MaxThreads = 0; // 0 for every hardware thread
+};
+
+struct ScalingResult
+{
+    uint32_t Threads = 0;
+    double MillisecondsPerStep = 0.0;
+    double Speedup = 1.0;
+    bool MatchesSerial = true; // Final dye field identical to the single-threaded run
+};
+
+// Steps the same synthetic, audio-shaped workload with 1..N threads and reports time per step and speedup
+// relative to one thread. Runs without SDL, a window or an audio device.
+std::vector<ScalingResult> RunScalingBenchmark(const ScalingBenchmarkSettings& settings);
+} // namespace Simulation
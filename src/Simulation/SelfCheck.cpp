@@ -0,0 +1,623 @@
+#include "SelfCheck.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "../Audio/AudioConfig.hpp"
+#include "../Core/Config.hpp"
+#include "../Core/JobSystem.hpp"
+#include "../Core/Logger.hpp"
+#include "../Core/SlotArray.hpp"
+#include "Checkpoint.hpp"
+#include "Field2D.hpp"
+#include "FluidSolver.hpp"
+#include "ObstacleMask.hpp"
+#include "ParticleSystem.hpp"
+
+namespace Simulation
+{
+namespace
+{
+constexpr uint32_t kGridSize = 48;
+constexpr uint32_t kJacobiIterations = 20000; // Enough for Jacobi to converge on kGridSize, unlike the app's 40
+constexpr uint32_t kConjugateGradientIterations = 400;
+constexpr float kConjugateGradientTolerance = 1.0e-6F;
+constexpr double kMaxPressureResidual = 1.0e-3; // Relative to the divergence the step started from
+constexpr double kMaxDivergenceRatio = 0.5;     // Central differences keep a checkerboard the 5-point solve misses
+constexpr double kMaxSolverDifference = 1.0e-3; // Relative to the peak speed
+constexpr uint32_t kPeriodicWidth = 64; // Not square, so a transposed axis shows
+constexpr uint32_t kPeriodicHeight = 40;
+constexpr double kMaxSpectralError = 1.0e-4; // Relative to the peak of the field compared against
+constexpr uint32_t kSampleWidth = 37; // Odd sizes and a count that is not a multiple of eight, for the tails
+constexpr uint32_t kSampleHeight = 29;
+constexpr size_t kSampleCount = 1003;
+constexpr uint32_t kSampleSeed = 0x2545F491U;
+#if defined(AF_SIMD_AVX2)
+constexpr const char* kBatchPath = "AVX2";
+#else
+constexpr const char* kBatchPath = "scalar";
+#endif
+constexpr uint32_t kCheckpointSteps = 30;
+constexpr uint32_t kCheckpointParticles = 1U << 14;
+constexpr float kCheckpointBandLevel = 0.01F;
+constexpr uint32_t kParticleSteps = 70;
+constexpr uint32_t kParticleEmitSteps = 50; // Then silence, so the population drains but is not yet gone
+constexpr uint32_t kParticleCapacity = 1U << 16;
+constexpr float kParticleBandLevel = 0.05F; // Loud enough for several advection jobs' worth of tracers
+constexpr float kParticleLifetime = 0.6F;   // Inside kParticleEmitSteps, so compaction runs every step
+constexpr uint32_t kParticleWorkers = 3;
+
+// Two opposing jets that keep the checkpoint and particle checks' fluid moving.
+constexpr std::array kStirSplats{
+    Splat{.X = 0.3F, .Y = 0.2F, .ForceX = 40.0F, .ForceY = 120.0F, .Radius = 0.05F, .Dye = 1.0F},
+    Splat{.X = 0.7F, .Y = 0.8F, .ForceX = -60.0F, .ForceY = -30.0F, .Radius = 0.04F, .Dye = 0.5F}};
+
+struct NamedCheck
+{
+    const char* Name;
+    bool (*Run)();
+};
+
+// A smooth field with plenty of divergence, zero through the walls and inside solids so that EnforceWalls
+// leaves it alone and the projection starts from exactly these values.
+void FillTestVelocity(std::span<const uint8_t> flags, std::vector<float>& velocityX, std::vector<float>& velocityY)
+{
+    velocityX.assign(flags.size(), 0.0F);
+    velocityY.assign(flags.size(), 0.0F);
+    for (uint32_t y = 0; y < kGridSize; ++y)
+    {
+        for (uint32_t x = 0; x < kGridSize; ++x)
+        {
+            const size_t i = (static_cast<size_t>(y) * kGridSize) + x;
+            if ((flags[i] & CellFlags::kSolid) != 0)
+            {
+                continue;
+            }
+
+            const float u = (static_cast<float>(x) + 0.5F) / kGridSize;
+            const float v = (static_cast<float>(y) + 0.5F) / kGridSize;
+            if (x > 0 && x + 1 < kGridSize)
+            {
+                velocityX[i] = (std::sin((6.1F * u) + 1.3F) * std::cos(4.3F * v)) + (0.5F * std::sin(11.0F * v));
+            }
+            if (y > 0 && y + 1 < kGridSize)
+            {
+                velocityY[i] = (std::cos(5.2F * u) * std::sin((7.7F * v) + 0.4F)) + (0.3F * u);
+            }
+        }
+    }
+}
+
+// Per cell, the central-difference divergence both projections take, with closed neighbours pointing back at
+// the cell; zero in solids.
+std::vector<double> ComputeDivergence(std::span<const float> velocityX,
+                                      std::span<const float> velocityY,
+                                      std::span<const uint8_t> flags)
+{
+    const NeighbourOffsets offsets = BuildNeighbourOffsets(kGridSize);
+    std::vector<double> divergence(flags.size(), 0.0);
+    for (size_t i = 0; i < flags.size(); ++i)
+    {
+        if ((flags[i] & CellFlags::kSolid) != 0)
+        {
+            continue;
+        }
+        const auto& offset = offsets[flags[i]];
+        const float* vx = velocityX.data() + i;
+        const float* vy = velocityY.data() + i;
+        divergence[i] = 0.5 * ((vx[offset[1]] - vx[offset[0]]) + (vy[offset[3]] - vy[offset[2]]));
+    }
+    return divergence;
+}
+
+// Root mean square over the fluid cells, after removing the mean when asked: the pressure is only defined up to
+// a constant, so the mean of a residual is not something either solver can act on.
+double RootMeanSquare(std::span<const double> values, std::span<const uint8_t> flags, bool removeMean)
+{
+    double sum = 0.0;
+    double squares = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        if ((flags[i] & CellFlags::kSolid) == 0)
+        {
+            sum += values[i];
+            squares += values[i] * values[i];
+            ++count;
+        }
+    }
+    if (count == 0)
+    {
+        return 0.0;
+    }
+
+    const double mean = removeMean ? sum / static_cast<double>(count) : 0.0;
+    return std::sqrt(std::max((squares / static_cast<double>(count)) - (mean * mean), 0.0));
+}
+
+// b - A p for the 5-point system both pressure solvers invert, with b the negated starting divergence.
+std::vector<double> ComputePressureResidual(std::span<const float> pressure,
+                                            std::span<const double> divergence,
+                                            std::span<const uint8_t> flags)
+{
+    const NeighbourOffsets offsets = BuildNeighbourOffsets(kGridSize);
+    std::vector<double> residual(flags.size(), 0.0);
+    for (size_t i = 0; i < flags.size(); ++i)
+    {
+        if ((flags[i] & CellFlags::kSolid) != 0)
+        {
+            continue;
+        }
+        const auto& offset = offsets[flags[i]];
+        const float* p = pressure.data() + i;
+        const double product = (4.0 * p[0]) - (p[offset[0]] + p[offset[1]] + p[offset[2]] + p[offset[3]]);
+        residual[i] = -divergence[i] - product;
+    }
+    return residual;
+}
+
+// One projection of the test field around a disc and a box, from a zero pressure.
+FluidSolver ProjectAroundObstacles(PressureSolver pressure)
+{
+    const bool conjugateGradient = pressure == PressureSolver::ConjugateGradient;
+    FluidSolver solver({.Width = kGridSize,
+                        .Height = kGridSize,
+                        .PressureIterations = conjugateGradient ? kConjugateGradientIterations : kJacobiIterations,
+                        .Pressure = pressure,
+                        .PressureTolerance = kConjugateGradientTolerance,
+                        .VelocityDissipation = 0.0F,
+                        .DyeDissipation = 0.0F,
+                        .Advection = AdvectionScheme::SemiLagrangian,
+                        .TrackActivity = false});
+    solver.PaintObstacles([](float u, float v) { return std::hypot(u - 0.4F, v - 0.55F) - 0.15F; });
+    solver.PaintObstacles(
+        [](float u, float v) { return std::max(std::fabs(u - 0.75F) - 0.05F, std::fabs(v - 0.3F) - 0.2F); });
+
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    const std::vector<float> zero(static_cast<size_t>(kGridSize) * kGridSize, 0.0F);
+    FillTestVelocity(solver.GetObstacles().GetFlags(), velocityX, velocityY);
+    solver.Restore({.VelocityX = velocityX, .VelocityY = velocityY, .Pressure = zero, .Dye = zero});
+
+    // A zero time step leaves advection exact, so the projection is the only thing that moves the velocity.
+    solver.Step(0.0F, {});
+    return solver;
+}
+
+// Projects the same field with both closed-domain solvers, run to convergence. Each must solve its system,
+// remove most of the divergence and leave the solids still, and the two must agree.
+bool CheckObstacleProjection()
+{
+    const FluidSolver jacobi = ProjectAroundObstacles(PressureSolver::Jacobi);
+    const FluidSolver conjugateGradient = ProjectAroundObstacles(PressureSolver::ConjugateGradient);
+    const std::span<const uint8_t> flags = jacobi.GetObstacles().GetFlags();
+
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    FillTestVelocity(flags, velocityX, velocityY);
+    const std::vector<double> before = ComputeDivergence(velocityX, velocityY, flags);
+    const double initial = RootMeanSquare(before, flags, false);
+
+    bool passed = true;
+    float peak = 0.0F;
+    for (const FluidSolver* solver : {&jacobi, &conjugateGradient})
+    {
+        const char* name = solver == &jacobi ? "Jacobi" : "Conjugate gradient";
+        const double residual =
+            RootMeanSquare(ComputePressureResidual(solver->GetPressure().GetData(), before, flags), flags, true) /
+            RootMeanSquare(before, flags, true);
+        const double ratio =
+            RootMeanSquare(ComputeDivergence(solver->GetVelocityX().GetData(), solver->GetVelocityY().GetData(), flags),
+                           flags,
+                           false) /
+            initial;
+
+        bool stillSolids = true;
+        for (size_t i = 0; i < flags.size(); ++i)
+        {
+            const float vx = solver->GetVelocityX().GetData()[i];
+            const float vy = solver->GetVelocityY().GetData()[i];
+            stillSolids = stillSolids && ((flags[i] & CellFlags::kSolid) == 0 || (vx == 0.0F && vy == 0.0F));
+            peak = std::max({peak, std::fabs(vx), std::fabs(vy)});
+        }
+
+        LOG_INFO("SelfCheck: {} after {} iterations: pressure residual {:.2e}, divergence {:.3f} of the start{}",
+                 name,
+                 solver->GetLastPressureIterations(),
+                 residual,
+                 ratio,
+                 stillSolids ? "" : ", solids moving");
+        passed = passed && residual <= kMaxPressureResidual && ratio <= kMaxDivergenceRatio && stillSolids;
+    }
+
+    float difference = 0.0F;
+    for (const auto& [a, b] : {std::pair(jacobi.GetVelocityX().GetData(), conjugateGradient.GetVelocityX().GetData()),
+                               std::pair(jacobi.GetVelocityY().GetData(), conjugateGradient.GetVelocityY().GetData())})
+    {
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            difference = std::max(difference, std::fabs(a[i] - b[i]));
+        }
+    }
+    LOG_INFO("SelfCheck: Solvers differ by at most {:.2e} against a peak speed of {:.3f}", difference, peak);
+    return passed && difference <= kMaxSolverDifference * peak;
+}
+
+// Writes a checkpoint of a stirred solver and its tracers, raw and then compressed, and restores each into a
+// fresh solver and particle system. Every field and particle must come back bit for bit, and the compressed
+// file must be the smaller one, or no block went through LZ4.
+bool CheckCheckpointRoundTrip()
+{
+    const auto dt = static_cast<float>(Core::Config::kPhysicsTimeStep);
+    const FluidSettings settings{.Width = kGridSize, .Height = kGridSize};
+    const ParticleSettings particleSettings{.Capacity = kCheckpointParticles};
+    FluidSolver solver(settings);
+    ParticleSystem particles(kGridSize, kGridSize, particleSettings);
+
+    Audio::BandArray bands{};
+    bands.fill(kCheckpointBandLevel);
+    for (uint32_t step = 0; step < kCheckpointSteps; ++step)
+    {
+        solver.Step(dt, kStirSplats);
+        particles.Step(dt, bands, solver.GetVelocityX(), solver.GetVelocityY());
+    }
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "AcousticFluidsSelfCheck.afck";
+    bool passed = true;
+    uintmax_t rawBytes = 0;
+    for (const bool compress : {false, true})
+    {
+        {
+            CheckpointWriter writer({.Path = path.string(), .Compress = compress}, solver, &particles);
+            writer.Submit(kCheckpointSteps, solver, &particles);
+        } // The destructor flushes the pending write
+
+        FluidSolver restored(settings);
+        ParticleSystem restoredParticles(kGridSize, kGridSize, particleSettings);
+        uint64_t step = 0;
+        {
+            CheckpointReader reader(path.string());
+            step = reader.GetHeader().Step;
+            reader.Restore(restored, &restoredParticles);
+        }
+
+        const auto same = [](const Field2D& a, const Field2D& b) {
+            return std::ranges::equal(a.GetData(), b.GetData());
+        };
+        const ParticleArrays& before = particles.GetParticles();
+        const ParticleArrays& after = restoredParticles.GetParticles();
+        const bool fields =
+            same(solver.GetVelocityX(), restored.GetVelocityX()) &&
+            same(solver.GetVelocityY(), restored.GetVelocityY()) &&
+            same(solver.GetPressure(), restored.GetPressure()) && same(solver.GetDye(), restored.GetDye());
+        const bool tracers = before.PositionX == after.PositionX && before.PositionY == after.PositionY &&
+                             before.Age == after.Age && before.Color == after.Color;
+
+        const uintmax_t bytes = std::filesystem::file_size(path);
+        LOG_INFO("SelfCheck: {} checkpoint of {} bytes, step {}: fields {}, {} particles {}",
+                 compress ? "LZ4" : "Raw",
+                 bytes,
+                 step,
+                 fields ? "match" : "DIFFER",
+                 after.Size(),
+                 tracers ? "match" : "DIFFER");
+        passed = passed && fields && tracers && step == kCheckpointSteps && before.Size() > 0;
+        passed = passed && (!compress || bytes < rawBytes);
+        rawBytes = bytes;
+    }
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+    return passed;
+}
+
+// Central difference along one axis of a periodic grid, the derivative the spectral projection removes.
+float WrappedDifference(std::span<const float> field, uint32_t x, uint32_t y, bool alongX)
+{
+    const auto at = [&](uint32_t cx, uint32_t cy) {
+        return field[(static_cast<size_t>(cy % kPeriodicHeight) * kPeriodicWidth) + (cx % kPeriodicWidth)];
+    };
+    return alongX ? 0.5F * (at(x + 1, y) - at(x + kPeriodicWidth - 1, y))
+                  : 0.5F * (at(x, y + 1) - at(x, y + kPeriodicHeight - 1));
+}
+
+double Peak(std::span<const float> values)
+{
+    float peak = 0.0F;
+    for (const float value : values)
+    {
+        peak = std::max(peak, std::fabs(value));
+    }
+    return peak;
+}
+
+// Largest absolute difference between two fields, relative to the peak of the reference.
+double RelativeError(std::span<const float> values, std::span<const float> reference)
+{
+    float error = 0.0F;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        error = std::max(error, std::fabs(values[i] - reference[i]));
+    }
+    return error / std::max(Peak(reference), 1.0e-30);
+}
+
+// Builds a periodic velocity as a divergence-free part (the curl of a stream function plus a uniform drift)
+// and a gradient part, both with the same wrapped central differences. The spectral projection must hand back
+// exactly the divergence-free part and a pressure whose gradient is the part it removed.
+bool CheckSpectralProjection()
+{
+    const size_t cells = static_cast<size_t>(kPeriodicWidth) * kPeriodicHeight;
+    std::vector<float> stream(cells);
+    std::vector<float> potential(cells);
+    for (uint32_t y = 0; y < kPeriodicHeight; ++y)
+    {
+        for (uint32_t x = 0; x < kPeriodicWidth; ++x)
+        {
+            const float u = 2.0F * std::numbers::pi_v<float> * static_cast<float>(x) / kPeriodicWidth;
+            const float v = 2.0F * std::numbers::pi_v<float> * static_cast<float>(y) / kPeriodicHeight;
+            stream[(static_cast<size_t>(y) * kPeriodicWidth) + x] = (std::sin(2.0F * u) * std::cos(3.0F * v)) +
+                                                                    (0.5F * std::cos(u + v));
+            potential[(static_cast<size_t>(y) * kPeriodicWidth) + x] = (std::cos(u) * std::sin(2.0F * v)) +
+                                                                       (0.7F * std::sin((3.0F * u) - v));
+        }
+    }
+
+    std::vector<float> solenoidalX(cells);
+    std::vector<float> solenoidalY(cells);
+    std::vector<float> gradientX(cells);
+    std::vector<float> gradientY(cells);
+    std::vector<float> velocityX(cells);
+    std::vector<float> velocityY(cells);
+    std::vector<float> divergence(cells);
+    for (uint32_t y = 0; y < kPeriodicHeight; ++y)
+    {
+        for (uint32_t x = 0; x < kPeriodicWidth; ++x)
+        {
+            const size_t i = (static_cast<size_t>(y) * kPeriodicWidth) + x;
+            solenoidalX[i] = WrappedDifference(stream, x, y, false) + 0.25F;
+            solenoidalY[i] = -WrappedDifference(stream, x, y, true);
+            gradientX[i] = WrappedDifference(potential, x, y, true);
+            gradientY[i] = WrappedDifference(potential, x, y, false);
+            velocityX[i] = solenoidalX[i] + gradientX[i];
+            velocityY[i] = solenoidalY[i] + gradientY[i];
+        }
+    }
+    for (uint32_t y = 0; y < kPeriodicHeight; ++y)
+    {
+        for (uint32_t x = 0; x < kPeriodicWidth; ++x)
+        {
+            divergence[(static_cast<size_t>(y) * kPeriodicWidth) + x] =
+                WrappedDifference(velocityX, x, y, true) + WrappedDifference(velocityY, x, y, false);
+        }
+    }
+    const double initialDivergence = Peak(divergence);
+
+    FluidSolver solver({.Width = kPeriodicWidth,
+                        .Height = kPeriodicHeight,
+                        .VelocityDissipation = 0.0F,
+                        .DyeDissipation = 0.0F,
+                        .Advection = AdvectionScheme::SemiLagrangian,
+                        .Boundary = DomainBoundary::Periodic,
+                        .TrackActivity = false});
+    const std::vector<float> zero(cells, 0.0F);
+    solver.Restore({.VelocityX = velocityX, .VelocityY = velocityY, .Pressure = zero, .Dye = zero});
+    solver.Step(0.0F, {}); // Exact advection, as in the obstacle check
+
+    const std::span<const float> pressure = solver.GetPressure().GetData();
+    std::vector<float> pressureX(cells);
+    std::vector<float> pressureY(cells);
+    for (uint32_t y = 0; y < kPeriodicHeight; ++y)
+    {
+        for (uint32_t x = 0; x < kPeriodicWidth; ++x)
+        {
+            const size_t i = (static_cast<size_t>(y) * kPeriodicWidth) + x;
+            divergence[i] = WrappedDifference(solver.GetVelocityX().GetData(), x, y, true) +
+                            WrappedDifference(solver.GetVelocityY().GetData(), x, y, false);
+            pressureX[i] = WrappedDifference(pressure, x, y, true);
+            pressureY[i] = WrappedDifference(pressure, x, y, false);
+        }
+    }
+
+    const double velocityError = std::max(RelativeError(solver.GetVelocityX().GetData(), solenoidalX),
+                                          RelativeError(solver.GetVelocityY().GetData(), solenoidalY));
+    const double gradientError = std::max(RelativeError(pressureX, gradientX), RelativeError(pressureY, gradientY));
+    const double divergenceLeft = Peak(divergence) / initialDivergence;
+
+    LOG_INFO("SelfCheck: Spectral projection on {}x{}: velocity error {:.2e}, pressure gradient error {:.2e}, "
+             "divergence {:.2e} of the start",
+             kPeriodicWidth,
+             kPeriodicHeight,
+             velocityError,
+             gradientError,
+             divergenceLeft);
+    return velocityError <= kMaxSpectralError && gradientError <= kMaxSpectralError &&
+           divergenceLeft <= kMaxSpectralError;
+}
+
+// Emits, advects and retires tracers through a stirred fluid with and without worker threads. The parallel
+// advection and the compaction after it must give the serial result bit for bit.
+bool CheckParticleDeterminism()
+{
+    const auto dt = static_cast<float>(Core::Config::kPhysicsTimeStep);
+    const ParticleSettings settings{.Capacity = kParticleCapacity, .Lifetime = kParticleLifetime};
+    Core::JobSystem jobSystem(kParticleWorkers);
+    FluidSolver solver({.Width = kGridSize, .Height = kGridSize});
+    ParticleSystem serial(kGridSize, kGridSize, settings);
+    ParticleSystem parallel(kGridSize, kGridSize, settings, &jobSystem);
+
+    bool matches = true;
+    size_t peak = 0;
+    for (uint32_t step = 0; step < kParticleSteps && matches; ++step)
+    {
+        Audio::BandArray bands{};
+        bands.fill(step < kParticleEmitSteps ? kParticleBandLevel : 0.0F);
+        solver.Step(dt, kStirSplats);
+        serial.Step(dt, bands, solver.GetVelocityX(), solver.GetVelocityY());
+        parallel.Step(dt, bands, solver.GetVelocityX(), solver.GetVelocityY());
+
+        const ParticleArrays& a = serial.GetParticles();
+        const ParticleArrays& b = parallel.GetParticles();
+        matches = a.PositionX == b.PositionX && a.PositionY == b.PositionY && a.Age == b.Age && a.Color == b.Color;
+        peak = std::max(peak, a.Size());
+    }
+
+    const size_t live = serial.GetParticles().Size();
+    LOG_INFO("SelfCheck: Tracers with {} workers {} the serial run ({} at most, {} left after {} steps)",
+             kParticleWorkers,
+             matches ? "match" : "DIFFER from",
+             peak,
+             live,
+             kParticleSteps);
+    return matches && live > 0 && live < peak;
+}
+
+// Fills a few slots, removes one and inserts into the slot it freed. Handles to the removed value must stop
+// resolving, even though its index is live again, while every other handle keeps its own value.
+bool CheckSlotReuse()
+{
+    struct Tag
+    {
+    };
+    Core::SlotArray<std::string, Tag> slots;
+    const auto first = slots.Insert("first");
+    const auto second = slots.Insert("second");
+    const auto third = slots.Insert("third");
+
+    std::string removed;
+    const bool removedOnce = slots.Remove(second, removed) && removed == "second";
+    const bool removedTwice = slots.Remove(second, removed);
+    const auto reused = slots.Insert("reused");
+
+    const auto holds = [&](Core::SlotHandle<Tag> handle, const char* value) {
+        const std::string* found = slots.Get(handle);
+        return found != nullptr && *found == value;
+    };
+    size_t visited = 0;
+    slots.ForEach([&visited](const std::string&) { ++visited; });
+
+    const bool reusedSlot = reused.Index == second.Index && reused.Generation != second.Generation;
+    const bool staleRejected = !slots.Contains(second) && slots.Get(second) == nullptr && !removedTwice &&
+                               slots.Get(Core::SlotHandle<Tag>{}) == nullptr;
+    const bool liveResolve = holds(first, "first") && holds(third, "third") && holds(reused, "reused");
+    const bool counted = slots.GetSize() == 3 && visited == 3;
+
+    LOG_INFO("SelfCheck: Slot {} reused at generation {} (was {}): stale handles {}, live handles {}, {} live",
+             reused.Index,
+             reused.Generation,
+             second.Generation,
+             staleRejected ? "rejected" : "RESOLVE",
+             liveResolve ? "resolve" : "LOST",
+             slots.GetSize());
+    return removedOnce && reusedSlot && staleRejected && liveResolve && counted;
+}
+
+// xorshift32 mapped to [0, 1), as the particle jitter does.
+float NextRandom(uint32_t& state)
+{
+    state ^= state << 13U;
+    state ^= state >> 17U;
+    state ^= state << 5U;
+    return static_cast<float>(state >> 8U) / static_cast<float>(1U << 24U);
+}
+
+// Samples a noisy field at positions scattered well past every edge, at exact cell centres and edges, and at
+// NaN, with both edge modes. The batched path (AVX2 gathers where compiled in) must return exactly what
+// Sample() does, and the bounds overload must bracket every value it returns.
+bool CheckBatchSampling()
+{
+    Field2D field(kSampleWidth, kSampleHeight);
+    uint32_t state = kSampleSeed;
+    for (float& value : field.GetData())
+    {
+        value = (2.0F * NextRandom(state)) - 1.0F;
+    }
+
+    std::vector<float> xs(kSampleCount);
+    std::vector<float> ys(kSampleCount);
+    for (size_t i = 0; i < kSampleCount; ++i)
+    {
+        xs[i] = ((3.0F * NextRandom(state)) - 1.0F) * kSampleWidth;
+        ys[i] = ((3.0F * NextRandom(state)) - 1.0F) * kSampleHeight;
+    }
+    const std::array special{0.0F, -0.5F, kSampleWidth - 1.0F, kSampleWidth - 0.5F, 7.0F, -7.0F,
+                             std::numeric_limits<float>::quiet_NaN()};
+    for (size_t i = 0; i < special.size(); ++i)
+    {
+        xs[i] = special[i];
+        ys[special.size() + i] = special[i];
+    }
+
+    bool passed = true;
+    std::vector<float> batch(kSampleCount);
+    std::vector<float> lower(kSampleCount);
+    std::vector<float> upper(kSampleCount);
+    std::vector<float> bounded(kSampleCount);
+    for (const EdgeMode mode : {EdgeMode::Clamp, EdgeMode::Wrap})
+    {
+        field.SetEdgeMode(mode);
+        field.SampleBatch(xs, ys, batch);
+        field.SampleBatch(xs, ys, bounded, lower, upper);
+
+        size_t mismatches = 0;
+        size_t outside = 0;
+        for (size_t i = 0; i < kSampleCount; ++i)
+        {
+            const float expected = field.Sample(xs[i], ys[i]);
+            mismatches += (batch[i] != expected || bounded[i] != expected) ? 1 : 0;
+            outside += (bounded[i] < lower[i] || bounded[i] > upper[i]) ? 1 : 0;
+        }
+
+        LOG_INFO("SelfCheck: {} batch sampling ({}): {} of {} samples differ from Sample(), {} outside their bounds",
+                 mode == EdgeMode::Wrap ? "Wrapped" : "Clamped",
+                 kBatchPath,
+                 mismatches,
+                 kSampleCount,
+                 outside);
+        passed = passed && mismatches == 0 && outside == 0;
+    }
+    return passed;
+}
+
+constexpr std::array kChecks{
+    NamedCheck{.Name = "Projection around obstacles", .Run = CheckObstacleProjection},
+    NamedCheck{.Name = "Checkpoint round trip", .Run = CheckCheckpointRoundTrip},
+    NamedCheck{.Name = "Spectral projection", .Run = CheckSpectralProjection},
+    NamedCheck{.Name = "Particle determinism", .Run = CheckParticleDeterminism},
+    NamedCheck{.Name = "Slot reuse", .Run = CheckSlotReuse},
+    NamedCheck{.Name = "Batch sampling", .Run = CheckBatchSampling},
+};
+} // namespace
+
+uint32_t RunSelfChecks()
+{
+    uint32_t failures = 0;
+    for (const NamedCheck& check : kChecks)
+    {
+        const bool passed = check.Run();
+        if (passed)
+        {
+            LOG_INFO("SelfCheck: {} passed", check.Name);
+        }
+        else
+        {
+            LOG_ERROR("SelfCheck: {} FAILED", check.Name);
+            ++failures;
+        }
+    }
+
+    LOG_INFO("SelfCheck: {} of {} checks passed", kChecks.size() - failures, kChecks.size());
+    return failures;
+}
+} // namespace Simulation
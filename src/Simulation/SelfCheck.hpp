@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Simulation
+{
+// Small headless checks of behaviour that the interactive app would only show as subtly wrong pictures: each
+// one builds its own state, measures it against a reference and logs what it found. Runs without SDL, a
+// window or an audio device. Returns the number of checks that failed.
+uint32_t RunSelfChecks();
+} // namespace Simulation
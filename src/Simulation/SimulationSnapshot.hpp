@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../Audio/BandReducer.hpp"
+#include "FieldPrecision.hpp"
+#include "ParticleSystem.hpp"
+
+namespace Simulation
+{
+// The slice of simulation state the renderer needs, copied out after every step.
+struct SimulationSnapshot
+{
+    uint64_t Step = 0;
+    double PublishTime = 0.0; // Engine clock seconds when the step finished
+    PackedField2D Dye; // At the dye precision policy
+    ParticleArrays Particles;
+    Audio::BandArray Bands{};
+};
+} // namespace Simulation
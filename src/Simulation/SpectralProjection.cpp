@@ -0,0 +1,173 @@
+#include "SpectralProjection.hpp"
+
+#include <pocketfft_hdronly.h>
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include "../Core/JobSystem.hpp"
+#include "../Core/Logger.hpp"
+#include "Field2D.hpp"
+
+namespace Simulation
+{
+namespace
+{
+constexpr uint32_t kRowsPerJob = 16;
+constexpr uint32_t kColumnsPerJob = 16; // pocketfft vectorizes across the columns of one call
+constexpr float kMinSymbol = 1.0e-6F;   // |k|^2 below this is a mode central differences cannot see
+
+using Complex = std::complex<float>;
+} // namespace
+
+SpectralProjection::SpectralProjection(uint32_t width, uint32_t height, Core::JobSystem* jobSystem)
+    : m_width(width), m_height(height), m_spectrumWidth((width / 2) + 1), m_jobSystem(jobSystem)
+{
+    if (width < 2 || height < 2)
+    {
+        LOG_ERROR("SpectralProjection: Grid {}x{} too small", width, height);
+        throw std::invalid_argument("SpectralProjection: Grid too small");
+    }
+
+    m_sineX.resize(m_spectrumWidth);
+    for (uint32_t k = 0; k < m_spectrumWidth; ++k)
+    {
+        m_sineX[k] = static_cast<float>(std::sin(2.0 * std::numbers::pi * k / width));
+    }
+
+    m_sineY.resize(height);
+    for (uint32_t k = 0; k < height; ++k)
+    {
+        m_sineY[k] = static_cast<float>(std::sin(2.0 * std::numbers::pi * k / height));
+    }
+
+    const size_t bins = static_cast<size_t>(m_spectrumWidth) * height;
+    m_spectrumX.resize(bins);
+    m_spectrumY.resize(bins);
+    m_spectrumPressure.resize(bins);
+}
+
+template <typename Fn>
+void SpectralProjection::ForEachBand(uint32_t count, uint32_t grain, const Fn& function) const
+{
+    if (m_jobSystem)
+    {
+        m_jobSystem->ParallelFor(count, grain, function);
+    }
+    else
+    {
+        function(0, count);
+    }
+}
+
+void SpectralProjection::Project(Field2D& velocityX, Field2D& velocityY, Field2D& pressure)
+{
+    ForEachBand(m_height, kRowsPerJob, [&](uint32_t begin, uint32_t end) {
+        ForwardRows(velocityX, m_spectrumX, begin, end);
+        ForwardRows(velocityY, m_spectrumY, begin, end);
+    });
+    ForEachBand(m_spectrumWidth, kColumnsPerJob, [&](uint32_t begin, uint32_t end) {
+        TransformColumns(m_spectrumX, true, begin, end);
+        TransformColumns(m_spectrumY, true, begin, end);
+    });
+
+    ForEachBand(m_height, kRowsPerJob, [&](uint32_t begin, uint32_t end) { RemoveDivergence(begin, end); });
+
+    ForEachBand(m_spectrumWidth, kColumnsPerJob, [&](uint32_t begin, uint32_t end) {
+        TransformColumns(m_spectrumX, false, begin, end);
+        TransformColumns(m_spectrumY, false, begin, end);
+        TransformColumns(m_spectrumPressure, false, begin, end);
+    });
+    ForEachBand(m_height, kRowsPerJob, [&](uint32_t begin, uint32_t end) {
+        InverseRows(m_spectrumX, velocityX, begin, end);
+        InverseRows(m_spectrumY, velocityY, begin, end);
+        InverseRows(m_spectrumPressure, pressure, begin, end);
+    });
+}
+
+void SpectralProjection::ForwardRows(const Field2D& field,
+                                     std::vector<Complex>& spectrum,
+                                     uint32_t begin,
+                                     uint32_t end)
+{
+    const auto stride = static_cast<ptrdiff_t>(m_width * sizeof(float));
+    const auto spectrumStride = static_cast<ptrdiff_t>(m_spectrumWidth * sizeof(Complex));
+
+    pocketfft::r2c<float>({end - begin, m_width},
+                          {stride, sizeof(float)},
+                          {spectrumStride, sizeof(Complex)},
+                          1,
+                          pocketfft::FORWARD,
+                          field.GetData().subspan(static_cast<size_t>(begin) * m_width).data(),
+                          spectrum.data() + (static_cast<size_t>(begin) * m_spectrumWidth),
+                          1.0F);
+}
+
+void SpectralProjection::InverseRows(const std::vector<Complex>& spectrum,
+                                     Field2D& field,
+                                     uint32_t begin,
+                                     uint32_t end)
+{
+    const auto stride = static_cast<ptrdiff_t>(m_width * sizeof(float));
+    const auto spectrumStride = static_cast<ptrdiff_t>(m_spectrumWidth * sizeof(Complex));
+    const float scale = 1.0F / static_cast<float>(static_cast<size_t>(m_width) * m_height);
+
+    pocketfft::c2r<float>({end - begin, m_width},
+                          {spectrumStride, sizeof(Complex)},
+                          {stride, sizeof(float)},
+                          1,
+                          pocketfft::BACKWARD,
+                          spectrum.data() + (static_cast<size_t>(begin) * m_spectrumWidth),
+                          field.GetData().subspan(static_cast<size_t>(begin) * m_width).data(),
+                          scale);
+}
+
+void SpectralProjection::TransformColumns(std::vector<Complex>& spectrum, bool forward, uint32_t begin, uint32_t end)
+{
+    const auto spectrumStride = static_cast<ptrdiff_t>(m_spectrumWidth * sizeof(Complex));
+    Complex* columns = spectrum.data() + begin;
+
+    pocketfft::c2c<float>({m_height, end - begin},
+                          {spectrumStride, sizeof(Complex)},
+                          {spectrumStride, sizeof(Complex)},
+                          {0},
+                          forward,
+                          columns,
+                          columns,
+                          1.0F);
+}
+
+void SpectralProjection::RemoveDivergence(uint32_t rowBegin, uint32_t rowEnd)
+{
+    for (uint32_t row = rowBegin; row < rowEnd; ++row)
+    {
+        const float sy = m_sineY[row];
+        const size_t base = static_cast<size_t>(row) * m_spectrumWidth;
+
+        for (uint32_t column = 0; column < m_spectrumWidth; ++column)
+        {
+            const float sx = m_sineX[column];
+            const float symbol = (sx * sx) + (sy * sy);
+            Complex& u = m_spectrumX[base + column];
+            Complex& v = m_spectrumY[base + column];
+
+            if (symbol < kMinSymbol)
+            {
+                m_spectrumPressure[base + column] = Complex(0.0F, 0.0F);
+                continue;
+            }
+
+            // With D = i * (sx, sy): p = D.u / |D|^2 and u -= D p, i.e. u -= (sx, sy) * s with s = (sx u + sy v) / |D|^2.
+            const Complex s = ((sx * u) + (sy * v)) / symbol;
+            u -= sx * s;
+            v -= sy * s;
+            m_spectrumPressure[base + column] = Complex(s.imag(), -s.real()); // -i * s
+        }
+    }
+}
+} // namespace Simulation
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace Core
+{
+class JobSystem;
+} // namespace Core
+
+namespace Simulation
+{
+class Field2D;
+
+// Exact pressure projection for a periodic grid. Velocity goes through a 2D real FFT (rows, then columns of
+// the half spectrum), every mode loses its component along the central-difference wave vector, and the
+// inverse transform brings it back. The result has exactly zero divergence under the same central
+// differences the Jacobi solver uses, with no iteration count to tune.
+//
+// Each pass is split into row or column bands over the job system; pocketfft keeps its plans cached per
+// length, so after the first step no plan is rebuilt. Bands never share output, so results match the serial
+// path bit for bit.
+class SpectralProjection
+{
+public:
+    SpectralProjection(uint32_t width, uint32_t height, Core::JobSystem* jobSystem = nullptr);
+
+    // Replaces the velocity by its divergence-free part and writes the pressure whose central-difference
+    // gradient was removed. Modes invisible to central differences (the mean and Nyquist) are left alone.
+    void Project(Field2D& velocityX, Field2D& velocityY, Field2D& pressure);
+
+private:
+    void ForwardRows(const Field2D& field, std::vector<std::complex<float>>& spectrum, uint32_t begin, uint32_t end);
+    void InverseRows(const std::vector<std::complex<float>>& spectrum, Field2D& field, uint32_t begin, uint32_t end);
+    void TransformColumns(std::vector<std::complex<float>>& spectrum, bool forward, uint32_t begin, uint32_t end);
+    void RemoveDivergence(uint32_t rowBegin, uint32_t rowEnd);
+
+    // Runs function(begin, end) over [0, count), in parallel when a job system is attached.
+    template <typename Fn>
+    void ForEachBand(uint32_t count, uint32_t grain, const Fn& function) const;
+
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_spectrumWidth; // width / 2 + 1 complex bins per row
+    Core::JobSystem* m_jobSystem;
+
+    std::vector<float> m_sineX; // sin(2 pi k / width) per spectrum column: the central-difference symbol
+    std::vector<float> m_sineY;
+    std::vector<std::complex<float>> m_spectrumX;
+    std::vector<std::complex<float>> m_spectrumY;
+    std::vector<std::complex<float>> m_spectrumPressure;
+};
+} // namespace Simulation
@@ -0,0 +1,173 @@
+#include "TiledField2D.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "../Core/Logger.hpp"
+#include "Field2D.hpp"
+
+namespace Simulation
+{
+TiledField2D::TiledField2D(uint32_t width, uint32_t height, uint32_t tileSize, uint32_t halo)
+    : m_width(width),
+      m_height(height),
+      m_tileSize(tileSize),
+      m_halo(halo),
+      m_stride(tileSize + (2 * halo)),
+      m_tilesX((width + tileSize - 1) / std::max(tileSize, 1U)),
+      m_tilesY((height + tileSize - 1) / std::max(tileSize, 1U))
+{
+    if (tileSize == 0 || halo >= tileSize)
+    {
+        LOG_ERROR("TiledField2D: Halo {} must be smaller than tile size {}", halo, tileSize);
+        throw std::invalid_argument("TiledField2D: Invalid Tile Size");
+    }
+
+    m_data.resize(static_cast<size_t>(m_tilesX) * m_tilesY * m_stride * m_stride, 0.0F);
+}
+
+TileView TiledField2D::GetTile(uint32_t index)
+{
+    const uint32_t x0 = (index % m_tilesX) * m_tileSize;
+    const uint32_t y0 = (index / m_tilesX) * m_tileSize;
+
+    return TileView{.Index = index,
+                    .X0 = x0,
+                    .Y0 = y0,
+                    .Width = std::min(m_tileSize, m_width - x0),
+                    .Height = std::min(m_tileSize, m_height - y0),
+                    .Halo = m_halo,
+                    .Stride = m_stride,
+                    .Data = m_data.data() + GetTileOffset(index)};
+}
+
+float TiledField2D::At(uint32_t x, uint32_t y) const
+{
+    const uint32_t index = ((y / m_tileSize) * m_tilesX) + (x / m_tileSize);
+    const size_t row = (y % m_tileSize) + m_halo;
+    const size_t column = (x % m_tileSize) + m_halo;
+    return m_data[GetTileOffset(index) + (row * m_stride) + column];
+}
+
+void TiledField2D::ExchangeHalo(uint32_t index)
+{
+    const TileView tile = GetTile(index);
+    const auto halo = static_cast<int32_t>(m_halo);
+    const auto width = static_cast<int32_t>(tile.Width);
+    const auto height = static_cast<int32_t>(tile.Height);
+    const auto maxY = static_cast<int32_t>(m_height - 1);
+
+    for (int32_t y = -halo; y < height + halo; ++y)
+    {
+        const auto sourceY = static_cast<uint32_t>(std::clamp(static_cast<int32_t>(tile.Y0) + y, 0, maxY));
+
+        if (y >= 0 && y < height)
+        {
+            CopyRow(tile, y, -halo, 0, sourceY);
+            CopyRow(tile, y, width, width + halo, sourceY);
+        }
+        else
+        {
+            CopyRow(tile, y, -halo, width + halo, sourceY);
+        }
+    }
+}
+
+void TiledField2D::CopyRow(const TileView& tile, int32_t y, int32_t xBegin, int32_t xEnd, uint32_t sourceY) const
+{
+    float* out = &tile.At(xBegin, y);
+    const auto width = static_cast<int32_t>(m_width);
+    const int32_t end = static_cast<int32_t>(tile.X0) + xEnd;
+    int32_t x = static_cast<int32_t>(tile.X0) + xBegin;
+
+    const float leftEdge = At(0, sourceY);
+    for (; x < 0 && x < end; ++x)
+    {
+        *out++ = leftEdge; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    const size_t rowOffset = (static_cast<size_t>((sourceY % m_tileSize) + m_halo) * m_stride) + m_halo;
+    const uint32_t tileRow = (sourceY / m_tileSize) * m_tilesX;
+
+    while (x < end && x < width)
+    {
+        const auto column = static_cast<uint32_t>(x);
+        const uint32_t offset = column % m_tileSize;
+        const auto run = static_cast<int32_t>(std::min<uint32_t>(
+            m_tileSize - offset, static_cast<uint32_t>(std::min(end, width) - x)));
+
+        const float* source = m_data.data() + GetTileOffset(tileRow + (column / m_tileSize)) + rowOffset + offset;
+        out = std::copy_n(source, run, out);
+        x += run;
+    }
+
+    const float rightEdge = At(m_width - 1, sourceY);
+    for (; x < end; ++x)
+    {
+        *out++ = rightEdge; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+}
+
+void TiledField2D::CopyFrom(const Field2D& field)
+{
+    for (uint32_t index = 0; index < GetTileCount(); ++index)
+    {
+        const TileView tile = GetTile(index);
+        for (uint32_t y = 0; y < tile.Height; ++y)
+        {
+            for (uint32_t x = 0; x < tile.Width; ++x)
+            {
+                tile.At(static_cast<int32_t>(x), static_cast<int32_t>(y)) = field.At(tile.X0 + x, tile.Y0 + y);
+            }
+        }
+    }
+}
+
+void TiledField2D::CopyTileTo(uint32_t index, Field2D& field) const
+{
+    const uint32_t x0 = (index % m_tilesX) * m_tileSize;
+    const uint32_t y0 = (index / m_tilesX) * m_tileSize;
+    const uint32_t x1 = std::min(x0 + m_tileSize, m_width);
+    const uint32_t y1 = std::min(y0 + m_tileSize, m_height);
+
+    for (uint32_t y = y0; y < y1; ++y)
+    {
+        for (uint32_t x = x0; x < x1; ++x)
+        {
+            field.At(x, y) = At(x, y);
+        }
+    }
+}
+
+uint32_t TiledField2D::GetTileCount() const
+{
+    return m_tilesX * m_tilesY;
+}
+
+uint32_t TiledField2D::GetTileSize() const
+{
+    return m_tileSize;
+}
+
+uint32_t TiledField2D::GetHalo() const
+{
+    return m_halo;
+}
+
+uint32_t TiledField2D::GetWidth() const
+{
+    return m_width;
+}
+
+uint32_t TiledField2D::GetHeight() const
+{
+    return m_height;
+}
+
+size_t TiledField2D::GetTileOffset(uint32_t index) const
+{
+    return static_cast<size_t>(index) * m_stride * m_stride;
+}
+} // namespace Simulation
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Field2D.hpp"
+
+namespace Simulation
+{
+// One tile of a TiledField2D: the interior plus a halo ring, stored contiguously. Coordinates are relative
+// to the interior origin, so valid x run from -Halo to Width + Halo - 1.
+struct TileView
+{
+    uint32_t Index = 0;
+    uint32_t X0 = 0; // Interior origin in the domain
+    uint32_t Y0 = 0;
+    uint32_t Width = 0; // Interior extent; edge tiles may be smaller than the tile size
+    uint32_t Height = 0;
+    uint32_t Halo = 0;
+    uint32_t Stride = 0; // Floats per stored row, tile size + 2 * halo
+    float* Data = nullptr;
+
+    [[nodiscard]] float& At(int32_t x, int32_t y) const
+    {
+        const auto column = static_cast<size_t>(x + static_cast<int32_t>(Halo));
+        const auto row = static_cast<size_t>(y + static_cast<int32_t>(Halo));
+        return Data[(row * Stride) + column]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+};
+
+// Field stored as square tiles with a halo ring, tile-major: each tile's interior and halo share one block
+// so a stencil over a tile touches only that block. Halos are copies of the neighbouring interiors,
+// refreshed by ExchangeHalo(); outside the domain they repeat the nearest edge cell.
+class TiledField2D
+{
+public:
+    TiledField2D() = default;
+    TiledField2D(uint32_t width, uint32_t height, uint32_t tileSize, uint32_t halo);
+
+    [[nodiscard]] TileView GetTile(uint32_t index);
+
+    // Domain coordinates; reads the owning tile's interior.
+    [[nodiscard]] float At(uint32_t x, uint32_t y) const;
+
+    // Refreshes one tile's halo from its neighbours. Safe to run for all tiles in parallel as long as no
+    // interior is written at the same time.
+    void ExchangeHalo(uint32_t index);
+
+    void CopyFrom(const Field2D& field);
+    void CopyTileTo(uint32_t index, Field2D& field) const;
+
+    [[nodiscard]] uint32_t GetTileCount() const;
+    [[nodiscard]] uint32_t GetTileSize() const;
+    [[nodiscard]] uint32_t GetHalo() const;
+    [[nodiscard]] uint32_t GetWidth() const;
+    [[nodiscard]] uint32_t GetHeight() const;
+
+private:
+    [[nodiscard]] size_t GetTileOffset(uint32_t index) const;
+
+    // Fills window cells [xBegin, xEnd) of row y from domain row sourceY, in contiguous runs per source tile.
+    void CopyRow(const TileView& tile, int32_t y, int32_t xBegin, int32_t xEnd, uint32_t sourceY) const;
+
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint32_t m_tileSize = 0;
+    uint32_t m_halo = 0;
+    uint32_t m_stride = 0;
+    uint32_t m_tilesX = 0;
+    uint32_t m_tilesY = 0;
+    std::vector<float> m_data;
+};
+} // namespace Simulation
@@ -1,10 +1,114 @@
+#include <spdlog/common.h>
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
 
 #include "Core/Config.hpp"
 #include "Core/Engine.hpp"
 #include "Core/Logger.hpp"
+#include "Simulation/ScalingBenchmark.hpp"
+#include "Simulation/SelfCheck.hpp"
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
+namespace
+{
+void ParseArguments(std::span<char*> args, Core::Config& config)
+{
+    for (size_t i = 1; i < args.size(); ++i)
+    {
+        const std::string_view arg = args[i];
+        const bool hasValue = i + 1 < args.size();
+
+        if (arg == "--record" && hasValue)
+        {
+            config.RecordPath = args[++i];
+        }
+        else if (arg == "--replay" && hasValue)
+        {
+            config.ReplayPath = args[++i];
+        }
+        else if (arg == "--capture" && hasValue)
+        {
+            config.CapturePath = args[++i];
+        }
+        else if (arg == "--metrics-socket" && hasValue)
+        {
+            config.MetricsSocketPath = args[++i];
+        }
+        else if (arg == "--metrics-port" && hasValue)
+        {
+            const std::string_view value = args[++i];
+            uint16_t port = 0;
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), port);
+            if (error != std::errc{} || end != value.data() + value.size() || port == 0)
+            {
+                LOG_WARN("Ignoring invalid metrics port '{}'", value);
+                continue;
+            }
+            config.MetricsPort = port;
+        }
+        else if (arg == "--trace" && hasValue)
+        {
+            config.TracePath = args[++i];
+        }
+        else if (arg == "--checkpoint" && hasValue)
+        {
+            config.CheckpointPath = args[++i];
+        }
+        else if (arg == "--periodic")
+        {
+            config.PeriodicDomain = true;
+        }
+        else if (arg == "--obstacles" && hasValue)
+        {
+            config.ObstaclePath = args[++i];
+        }
+        else if (arg == "--pcg")
+        {
+            config.ConjugateGradient = true;
+        }
+        else if (arg == "--full-precision")
+        {
+            config.HalfPrecisionDye = false;
+        }
+        else if (arg == "--async")
+        {
+            config.AsyncSimulation = true;
+        }
+        else if (arg == "--hot-log-level" && hasValue)
+        {
+            // Per-frame diagnostics in the log file; release builds compile in down to debug.
+            const std::string_view value = args[++i];
+            const spdlog::level::level_enum level = spdlog::level::from_str(std::string(value));
+            if (level == spdlog::level::off && value != "off")
+            {
+                LOG_WARN("Ignoring invalid hot log level '{}'", value);
+                continue;
+            }
+            Core::Logger::SetHotLevel(level);
+        }
+        else if (arg == "--bench-jobs")
+        {
+            config.BenchmarkJobs = true;
+        }
+        else if (arg == "--self-check")
+        {
+            config.SelfCheck = true;
+        }
+        else
+        {
+            LOG_WARN("Ignoring unknown argument '{}'", arg);
+        }
+    }
+}
+} // namespace
+
+int main(int argc, char** argv)
 {
     const Core::Logger::Scoped loggerScope;
 
@@ -19,6 +123,20 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
         config.EnableGPUDebug = true;
 #endif
 
+        ParseArguments(std::span<char*>(argv, static_cast<size_t>(argc)), config);
+
+        if (config.BenchmarkJobs)
+        {
+            Simulation::RunScalingBenchmark(Simulation::ScalingBenchmarkSettings{
+                .Fluid = {.Width = config.SimulationWidth, .Height = config.SimulationHeight}});
+            return 0;
+        }
+
+        if (config.SelfCheck)
+        {
+            return Simulation::RunSelfChecks() == 0 ? 0 : 1;
+        }
+
         Core::Engine app(config);
         app.Run();
     }
@@ -0,0 +1,191 @@
+// Build-time shader compiler: compiles each HLSL file given on the command line to SPIR-V with SDL_shadercross,
+// reflects its resource counts and writes both out as constexpr arrays for src/Graphics/EmbeddedShaders.cpp.
+//
+// Usage: ShaderBaker <output.inl> <shader.{vert,frag,comp}.hlsl>...
+// Paths are recorded as given, so run it from the directory the application resolves shader paths against.
+
+#include <SDL3/SDL.h>
+#include <SDL3_shadercross/SDL_shadercross.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+constexpr size_t kBytesPerLine = 16;
+
+struct SdlFree
+{
+    void operator()(void* ptr) const { SDL_free(ptr); }
+};
+
+struct Stage
+{
+    SDL_ShaderCross_ShaderStage Value;
+    std::string_view Enumerator; // Graphics::ShaderStage
+};
+
+Stage GetStage(const std::string& path)
+{
+    const std::string stem = std::filesystem::path(path).stem().string(); // "Name.vert" of "Name.vert.hlsl"
+    if (stem.ends_with(".vert"))
+    {
+        return {.Value = SDL_SHADERCROSS_SHADERSTAGE_VERTEX, .Enumerator = "Vertex"};
+    }
+    if (stem.ends_with(".frag"))
+    {
+        return {.Value = SDL_SHADERCROSS_SHADERSTAGE_FRAGMENT, .Enumerator = "Fragment"};
+    }
+    if (stem.ends_with(".comp"))
+    {
+        return {.Value = SDL_SHADERCROSS_SHADERSTAGE_COMPUTE, .Enumerator = "Compute"};
+    }
+    throw std::runtime_error("Unknown shader stage for '" + path + "' (expected .vert/.frag/.comp.hlsl)");
+}
+
+std::string ReadFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open '" + path + "'");
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+// Appends the bytecode array for one shader and returns its kEmbeddedShaders entry.
+std::string Bake(const std::string& path, size_t index, std::ostream& arrays)
+{
+    const Stage stage = GetStage(path);
+    const std::string source = ReadFile(path);
+
+    const SDL_ShaderCross_HLSL_Info hlslInfo{
+        .source = source.c_str(), .entrypoint = "main", .shader_stage = stage.Value};
+    size_t size = 0;
+    const std::unique_ptr<void, SdlFree> bytecode(SDL_ShaderCross_CompileSPIRVFromHLSL(&hlslInfo, &size));
+    if (!bytecode)
+    {
+        throw std::runtime_error("HLSL compilation failed for '" + path + "': " + SDL_GetError());
+    }
+    const std::span<const Uint8> spirv(static_cast<const Uint8*>(bytecode.get()), size);
+
+    std::ostringstream resources;
+    if (stage.Value == SDL_SHADERCROSS_SHADERSTAGE_COMPUTE)
+    {
+        const std::unique_ptr<SDL_ShaderCross_ComputePipelineMetadata, SdlFree> meta(
+            SDL_ShaderCross_ReflectComputeSPIRV(spirv.data(), spirv.size(), 0));
+        if (!meta)
+        {
+            throw std::runtime_error("Reflection failed for '" + path + "'");
+        }
+        resources << ".Samplers = " << meta->num_samplers
+                  << ", .ReadOnlyStorageTextures = " << meta->num_readonly_storage_textures
+                  << ", .ReadOnlyStorageBuffers = " << meta->num_readonly_storage_buffers
+                  << ", .ReadWriteStorageTextures = " << meta->num_readwrite_storage_textures
+                  << ", .ReadWriteStorageBuffers = " << meta->num_readwrite_storage_buffers
+                  << ", .UniformBuffers = " << meta->num_uniform_buffers << ", .ThreadCountX = " << meta->threadcount_x
+                  << ", .ThreadCountY = " << meta->threadcount_y << ", .ThreadCountZ = " << meta->threadcount_z;
+    }
+    else
+    {
+        const std::unique_ptr<SDL_ShaderCross_GraphicsShaderMetadata, SdlFree> meta(
+            SDL_ShaderCross_ReflectGraphicsSPIRV(spirv.data(), spirv.size(), 0));
+        if (!meta)
+        {
+            throw std::runtime_error("Reflection failed for '" + path + "'");
+        }
+        resources << ".Samplers = " << meta->resource_info.num_samplers
+                  << ", .ReadOnlyStorageTextures = " << meta->resource_info.num_storage_textures
+                  << ", .ReadOnlyStorageBuffers = " << meta->resource_info.num_storage_buffers
+                  << ", .UniformBuffers = " << meta->resource_info.num_uniform_buffers;
+    }
+
+    // SPIR-V is a stream of 32-bit words; keep the array word aligned for the drivers that read it as such.
+    arrays << "// " << path << "\nalignas(4) constexpr std::array<uint8_t, " << spirv.size() << "> kBytecode" << index
+           << "{";
+    arrays << std::hex << std::setfill('0');
+    for (size_t i = 0; i < spirv.size(); ++i)
+    {
+        arrays << (i % kBytesPerLine == 0 ? "\n    " : " ") << "0x" << std::setw(2) << static_cast<unsigned>(spirv[i])
+               << ",";
+    }
+    arrays << std::dec << "};\n\n";
+
+    std::ostringstream entry;
+    entry << "    EmbeddedShader{.Path = \"" << path << "\",\n"
+          << "                   .Stage = ShaderStage::" << stage.Enumerator << ",\n"
+          << "                   .Bytecode = kBytecode" << index << ",\n"
+          << "                   .Resources = {" << resources.str() << "}}";
+    return entry.str();
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::span<char*> args(argv, static_cast<size_t>(argc));
+    if (args.size() < 2)
+    {
+        std::cerr << "Usage: ShaderBaker <output.inl> <shader.{vert,frag,comp}.hlsl>...\n";
+        return 1;
+    }
+
+    if (!SDL_ShaderCross_Init())
+    {
+        std::cerr << "ShaderBaker: Failed to initialize SDL_shadercross\n";
+        return 1;
+    }
+
+    int status = 0;
+    try
+    {
+        std::ostringstream arrays;
+        std::vector<std::string> entries;
+        for (size_t i = 2; i < args.size(); ++i)
+        {
+            entries.push_back(Bake(args[i], i - 2, arrays));
+        }
+
+        std::ostringstream output;
+        output << "// Generated by tools/ShaderBaker at build time. Do not edit.\n\n" << arrays.str();
+        output << "constexpr std::array<EmbeddedShader, " << entries.size() << "> kEmbeddedShaders{\n";
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            output << entries[i] << (i + 1 < entries.size() ? ",\n" : "\n");
+        }
+        output << "};\n";
+
+        const std::filesystem::path outputPath(args[1]);
+        if (outputPath.has_parent_path())
+        {
+            std::filesystem::create_directories(outputPath.parent_path());
+        }
+        std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
+        file << output.str();
+        if (!file)
+        {
+            throw std::runtime_error("Cannot write '" + outputPath.string() + "'");
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ShaderBaker: " << e.what() << "\n";
+        status = 1;
+    }
+
+    SDL_ShaderCross_Quit();
+    return status;
+}